@@ -48,6 +48,11 @@ if (DISABLE_ABI_CHECK)
   add_compile_options("-DDISABLE_ABI_CHECK")
 endif()
 
+# Compile out native XRT API profiling hooks (cmake -DXRT_DISABLE_NATIVE_PROFILE=ON)
+if (XRT_DISABLE_NATIVE_PROFILE)
+  add_compile_options("-DXRT_DISABLE_NATIVE_PROFILE")
+endif()
+
 if (NOT CMAKE_BUILD_TYPE)
   set (CMAKE_BUILD_TYPE RelWithDebInfo)
 endif (NOT CMAKE_BUILD_TYPE)
@@ -17,6 +17,7 @@
 #include "xrt/experimental/xrt_message.h"
 #include "xrt/experimental/xrt_system.h"
 #include "xrt/experimental/xrt_xclbin.h"
+#include "core/common/api/bo_int.h"
 
 // Pybind11 includes
 #include <pybind11/pybind11.h>
@@ -25,6 +26,9 @@
 #include <pybind11/stl_bind.h>
 
 // C++11 includes
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <string>
@@ -33,6 +37,140 @@ namespace py = pybind11;
 
 PYBIND11_MAKE_OPAQUE(std::vector<xrt::xclbin::ip>);
 
+namespace {
+
+// Blocking XRT calls are made without holding the GIL so other Python
+// threads can run while a thread waits for the device.
+using release_gil = py::call_guard<py::gil_scoped_release>;
+
+// Run a blocking wait function in the default executor of the running
+// asyncio event loop and return the asyncio future for its result.
+// The wait function releases the GIL, so the event loop keeps running
+// while the executor thread is blocked.
+py::object
+to_future(const py::object& waitfn)
+{
+    auto loop = py::module_::import("asyncio").attr("get_running_loop")();
+    return loop.attr("run_in_executor")(py::none(), waitfn);
+}
+
+// Move a Python owned object (object reference, buffer view) into an
+// owner that can be tied to the lifetime of a buffer object.  The
+// owner may be released from any thread, it acquires the GIL to drop
+// the Python reference or leaks it if the interpreter is finalized.
+template <typename Owned>
+std::shared_ptr<void>
+make_owner(Owned owned)
+{
+    return std::shared_ptr<void>(new Owned(std::move(owned)), [](void* p) {
+        if (!Py_IsInitialized())
+            return;
+        py::gil_scoped_acquire acquire;
+        delete static_cast<Owned*>(p);
+    });
+}
+
+// DLPack ABI (https://github.com/dmlc/dlpack), only the parts used to
+// exchange host memory of buffer objects.
+enum dl_device_type : int32_t { kDLCPU = 1 };
+enum dl_data_type_code : uint8_t { kDLInt = 0, kDLUInt = 1, kDLFloat = 2 };
+
+struct DLDevice { int32_t device_type; int32_t device_id; };
+struct DLDataType { uint8_t code; uint8_t bits; uint16_t lanes; };
+
+struct DLTensor
+{
+    void* data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t* shape;
+    int64_t* strides;
+    uint64_t byte_offset;
+};
+
+struct DLManagedTensor
+{
+    DLTensor dl_tensor;
+    void* manager_ctx;
+    void (*deleter)(DLManagedTensor*);
+};
+
+// Export host side of a buffer object as a 1-D uint8 DLPack tensor.
+// The managed tensor holds a reference to the buffer object, and
+// through it to any Python memory the buffer object was created from.
+struct dlpack_bo
+{
+    xrt::bo bo;
+    int64_t shape;
+    DLManagedTensor tensor;
+
+    explicit dlpack_bo(const xrt::bo& b)
+        : bo(b), shape(static_cast<int64_t>(b.size()))
+    {
+        tensor.dl_tensor = {bo.map(), {kDLCPU, 0}, 1, {kDLUInt, 8, 1}, &shape, nullptr, 0};
+        tensor.manager_ctx = this;
+        tensor.deleter = [](DLManagedTensor* t) { delete static_cast<dlpack_bo*>(t->manager_ctx); };
+    }
+};
+
+py::capsule
+to_dlpack(const xrt::bo& bo)
+{
+    auto ctx = new dlpack_bo(bo);
+    // A consumer renames the capsule and takes over the tensor, an
+    // unconsumed capsule releases the tensor when destroyed
+    return py::capsule(&ctx->tensor, "dltensor", [](PyObject* obj) {
+        if (PyCapsule_IsValid(obj, "used_dltensor"))
+            return;
+        auto t = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(obj, "dltensor"));
+        if (t && t->deleter)
+            t->deleter(t);
+        else
+            PyErr_Clear();
+    });
+}
+
+// Size in bytes of a contiguous host DLPack tensor
+size_t
+dlpack_size(const DLTensor& t)
+{
+    if (t.device.device_type != kDLCPU)
+        throw py::value_error("DLPack tensor is not in host memory");
+
+    size_t elems = 1;
+    for (int32_t i = 0; i < t.ndim; ++i)
+        elems *= static_cast<size_t>(t.shape[i]);
+
+    if (t.strides) {
+        int64_t expected = 1;
+        for (int32_t i = t.ndim - 1; i >= 0; --i) {
+            if (t.shape[i] != 1 && t.strides[i] != expected)
+                throw py::value_error("DLPack tensor is not contiguous");
+            expected *= t.shape[i];
+        }
+    }
+    return elems * ((t.dtype.bits * t.dtype.lanes + 7) / 8);
+}
+
+// Check that buffer is writable and C contiguous, return its size in bytes
+size_t
+contiguous_size(const py::buffer_info& info)
+{
+    if (info.readonly)
+        throw py::value_error("buffer is read-only");
+
+    auto expected = info.itemsize;
+    for (auto i = info.ndim; i-- > 0;) {
+        if (info.shape[i] != 1 && info.strides[i] != expected)
+            throw py::value_error("buffer is not C contiguous");
+        expected *= info.shape[i];
+    }
+    return info.itemsize * info.size;
+}
+
+}
+
 PYBIND11_MODULE(pyxrt, m) {
     m.doc() = "Pybind11 module for XRT";
 
@@ -130,10 +268,10 @@ PYBIND11_MODULE(pyxrt, m) {
                       }))
         .def("load_xclbin", [](xrt::device& d, const std::string& xclbin) {
                                 return d.load_xclbin(xclbin);
-                            }, "Load an xclbin given the path to the device")
+                            }, release_gil(), "Load an xclbin given the path to the device")
         .def("load_xclbin", [](xrt::device& d, const xrt::xclbin& xclbin) {
                                 return d.load_xclbin(xclbin);
-                            }, "Load the xclbin to the device")
+                            }, release_gil(), "Load the xclbin to the device")
         .def("register_xclbin", [](xrt::device& d, const xrt::xclbin& xclbin) {
                                 return d.register_xclbin(xclbin);
                             }, "Register an xclbin with the device")
@@ -191,7 +329,7 @@ PYBIND11_MODULE(pyxrt, m) {
         .def(py::init<const xrt::kernel &>())
         .def("start", [](xrt::run& r){
                           r.start();
-                      }, "Start one execution of a run")
+                      }, release_gil(), "Start one execution of a run")
         .def("set_arg", [](xrt::run& r, int i, xrt::bo& item){
                             r.set_arg(i, item);
                         }, "Set a specific kernel global argument for a run")
@@ -200,10 +338,16 @@ PYBIND11_MODULE(pyxrt, m) {
                         }, "Set a specific kernel scalar argument for this run")
         .def("wait", ([](xrt::run& r)  {
                            return r.wait(0);
-                      }), "Wait for the run to complete")
+                      }), release_gil(), "Wait for the run to complete")
         .def("wait", ([](xrt::run& r, unsigned int timeout_ms)  {
                           return r.wait(timeout_ms);
-                      }), "Wait for the specified milliseconds for the run to complete")
+                      }), release_gil(), "Wait for the specified milliseconds for the run to complete")
+        .def("wait_async", [](py::object self) {
+                                return to_future(self.attr("wait"));
+                            }, "Return an asyncio future for the completion of the run, must be called from a running event loop")
+        .def("__await__", [](py::object self) {
+                              return to_future(self.attr("wait")).attr("__await__")();
+                          }, "Wait for the run to complete in an asyncio coroutine")
         .def("state", &xrt::run::state, "Check the current state of a run object")
         .def("add_callback", &xrt::run::add_callback, "Add a callback function for run state");
 
@@ -244,7 +388,10 @@ PYBIND11_MODULE(pyxrt, m) {
                                  i++;
                              }
 
-                             r.start();
+                             {
+                                 py::gil_scoped_release release;
+                                 r.start();
+                             }
                              return r;
                          })
         .def("group_id", &xrt::kernel::group_id, "Get the memory bank group id of an kernel argument");
@@ -266,27 +413,113 @@ PYBIND11_MODULE(pyxrt, m) {
         .value("svm", xrt::bo::flags::svm)
         .export_values();
 
-    pybo.def(py::init<xrt::device, size_t, xrt::bo::flags, xrt::memory_group>(), "Create a buffer object with specified properties")
+    py::class_<xrt::bo::async_handle>(pybo, "async_handle", "Represents an asynchronous buffer transfer")
+        .def("wait", &xrt::bo::async_handle::wait, release_gil(), "Wait for the transfer to complete")
+        .def("wait_async", [](py::object self) {
+                                return to_future(self.attr("wait"));
+                            }, "Return an asyncio future for the completion of the transfer, must be called from a running event loop")
+        .def("__await__", [](py::object self) {
+                              return to_future(self.attr("wait")).attr("__await__")();
+                          }, "Wait for the transfer to complete in an asyncio coroutine");
+
+    pybo.def(py::init<xrt::device, size_t, xrt::bo::flags, xrt::memory_group>(), release_gil(), "Create a buffer object with specified properties")
         .def(py::init<xrt::bo, size_t, size_t>(), "Create a sub-buffer of an existing buffer object of specifed size and offset in the existing buffer")
+        .def(py::init([](const xrt::device& d, py::buffer pyb, xrt::memory_group grp) {
+                          auto info = pyb.request(true);
+                          auto size = contiguous_size(info);
+                          std::unique_ptr<xrt::bo> bo;
+                          {
+                              py::gil_scoped_release release;
+                              bo = std::make_unique<xrt::bo>(d, info.ptr, size, grp);
+                          }
+                          // The buffer view is held by the buffer object implementation,
+                          // which may outlive this Python object, e.g. as a kernel argument
+                          xrt_core::bo_int::set_owner(*bo, make_owner(std::move(info)));
+                          return bo.release();
+                      }),
+             "Create a buffer object using the memory of a page aligned, C contiguous buffer (e.g. a NumPy array) as host backing store without copying, the buffer is kept alive as long as the buffer object")
         .def("write", ([](xrt::bo &b, py::buffer pyb, size_t seek)  {
                            py::buffer_info info = pyb.request();
+                           py::gil_scoped_release release;
                            b.write(info.ptr, info.itemsize * info.size , seek);
                        }), "Write the provided data into the buffer object starting at specified offset")
         .def("read", ([](xrt::bo &b, size_t size, size_t skip) {
                           py::array_t<char> result = py::array_t<char>(size);
                           py::buffer_info bufinfo = result.request();
-                          b.read(bufinfo.ptr, size, skip);
+                          {
+                              py::gil_scoped_release release;
+                              b.read(bufinfo.ptr, size, skip);
+                          }
                           return result;
                       }), "Read from the buffer object requested number of bytes starting from specified offset")
+        .def("read_into", ([](xrt::bo &b, py::buffer pyb, size_t skip) {
+                               auto info = pyb.request(true);
+                               auto size = contiguous_size(info);
+                               py::gil_scoped_release release;
+                               b.read(info.ptr, size, skip);
+                           }), "Read from the buffer object into the provided writable buffer starting from specified offset without allocating")
         .def("sync", ([](xrt::bo &b, xclBOSyncDirection dir, size_t size, size_t offset)  {
                           b.sync(dir, size, offset);
-                      }), "Synchronize (DMA or cache flush/invalidation) the buffer in the requested direction")
+                      }), release_gil(), "Synchronize (DMA or cache flush/invalidation) the buffer in the requested direction")
         .def("sync", ([](xrt::bo& b, xclBOSyncDirection dir) {
                           b.sync(dir);
-                      }), "Sync entire buffer content in specified direction.")
+                      }), release_gil(), "Sync entire buffer content in specified direction.")
+        .def("async_", ([](xrt::bo& b, xclBOSyncDirection dir, size_t size, size_t offset) {
+                            return b.async(dir, size, offset);
+                        }), release_gil(), "Start a transfer of the buffer in the requested direction, returns an awaitable async_handle")
+        .def("async_", ([](xrt::bo& b, xclBOSyncDirection dir) {
+                            return b.async(dir);
+                        }), release_gil(), "Start a transfer of entire buffer in the requested direction, returns an awaitable async_handle")
+        .def("copy", ([](xrt::bo& b, const xrt::bo& src, size_t size, size_t src_offset, size_t dst_offset) {
+                          b.copy(src, size, src_offset, dst_offset);
+                      }), release_gil(), py::arg("src"), py::arg("size"), py::arg("src_offset") = 0, py::arg("dst_offset") = 0,
+             "Copy size bytes from src buffer object into this buffer object")
+        .def("async_copy", ([](xrt::bo& b, const xrt::bo& src, size_t size, size_t src_offset, size_t dst_offset) {
+                                return b.async_copy(src, size, src_offset, dst_offset);
+                            }), release_gil(), py::arg("src"), py::arg("size"), py::arg("src_offset") = 0, py::arg("dst_offset") = 0,
+             "Start a copy of size bytes from src buffer object into this buffer object, returns an awaitable async_handle")
         .def("map", ([](xrt::bo &b)  {
                          return py::memoryview::from_memory(b.map(), b.size());
                      }), "Create a byte accessible memory view of the buffer object")
+        .def("map_array", ([](py::object self, const py::dtype& dtype, std::vector<py::ssize_t> shape, size_t offset) {
+                               auto& b = self.cast<xrt::bo&>();
+                               auto itemsize = static_cast<size_t>(dtype.itemsize());
+                               if (shape.empty())
+                                   shape.push_back(static_cast<py::ssize_t>((b.size() - std::min(offset, b.size())) / itemsize));
+
+                               size_t bytes = itemsize;
+                               for (auto dim : shape)
+                                   bytes *= static_cast<size_t>(dim);
+                               if (offset + bytes > b.size())
+                                   throw py::value_error("array exceeds size of buffer object");
+
+                               // The array refers to the mapped memory and keeps the buffer object alive
+                               auto ptr = static_cast<char*>(b.map()) + offset;
+                               return py::array(dtype, shape, ptr, self);
+                           }), py::arg("dtype"), py::arg("shape") = std::vector<py::ssize_t>{}, py::arg("offset") = 0,
+             "Create a typed NumPy array view of the mapped buffer object without copying, by default a 1-D array covering the buffer")
+        .def("__dlpack__", ([](const xrt::bo& b, py::object /*stream*/) {
+                                return to_dlpack(b);
+                            }), py::arg("stream") = py::none(),
+             "Export the host side of the buffer object as a 1-D uint8 DLPack tensor")
+        .def("__dlpack_device__", ([](const xrt::bo&) {
+                                       return py::make_tuple(static_cast<int>(kDLCPU), 0);
+                                   }), "DLPack device of the buffer object host memory")
+        .def_static("from_dlpack", ([](const xrt::device& d, py::object obj, xrt::memory_group grp) {
+                                        py::capsule capsule = obj.attr("__dlpack__")();
+                                        auto t = capsule.get_pointer<DLManagedTensor>();
+                                        auto size = dlpack_size(t->dl_tensor);
+                                        auto ptr = static_cast<char*>(t->dl_tensor.data) + t->dl_tensor.byte_offset;
+                                        xrt::bo bo;
+                                        {
+                                            py::gil_scoped_release release;
+                                            bo = xrt::bo(d, ptr, size, grp);
+                                        }
+                                        // The unconsumed capsule owns the tensor memory, keep it
+                                        // with the buffer object implementation
+                                        xrt_core::bo_int::set_owner(bo, make_owner(py::object(std::move(capsule))));
+                                        return bo;
+                                    }), "Create a buffer object using the memory of a page aligned, contiguous host DLPack tensor (e.g. a NumPy array or a CPU torch tensor) without copying")
         .def("size", &xrt::bo::size, "Return the size of the buffer object")
         .def("address", &xrt::bo::address, "Return the device physical address of the buffer object");
 
@@ -26,6 +26,7 @@
 
 #include <limits>
 #include <memory>
+#include <vector>
 
 namespace xrt {
 
@@ -116,6 +117,53 @@ public:
   {
     m_graphHandle->read_graph_rtp(port, buffer, size);
   }
+
+  void*
+  resolve_rtp(const char* port)
+  {
+    return m_graphHandle->resolve_graph_rtp(port);
+  }
+
+  // rtp is the resolved port or nullptr if shim addresses ports by name
+  void
+  update_rtp(void* rtp, const char* port, const char* buffer, size_t size)
+  {
+    if (rtp)
+      m_graphHandle->update_resolved_graph_rtp(rtp, buffer, size);
+    else
+      m_graphHandle->update_graph_rtp(port, buffer, size);
+  }
+
+  void
+  read_rtp(void* rtp, const char* port, char* buffer, size_t size)
+  {
+    if (rtp)
+      m_graphHandle->read_resolved_graph_rtp(rtp, buffer, size);
+    else
+      m_graphHandle->read_graph_rtp(port, buffer, size);
+  }
+
+  void
+  update_rtps(const std::vector<xrt_core::graph_handle::rtp_update>& updates)
+  {
+    m_graphHandle->update_graph_rtps(updates.data(), updates.size());
+  }
+};
+
+// class graph::rtp_impl - RTP port resolved by graph::get_rtp()
+//
+// Refers to the graph it was resolved from, since the shim handle of
+// the port is valid only for the lifetime of the graph.
+class graph::rtp_impl
+{
+public:
+  std::shared_ptr<graph_impl> graph;
+  std::string port;
+  void* handle;  // shim handle, nullptr if shim addresses ports by name
+
+  rtp_impl(std::shared_ptr<graph_impl> g, std::string name, void* hdl)
+    : graph(std::move(g)), port(std::move(name)), handle(hdl)
+  {}
 };
 
 }
@@ -427,6 +475,62 @@ read_port(const std::string& port_name, void* value, size_t bytes)
   });
 }
 
+static const graph::rtp_impl&
+get_rtp_impl(const std::shared_ptr<graph_impl>& graph, const graph::rtp& port)
+{
+  const auto& impl = port.get_handle();
+  if (!impl)
+    throw xrt_core::error(EINVAL, "RTP port is not resolved");
+  if (impl->graph != graph)
+    throw xrt_core::error(EINVAL, "RTP port '" + impl->port + "' is resolved from a different graph");
+  return *impl;
+}
+
+graph::rtp
+graph::
+get_rtp(const std::string& port_name) const
+{
+  return xdp::native::profiling_wrapper("xrt::graph::get_rtp", [this, &port_name]{
+    auto rtp_handle = handle->resolve_rtp(port_name.c_str());
+    return rtp{std::make_shared<rtp_impl>(handle, port_name, rtp_handle)};
+  });
+}
+
+void
+graph::
+update_port(const rtp& port, const void* value, size_t bytes)
+{
+  xdp::native::profiling_wrapper("xrt::graph::update_port", [this, &port, value, bytes]{
+    const auto& impl = get_rtp_impl(handle, port);
+    handle->update_rtp(impl.handle, impl.port.c_str(), reinterpret_cast<const char*>(value), bytes);
+  });
+}
+
+void
+graph::
+read_port(const rtp& port, void* value, size_t bytes)
+{
+  xdp::native::profiling_wrapper("xrt::graph::read_port", [this, &port, value, bytes]{
+    const auto& impl = get_rtp_impl(handle, port);
+    handle->read_rtp(impl.handle, impl.port.c_str(), reinterpret_cast<char*>(value), bytes);
+  });
+}
+
+void
+graph::
+update(const std::vector<rtp_update>& updates)
+{
+  xdp::native::profiling_wrapper("xrt::graph::update", [this, &updates]{
+    std::vector<xrt_core::graph_handle::rtp_update> batch;
+    batch.reserve(updates.size());
+    for (const auto& upd : updates) {
+      const auto& impl = get_rtp_impl(handle, *upd.port);
+      batch.push_back({impl.handle, impl.port.c_str(), reinterpret_cast<const char*>(upd.value), upd.bytes});
+    }
+    handle->update_rtps(batch);
+  });
+}
+
 } // namespace xrt
 
 ////////////////////////////////////////////////////////////////
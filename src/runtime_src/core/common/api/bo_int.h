@@ -18,6 +18,16 @@ get_buffer_handle(const xrt::bo& bo);
 size_t
 get_offset(const xrt::bo& bo);
 
+// set_owner() - Tie lifetime of an object to the buffer object
+//
+// The owner is released when the last copy of the buffer object is
+// gone, after the shim handle has been freed.  Used by language
+// bindings to keep foreign memory backing a userptr buffer object
+// alive.
+XRT_CORE_COMMON_EXPORT
+void
+set_owner(const xrt::bo& bo, std::shared_ptr<void> owner);
+
 // create_debug_bo() - Create a debug buffer object within a hwctx
 //  
 // Allocates a debug buffer object within a hwctx. The debug BO
@@ -18,6 +18,13 @@ namespace xrt_core {
 class command : public std::enable_shared_from_this<command>
 {
 public:
+  /**
+   * enum priority - host side scheduling class of a command
+   *
+   * Matches xrt::run::priority
+   */
+  enum class priority : uint8_t { high, normal, low };
+
   /**
    * command() - construct a command object
    */
@@ -75,6 +82,18 @@ public:
   virtual hwctx_handle*
   get_hwctx_handle() const = 0;
 
+  /**
+   * get_priority() - host side scheduling class of command
+   *
+   * Used by the hw queue to order managed commands when host side
+   * scheduling is enabled (Runtime.hw_queue_qos_*)
+   */
+  virtual priority
+  get_priority() const
+  {
+    return priority::normal;
+  }
+
 private:
   unsigned long m_uid;
 };
@@ -4,12 +4,16 @@
 #define _XRT_COMMON_ELF_INT_H_
 
 // This file defines implementation extensions to the XRT ELF APIs.
+#include "core/common/config.h"
 #include "core/include/xrt/experimental/xrt_elf.h"
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace ELFIO { class elfio; }
+namespace xrt { class module_impl; }
 
 // Provide access to xrt::elf data that is not directly exposed
 // to end users via xrt::elf.   These functions are used by
@@ -22,7 +26,31 @@ get_section(const xrt::elf& elf, const std::string& sname);
 
 const ELFIO::elfio&
 get_elfio(const xrt::elf& elf);
-    
+
+// Get module parsed from ELF.  The module is shared by all callers
+// while it is alive, create() is called to construct the module if
+// there is none.  Module data parsed from ELF must be immutable
+// for the module to be shared.
+std::shared_ptr<xrt::module_impl>
+get_module(const xrt::elf& elf, const std::function<std::shared_ptr<xrt::module_impl>()>& create);
+
+// Statistics of the process wide ELF cache (Runtime.elf_cache).
+// ELF objects constructed from identical content share the parsed
+// ELF, and modules constructed from the same ELF share the parsed
+// control code.
+struct cache_stats
+{
+  uint64_t elf_hits = 0;       // ELF constructions served from cache
+  uint64_t elf_misses = 0;     // ELF constructions that parsed the ELF
+  uint64_t bytes_saved = 0;    // ELF content not parsed and copied again
+  uint64_t module_hits = 0;    // modules shared with other users of same ELF
+  uint64_t module_misses = 0;  // modules constructed from ELF
+};
+
+XRT_CORE_COMMON_EXPORT
+cache_stats
+get_cache_stats();
+
 
 }} // xclbin_int, xrt_core
 
@@ -10,8 +10,11 @@
 #include "fence_int.h"
 #include "kernel_int.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/debug.h"
 #include "core/common/device.h"
+#include "core/common/error.h"
+#include "core/common/message.h"
 #include "core/common/thread.h"
 #include "core/include/xrt/detail/ert.h"
 #include "core/include/xrt_hwqueue.h"
@@ -20,12 +23,15 @@
 #include "xrt/experimental/xrt_fence.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <sstream>
 #include <thread>
 
 using namespace std::chrono_literals;
@@ -79,6 +85,339 @@ notify_host(xrt_core::command* cmd)
   notify_host(cmd, get_command_state(cmd));
 }
 
+// class qos_scheduler - host side admission of managed commands
+//
+// @m_depth: Per class limit of commands in flight, 0 is unlimited
+// @m_bucket: Per class token bucket rate limit
+// @m_held: Per class FIFO of commands held back
+// @m_inflight: Admitted commands not yet retired
+// @m_inflight_count: Per class number of admitted commands not yet retired
+// @m_stats: Per class latency statistics
+//
+// Commands are admitted in priority class order and FIFO within a
+// class.  A command is held back while the number of commands of its
+// class in flight is at or above the depth limit of the class, or while the
+// token bucket of its class is empty.  Held back commands are
+// released by the command monitor when commands complete or tokens
+// are replenished.  A command is never admitted ahead of an earlier
+// held back command of same or higher priority.
+//
+// The scheduler is not thread safe, it is protected by the lock of
+// the command manager that owns it.
+class qos_scheduler
+{
+public:
+  using clock = std::chrono::steady_clock;
+  static constexpr size_t num_classes = 3;
+
+private:
+  struct token_bucket
+  {
+    double rate = 0;   // tokens per second, 0 is unlimited
+    double burst = 1;  // max tokens
+    double tokens = 1;
+    clock::time_point stamp;
+
+    void
+    refill(clock::time_point now)
+    {
+      auto elapsed = std::chrono::duration<double>(now - stamp).count();
+      tokens = std::min(burst, tokens + elapsed * rate);
+      stamp = now;
+    }
+
+    // Time at which one token is available
+    clock::time_point
+    next() const
+    {
+      auto wait = std::chrono::duration<double>((1 - tokens) / rate);
+      return stamp + std::chrono::duration_cast<clock::duration>(wait);
+    }
+  };
+
+  struct statistics
+  {
+    uint64_t count = 0;
+    uint64_t held = 0;
+    clock::duration wait_total {0};
+    clock::duration wait_max {0};
+    clock::duration latency_total {0};
+    clock::duration latency_max {0};
+  };
+
+  struct entry
+  {
+    xrt_core::command* cmd;
+    size_t cls;
+    clock::time_point admitted;
+  };
+
+  struct config
+  {
+    std::array<size_t, num_classes> depth {};
+    std::array<token_bucket, num_classes> bucket {};
+    bool enabled = false;
+  };
+
+  std::array<size_t, num_classes> m_depth {};
+  std::array<token_bucket, num_classes> m_bucket {};
+  std::array<std::deque<entry>, num_classes> m_held;
+  std::map<const xrt_core::command*, entry> m_inflight;
+  std::array<size_t, num_classes> m_inflight_count {};
+  std::array<statistics, num_classes> m_stats {};
+
+  static const char*
+  class_name(size_t cls)
+  {
+    static const char* names[num_classes] = {"high", "normal", "low"};
+    return names[cls];
+  }
+
+  static size_t
+  class_index(const std::string& name)
+  {
+    for (size_t cls = 0; cls < num_classes; ++cls)
+      if (name == class_name(cls))
+        return cls;
+    throw xrt_core::error(EINVAL, "Unknown hw queue priority class '" + name + "'");
+  }
+
+  // Parse <class>=<value>[,<class>=<value>]* and call
+  // setter(cls, value) for each entry
+  template <typename Setter>
+  static void
+  parse(const std::string& spec, Setter&& setter)
+  {
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      if (item.empty())
+        continue;
+      auto pos = item.find('=');
+      if (pos == std::string::npos)
+        throw xrt_core::error(EINVAL, "Bad hw queue qos setting '" + item + "'");
+      setter(class_index(item.substr(0, pos)), item.substr(pos + 1));
+    }
+  }
+
+  static config
+  read_config()
+  {
+    config cfg;
+    auto depth = xrt_core::config::get_hw_queue_qos_depth();
+    auto rate = xrt_core::config::get_hw_queue_qos_rate();
+    parse(depth, [&cfg](size_t cls, const std::string& value) {
+      cfg.depth[cls] = std::stoul(value);
+    });
+    parse(rate, [&cfg](size_t cls, const std::string& value) {
+      auto& bucket = cfg.bucket[cls];
+      auto pos = value.find(':');
+      bucket.rate = std::stod(value.substr(0, pos));
+      bucket.burst = (pos == std::string::npos) ? 1.0 : std::stod(value.substr(pos + 1));
+      bucket.tokens = bucket.burst = std::max(bucket.burst, 1.0);
+    });
+    cfg.enabled = !depth.empty() || !rate.empty();
+    return cfg;
+  }
+
+  static const config&
+  get_config()
+  {
+    static config cfg = read_config();
+    return cfg;
+  }
+
+  // Check if a command of class can be admitted now, consume
+  // a token if so.
+  bool
+  admissible(size_t cls, clock::time_point now)
+  {
+    if (m_depth[cls] && m_inflight_count[cls] >= m_depth[cls])
+      return false;
+
+    auto& bucket = m_bucket[cls];
+    if (bucket.rate == 0)
+      return true;
+
+    bucket.refill(now);
+    if (bucket.tokens < 1)
+      return false;
+
+    bucket.tokens -= 1;
+    return true;
+  }
+
+  void
+  start(const entry& e, clock::time_point now)
+  {
+    auto& stats = m_stats[e.cls];
+    auto wait = now - e.admitted;
+    ++stats.count;
+    stats.wait_total += wait;
+    stats.wait_max = std::max(stats.wait_max, wait);
+    m_inflight.emplace(e.cmd, e);
+    ++m_inflight_count[e.cls];
+  }
+
+  void
+  erase(std::map<const xrt_core::command*, entry>::iterator itr)
+  {
+    --m_inflight_count[itr->second.cls];
+    m_inflight.erase(itr);
+  }
+
+public:
+  // Scheduling is enabled globally through xrt.ini
+  static bool
+  enabled()
+  {
+    return get_config().enabled;
+  }
+
+  qos_scheduler()
+  {
+    reset();
+  }
+
+  // Reset scheduler for use by a new hw queue
+  void
+  reset()
+  {
+    const auto& cfg = get_config();
+    m_depth = cfg.depth;
+    m_bucket = cfg.bucket;
+    auto now = clock::now();
+    for (auto& bucket : m_bucket)
+      bucket.stamp = now;
+    m_stats = {};
+    m_inflight.clear();
+    m_inflight_count = {};
+    for (auto& held : m_held)
+      held.clear();
+  }
+
+  // Remove all held back commands, which will never be admitted
+  void
+  drain(std::vector<xrt_core::command*>& drained)
+  {
+    for (auto& held : m_held) {
+      for (const auto& e : held)
+        drained.push_back(e.cmd);
+      held.clear();
+    }
+  }
+
+  // Admit a command for execution.  Returns true if the command can
+  // be submitted now, otherwise the command is held back and later
+  // returned by release().
+  bool
+  admit(xrt_core::command* cmd)
+  {
+    auto now = clock::now();
+    auto cls = std::min(static_cast<size_t>(cmd->get_priority()), num_classes - 1);
+    entry e{cmd, cls, now};
+
+    auto bypass = std::all_of(m_held.begin(), m_held.begin() + cls + 1,
+                              [](const auto& held) { return held.empty(); });
+    if (bypass && admissible(cls, now)) {
+      start(e, now);
+      return true;
+    }
+
+    ++m_stats[cls].held;
+    m_held[cls].push_back(e);
+    return false;
+  }
+
+  // Move commands that can now be admitted to released.  Returns the
+  // time at which held back commands should be reconsidered, or
+  // time_point::max() if only command completion can release them.
+  clock::time_point
+  release(std::vector<xrt_core::command*>& released)
+  {
+    auto next = clock::time_point::max();
+    auto now = clock::now();
+    for (size_t cls = 0; cls < num_classes; ++cls) {
+      auto& held = m_held[cls];
+      while (!held.empty() && admissible(cls, now)) {
+        start(held.front(), now);
+        released.push_back(held.front().cmd);
+        held.pop_front();
+      }
+
+      if (held.empty())
+        continue;
+
+      // Held back by rate limit rather than depth
+      const auto& bucket = m_bucket[cls];
+      if (bucket.rate != 0 && bucket.tokens < 1)
+        next = std::min(next, bucket.next());
+
+      // Lower priority classes wait for this class
+      break;
+    }
+    return next;
+  }
+
+  bool
+  holding() const
+  {
+    return std::any_of(m_held.begin(), m_held.end(),
+                       [](const auto& held) { return !held.empty(); });
+  }
+
+  // Retire a completed command and record its latency
+  void
+  retire(const xrt_core::command* cmd)
+  {
+    auto itr = m_inflight.find(cmd);
+    if (itr == m_inflight.end())
+      return;
+
+    auto& stats = m_stats[itr->second.cls];
+    auto latency = clock::now() - itr->second.admitted;
+    stats.latency_total += latency;
+    stats.latency_max = std::max(stats.latency_max, latency);
+    erase(itr);
+  }
+
+  // Remove a command that failed submission
+  void
+  cancel(const xrt_core::command* cmd)
+  {
+    auto itr = m_inflight.find(cmd);
+    if (itr == m_inflight.end())
+      return;
+
+    --m_stats[itr->second.cls].count;
+    erase(itr);
+  }
+
+  // Report per class statistics through message interface
+  void
+  report(unsigned int uid) const
+  {
+    using us = std::chrono::microseconds;
+    for (size_t cls = 0; cls < num_classes; ++cls) {
+      const auto& stats = m_stats[cls];
+      if (!stats.count)
+        continue;
+
+      auto completed = stats.count - std::count_if(m_inflight.begin(), m_inflight.end(),
+                                                    [cls](const auto& v) { return v.second.cls == cls; });
+      std::ostringstream os;
+      os << "hw_queue(" << uid << ") priority(" << class_name(cls) << ")"
+         << " commands(" << stats.count << ") held(" << stats.held << ")"
+         << " avg_wait_us(" << std::chrono::duration_cast<us>(stats.wait_total).count() / stats.count << ")"
+         << " max_wait_us(" << std::chrono::duration_cast<us>(stats.wait_max).count() << ")";
+      if (completed)
+        os << " avg_latency_us(" << std::chrono::duration_cast<us>(stats.latency_total).count() / completed << ")"
+           << " max_latency_us(" << std::chrono::duration_cast<us>(stats.latency_max).count() << ")";
+      xrt_core::message::send(xrt_core::message::severity_level::info, "XRT", os.str());
+    }
+  }
+};
+
 // class command_manager - managed command executuon
 //
 // @m_qimpl: The hw queue used for command submission
@@ -119,6 +458,7 @@ private:
   std::mutex work_mutex;
   std::condition_variable work_cond;
   command_queue_type submitted_cmds;
+  qos_scheduler m_qos;  // host side scheduling if enabled
   bool stop = false;
 
   // thread can be constructed only after data members are initialized
@@ -136,21 +476,42 @@ private:
   {
     std::vector<xrt_core::command*> busy_cmds;
     std::vector<xrt_core::command*> running_cmds;
+    std::vector<xrt_core::command*> released_cmds;
+    auto qos = qos_scheduler::enabled();
 
     while (true) {
 
-      // Larger wait synchronized with launch()
+      // Larger wait synchronized with launch().  Commands held back by
+      // the scheduler are released here, a held back command is never
+      // waiting for anything but command completion or time.
+      auto next = qos_scheduler::clock::time_point::max();
       {
         std::unique_lock<std::mutex> lk(work_mutex);
-        while (!stop && running_cmds.empty() && submitted_cmds.empty())
-          work_cond.wait(lk);
+        if (qos)
+          next = release_nolock(released_cmds);
+        while (!stop && running_cmds.empty() && submitted_cmds.empty()) {
+          if (next == qos_scheduler::clock::time_point::max())
+            work_cond.wait(lk);
+          else
+            work_cond.wait_until(lk, next);
+          if (qos)
+            next = release_nolock(released_cmds);
+        }
       }
 
       if (stop)
         return;
 
-      // Finer wait
-      m_impl->wait(0);
+      submit_released(released_cmds);
+
+      // Finer wait, bounded by when held back commands can be released
+      if (next == qos_scheduler::clock::time_point::max()) {
+        m_impl->wait(0);
+      }
+      else {
+        auto ms = std::chrono::ceil<std::chrono::milliseconds>(next - qos_scheduler::clock::now());
+        m_impl->wait(std::max<size_t>(1, static_cast<size_t>(std::max<int64_t>(0, ms.count()))));
+      }
 
       // Drain submitted commands.  It is important that this comes
       // after exec_wait and is synchronized with launch() that added
@@ -177,8 +538,11 @@ private:
 
       // Preserve order of processing
       for (auto cmd : running_cmds) {
-        if (completed(cmd))
+        if (completed(cmd)) {
+          if (qos)
+            retire(cmd);
           notify_host(cmd);
+        }
         else
           busy_cmds.push_back(cmd);
       }
@@ -188,6 +552,66 @@ private:
     } // while (1)
   }
 
+  // Release held back commands that can now be admitted.  Released
+  // commands are tracked as submitted and must be submitted by caller
+  // after the lock is released.  Nothing is released once the
+  // executor is cleared.
+  qos_scheduler::clock::time_point
+  release_nolock(std::vector<xrt_core::command*>& released)
+  {
+    if (!m_impl)
+      return qos_scheduler::clock::time_point::max();
+
+    auto next = m_qos.release(released);
+    std::copy(released.begin(), released.end(), std::back_inserter(submitted_cmds));
+    return next;
+  }
+
+  // Submit commands released by the scheduler.  Failure to submit
+  // cannot be reported to the thread that started the command, so the
+  // command is marked as failed and the host is notified.
+  //
+  // Submission is synchronized with clear_executor(), commands that
+  // were released but not submitted before the executor was cleared
+  // are aborted.  The host is notified after the lock is released.
+  void
+  submit_released(std::vector<xrt_core::command*>& released)
+  {
+    if (released.empty())
+      return;
+
+    std::vector<std::pair<xrt_core::command*, ert_cmd_state>> failed;
+    {
+      std::lock_guard<std::mutex> lk(work_mutex);
+      for (auto cmd : released) {
+        try {
+          if (!m_impl)
+            throw xrt_core::error(ECANCELED, "hw queue destructed before held back command was submitted");
+          m_impl->submit(cmd);
+        }
+        catch (const std::exception& ex) {
+          m_qos.cancel(cmd);
+          submitted_cmds.erase(std::remove(submitted_cmds.begin(), submitted_cmds.end(), cmd), submitted_cmds.end());
+          xrt_core::send_exception_message(ex.what());
+          failed.emplace_back(cmd, m_impl ? ERT_CMD_STATE_ERROR : ERT_CMD_STATE_ABORT);
+        }
+      }
+    }
+    released.clear();
+
+    for (auto [cmd, state] : failed) {
+      cmd->get_ert_packet()->state = state;
+      notify_host(cmd, state);
+    }
+  }
+
+  void
+  retire(xrt_core::command* cmd)
+  {
+    std::lock_guard<std::mutex> lk(work_mutex);
+    m_qos.retire(cmd);
+  }
+
   // Start the monitor thread
   void
   monitor()
@@ -235,15 +659,32 @@ public:
   command_manager& operator=(const command_manager&) = delete;
   command_manager& operator=(command_manager&&) = delete;
 
+  // Commands still held back by the scheduler can no longer be
+  // submitted, they are aborted and the host is notified.
   void
-  clear_executor()
+  clear_executor(unsigned int uid)
   {
-    m_impl = nullptr;
+    std::vector<xrt_core::command*> aborted;
+    {
+      std::lock_guard<std::mutex> lk(work_mutex);
+      if (qos_scheduler::enabled()) {
+        m_qos.report(uid);
+        m_qos.drain(aborted);
+      }
+      m_impl = nullptr;
+    }
+
+    for (auto cmd : aborted) {
+      cmd->get_ert_packet()->state = ERT_CMD_STATE_ABORT;
+      notify_host(cmd, ERT_CMD_STATE_ABORT);
+    }
   }
 
   void
   set_executor(executor* impl)
   {
+    std::lock_guard<std::mutex> lk(work_mutex);
+    m_qos.reset();
     m_impl = impl;
   }
 
@@ -261,8 +702,15 @@ public:
     // Store command so completion can be tracked.  Make sure this is
     // done prior to exec_buf as exec_wait can otherwise be missed.
     // See detailed explanation in monitor loop.
+    //
+    // If the scheduler holds back the command, then it is submitted
+    // by the monitor thread when released.
     {
       std::lock_guard<std::mutex> lk(work_mutex);
+      if (qos_scheduler::enabled() && !m_qos.admit(cmd)) {
+        work_cond.notify_one();
+        return;
+      }
       submitted_cmds.push_back(cmd);
     }
 
@@ -276,6 +724,7 @@ public:
       assert(get_command_state(cmd)==ERT_CMD_STATE_NEW);
       if (!submitted_cmds.empty())
         submitted_cmds.pop_back();
+      m_qos.cancel(cmd);
       throw;
     }
 
@@ -360,7 +809,7 @@ public:
     try {
       XRT_DEBUGF("hw_queue_impl::~hw_queue_impl(%d)\n", m_uid);
       if (m_cmd_manager) {
-        m_cmd_manager->clear_executor();
+        m_cmd_manager->clear_executor(m_uid);
         std::lock_guard lk(s_pool_mutex);
         s_command_manager_pool.push_back(std::move(m_cmd_manager));
       }
@@ -418,6 +867,13 @@ public:
     get_cmd_manager()->launch(cmd);
   }
 
+  // Host side scheduling by priority applies to managed commands
+  virtual bool
+  scheduled() const
+  {
+    return qos_scheduler::enabled();
+  }
+
   // Unmanaged start submits command directly for execution
   // Command completion must be explicitly managed by application
   void
@@ -450,6 +906,14 @@ public:
     throw std::runtime_error("Managed execution is not supported for this device");
   }
 
+  // Commands are scheduled by the shim hwqueue_handle, priority is
+  // not applied on host.
+  bool
+  scheduled() const override
+  {
+    return false;
+  }
+
   std::cv_status
   wait(size_t /*timeout_ms*/) override
   {
@@ -895,6 +1359,13 @@ managed_start(xrt_core::command* cmd)
   get_handle()->managed_start(cmd);
 }
 
+bool
+hw_queue::
+scheduled() const
+{
+  return get_handle()->scheduled();
+}
+
 void
 hw_queue::
 unmanaged_start(xrt_core::command* cmd)
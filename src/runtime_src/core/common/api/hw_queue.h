@@ -47,6 +47,11 @@ public:
   void
   managed_start(xrt_core::command* cmd);
 
+  // Check if commands are scheduled on host by priority, in which
+  // case commands must be started managed for the priority to apply
+  bool
+  scheduled() const;
+
   // Start a command with explicit completion control from
   // application.
   XRT_CORE_COMMON_EXPORT
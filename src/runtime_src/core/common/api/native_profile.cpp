@@ -9,6 +9,101 @@
 #include "core/common/dlfcn.h"
 #include "core/common/time.h"
 
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct timestamp_record
+{
+  const char* function;
+  uint64_t start;
+  uint64_t end;
+};
+
+// Calls recorded by one thread.  Only the owning thread writes, the
+// buffer wraps around and retains the most recent calls.
+struct timestamp_buffer
+{
+  uint64_t tid;
+  uint64_t mask;
+  std::atomic<uint64_t> count {0};
+  std::vector<timestamp_record> records;
+
+  explicit timestamp_buffer(uint64_t capacity)
+    : tid(std::hash<std::thread::id>{}(std::this_thread::get_id()))
+    , mask(capacity - 1)
+    , records(capacity)
+  {}
+};
+
+// Buffers of all threads, dumped at exit.  Buffers are never freed
+// since threads may still be recording during static destruction.
+class timestamp_registry
+{
+  std::mutex m_mutex;
+  std::vector<timestamp_buffer*> m_buffers;
+
+public:
+  static timestamp_registry*
+  instance()
+  {
+    static auto registry = new timestamp_registry; // NOLINT, intentionally leaked
+    return registry;
+  }
+
+  timestamp_buffer*
+  add_buffer()
+  {
+    uint64_t capacity = 1;
+    while (capacity < xrt_core::config::get_native_xrt_timestamps_buffer())
+      capacity <<= 1;
+
+    auto buffer = new timestamp_buffer(capacity); // NOLINT, owned by registry
+    std::lock_guard lk(m_mutex);
+    m_buffers.push_back(buffer);
+    return buffer;
+  }
+
+  void
+  dump()
+  {
+    std::lock_guard lk(m_mutex);
+    if (m_buffers.empty())
+      return;
+
+    std::ofstream ofs("native_xrt_timestamps.csv");
+    ofs << "api,tid,start_ns,end_ns\n";
+    for (auto buffer : m_buffers) {
+      auto count = buffer->count.load(std::memory_order_acquire);
+      auto first = (count > buffer->records.size()) ? count - buffer->records.size() : 0;
+      for (auto idx = first; idx < count; ++idx) {
+        const auto& rec = buffer->records[idx & buffer->mask];
+        ofs << rec.function << "," << buffer->tid << "," << rec.start << "," << rec.end << "\n";
+      }
+    }
+  }
+};
+
+// Dumps recorded timestamps when the library is unloaded
+struct timestamp_dumper
+{
+  ~timestamp_dumper()
+  {
+    if (xrt_core::config::get_native_xrt_timestamps())
+      timestamp_registry::instance()->dump();
+  }
+};
+
+static timestamp_dumper s_timestamp_dumper; // NOLINT
+
+} // namespace
+
 namespace xdp::native {
 
 void
@@ -113,5 +208,14 @@ sync_logger::
   }
 }
 
-} // end namespace xdp::native
+void
+record_timestamp(const char* function, uint64_t start, uint64_t end)
+{
+  thread_local timestamp_buffer* buffer = timestamp_registry::instance()->add_buffer();
 
+  auto idx = buffer->count.load(std::memory_order_relaxed);
+  buffer->records[idx & buffer->mask] = {function, start, end};
+  buffer->count.store(idx + 1, std::memory_order_release);
+}
+
+} // end namespace xdp::native
@@ -5,6 +5,7 @@
 #define NATIVE_PROFILE_DOT_H
 #include "core/common/config.h"
 #include "core/common/config_reader.h"
+#include "core/common/time.h"
 #include "core/include/xrt.h"
 
 // This file contains the callback mechanisms for connecting the
@@ -47,15 +48,55 @@ public:
   ~generic_api_call_logger();
 } ;
 
+// Timestamp only logging, enabled with Debug.native_xrt_timestamps.
+// Start and end time of a call are written into a buffer owned by the
+// calling thread.  The buffer is allocated on first use in a thread,
+// recording a call takes no locks and does no allocation.
+void
+record_timestamp(const char* function, uint64_t start, uint64_t end);
+
+class timestamp_logger
+{
+  const char* m_function;
+  uint64_t m_start;
+
+  timestamp_logger() = delete ;
+  timestamp_logger(const timestamp_logger&) = delete ;
+  timestamp_logger(timestamp_logger&&) = delete ;
+  void operator=(const timestamp_logger&) = delete ;
+  void operator=(timestamp_logger&&) = delete ;
+
+public:
+  explicit timestamp_logger(const char* function)
+    : m_function(function)
+    , m_start(xrt_core::time_ns())
+  {}
+
+  ~timestamp_logger()
+  {
+    record_timestamp(m_function, m_start, xrt_core::time_ns());
+  }
+} ;
+
+// Profiling hooks are compiled out when XRT_DISABLE_NATIVE_PROFILE
+// is defined (cmake -DXRT_DISABLE_NATIVE_PROFILE=ON)
 template <typename Callable, typename ...Args>
 auto
 profiling_wrapper(const char* function, Callable&& f, Args&&...args)
 {
+#ifndef XRT_DISABLE_NATIVE_PROFILE
   if (xrt_core::config::get_native_xrt_trace()
       || xrt_core::config::get_host_trace()) {
     generic_api_call_logger log_object(function) ;
     return f(std::forward<Args>(args)...) ;  // NOLINT, clang-tidy false positive [potential leak]
   }
+  if (xrt_core::config::get_native_xrt_timestamps()) {
+    timestamp_logger log_object(function) ;
+    return f(std::forward<Args>(args)...) ;  // NOLINT, clang-tidy false positive [potential leak]
+  }
+#else
+  (void)function;
+#endif
   return f(std::forward<Args>(args)...) ;    // NOLINT, clang-tidy false positive [potential leak]
 }
 
@@ -81,11 +122,21 @@ template <typename Callable, typename ...Args>
 auto
 profiling_wrapper_sync(const char* function, xclBOSyncDirection dir, size_t size, Callable&& f, Args&&...args)
 {
+#ifndef XRT_DISABLE_NATIVE_PROFILE
   if (xrt_core::config::get_native_xrt_trace() ||
       xrt_core::config::get_host_trace()) {
     sync_logger log_object(function, (dir == XCL_BO_SYNC_BO_TO_DEVICE), size);
     return f(std::forward<Args>(args)...) ;
   }
+  if (xrt_core::config::get_native_xrt_timestamps()) {
+    timestamp_logger log_object(function) ;
+    return f(std::forward<Args>(args)...) ;
+  }
+#else
+  (void)function;
+  (void)dir;
+  (void)size;
+#endif
   return f(std::forward<Args>(args)...) ;
 }
 
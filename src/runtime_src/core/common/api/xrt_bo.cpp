@@ -26,6 +26,8 @@
 #include "core/common/message.h"
 #include "core/common/query_requests.h"
 #include "core/common/system.h"
+#include "core/common/task.h"
+#include "core/common/thread.h"
 #include "core/common/trace.h"
 #include "core/common/unistd.h"
 #include "core/common/xclbin_parser.h"
@@ -34,9 +36,12 @@
 #include "core/common/shim/shared_handle.h"
 
 #include <cstdlib>
+#include <future>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifdef _WIN32
@@ -217,6 +222,11 @@ private:
   // Usage logger for logging buffer stats
   std::shared_ptr<xrt_core::usage_metrics::base_logger> m_usage_logger =
       xrt_core::usage_metrics::get_usage_metrics_logger();
+  bool m_usage_logged = false;
+
+  // Owner of foreign memory backing the buffer, declared before the
+  // shim handle such that it is released after the handle
+  std::shared_ptr<void> m_owner;
 
 protected:
   // deliberately made protected, this is a file-scoped controlled API
@@ -278,13 +288,23 @@ public:
     , size(sz)
   {}
 
-  virtual ~bo_impl() = default;
+  virtual ~bo_impl()
+  {
+    if (m_usage_logged)
+      m_usage_logger->log_buffer_info_destruct(device->get_device_id(), size);
+  }
 
   bo_impl(const bo_impl&) = delete;
   bo_impl(bo_impl&&) = delete;
   bo_impl& operator=(bo_impl&) = delete;
   bo_impl& operator=(bo_impl&&) = delete;
 
+  void
+  set_owner(std::shared_ptr<void> owner)
+  {
+    m_owner = std::move(owner);
+  }
+
   xrt_core::buffer_handle*
   get_handle() const
   {
@@ -297,6 +317,15 @@ public:
     return m_usage_logger.get();
   }
 
+  // Log construction of this buffer with the usage metrics logger.
+  // Destruction is logged when the buffer is deleted.
+  void
+  log_construct()
+  {
+    m_usage_logger->log_buffer_info_construct(device->get_device_id(), size, device.get_hwctx_handle());
+    m_usage_logged = true;
+  }
+
   // BOs can be cloned internally by XRT to statisfy kernel
   // connectivity, the lifetime of a cloned BO is tied to the
   // lifetime of the BO from which is was cloned.
@@ -360,16 +389,22 @@ public:
     std::memcpy(dst, hbuf, sz);
   }
 
-  virtual void
-  copy(const bo_impl* src, size_t sz, size_t src_offset, size_t dst_offset)
+  // Check size and offset of dst and src
+  void
+  validate_copy(const bo_impl* src, size_t sz, size_t src_offset, size_t dst_offset) const
   {
-    // Check size and offset of dst and src
     if (!sz)
       throw xrt_core::system_error(EINVAL, "size must be a positive number");
     if (sz + dst_offset > size)
       throw xrt_core::system_error(EINVAL, "copying past destination buffer size");
     if (src->get_size() < sz + src_offset)
       throw xrt_core::system_error(EINVAL, "copying past source buffer size");
+  }
+
+  virtual void
+  copy(const bo_impl* src, size_t sz, size_t src_offset, size_t dst_offset)
+  {
+    validate_copy(src, sz, src_offset, dst_offset);
 
     if (get_device() != src->get_device()) {
       copy_with_export(src, sz, src_offset, dst_offset);
@@ -540,6 +575,77 @@ public:
   }
 };
 
+// class copy_engine - Background engine for asynchronous copy
+//
+// One engine per device executes copies in submission order on a
+// worker thread, like a device side DMA queue.  The copy itself is
+// the synchronous bo_impl::copy, so the engine overlaps m2m, kdma,
+// or copy through host with host work alike.
+class copy_engine
+{
+  xrt_core::task::queue m_queue;
+  std::thread m_worker;
+
+public:
+  copy_engine()
+    : m_worker(xrt_core::thread(xrt_core::task::worker, std::ref(m_queue)))
+  {}
+
+  ~copy_engine()
+  {
+    m_queue.stop();
+    m_worker.join();
+  }
+
+  copy_engine(const copy_engine&) = delete;
+  copy_engine& operator=(const copy_engine&) = delete;
+
+  std::shared_future<void>
+  submit(std::function<void()> fcn)
+  {
+    std::packaged_task<void()> task(std::move(fcn));
+    auto future = task.get_future().share();
+    m_queue.addWork(std::move(task));
+    return future;
+  }
+
+  static copy_engine&
+  get(const xrt_core::device* device)
+  {
+    static std::mutex mutex;
+    static std::map<const xrt_core::device*, std::unique_ptr<copy_engine>> engines;
+    std::lock_guard lk(mutex);
+    auto& engine = engines[device];
+    if (!engine)
+      engine = std::make_unique<copy_engine>();
+    return *engine;
+  }
+};
+
+// class copy_handle_impl - Handle of asynchronous copy
+//
+// The handle keeps both the destination (m_bo) and the source buffer
+// alive until the copy is done.
+class copy_handle_impl : public xrt::bo::async_handle_impl
+{
+  xrt::bo m_src;
+  std::shared_future<void> m_done;
+
+public:
+  copy_handle_impl(xrt::bo dst, xrt::bo src, std::shared_future<void> done)
+    : xrt::bo::async_handle_impl(std::move(dst))
+    , m_src(std::move(src))
+    , m_done(std::move(done))
+  {}
+
+  // wait() - Wait for copy to complete, rethrows copy errors
+  void
+  wait() override
+  {
+    m_done.get();
+  }
+};
+
 class aie::bo::async_handle_impl : public xrt::bo::async_handle_impl
 {
   // class for holding AIE BO Async DMA transfer information
@@ -1076,7 +1182,7 @@ alloc_kbuf(const device_type& device, size_t sz, xrtBufferFlags flags, xrtMemory
   XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_kbuf);
   auto handle = alloc_bo(device, sz, flags, grp);
   auto boh = std::make_shared<xrt::buffer_kbuf>(device, std::move(handle), sz);
-  boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(), sz, device.get_hwctx_handle());
+  boh->log_construct();
   return boh;
 }
 
@@ -1098,7 +1204,7 @@ alloc_ubuf(const device_type& device, void* userptr, size_t sz, xrtBufferFlags f
   // driver pins and manages userptr
   auto handle = alloc_bo(device, userptr, sz, flags, grp);
   auto boh = std::make_shared<xrt::buffer_ubuf>(device, std::move(handle), sz, userptr);
-  boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(), sz, device.get_hwctx_handle());
+  boh->log_construct();
   return boh;
 }
 
@@ -1108,7 +1214,7 @@ alloc_hbuf(const device_type& device, xrt_core::aligned_ptr_type&& hbuf, size_t
   XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_hbuf);
   auto handle =  alloc_bo(device, hbuf.get(), sz, flags, grp);
   auto boh = std::make_shared<xrt::buffer_hbuf>(device, std::move(handle), sz, std::move(hbuf));
-  boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(), sz, device.get_hwctx_handle());
+  boh->log_construct();
   return boh;
 }
 
@@ -1118,7 +1224,7 @@ alloc_dbuf(const device_type& device, size_t sz, xrtBufferFlags, xrtMemoryGroup
   XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_dbuf);
   auto handle = alloc_bo(device, sz, XCL_BO_FLAGS_DEV_ONLY, grp);
   auto boh = std::make_shared<xrt::buffer_dbuf>(device, std::move(handle), sz);
-  boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(), sz, device.get_hwctx_handle());
+  boh->log_construct();
   return boh;
 }
 
@@ -1134,7 +1240,7 @@ alloc_nodma(const device_type& device, size_t sz, xrtBufferFlags, xrtMemoryGroup
   auto hbuf_handle = alloc_bo(device, sz, XCL_BO_FLAGS_HOST_ONLY, grp);
   auto dbuf_handle = alloc_bo(device, sz, XCL_BO_FLAGS_DEV_ONLY, grp);
   auto boh = std::make_shared<xrt::buffer_nodma>(device, std::move(hbuf_handle), std::move(dbuf_handle), sz);
-  boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(), sz, device.get_hwctx_handle());
+  boh->log_construct();
   return boh;
 }
 
@@ -1187,7 +1293,7 @@ alloc_import(const device_type& device, xrt::bo_impl::export_handle ehdl)
 {
   XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_import);
   auto boh = std::make_shared<xrt::buffer_import>(device, ehdl);
-  boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(), boh->get_size(), device.get_hwctx_handle());
+  boh->log_construct();
   return boh;
 }
 
@@ -1196,9 +1302,7 @@ alloc_import_from_pid(const device_type& device, xrt::pid_type pid, xrt::bo_impl
 {
   XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_import_from_pid);
   auto boh = std::make_shared<xrt::buffer_import>(device, pid, ehdl);
-  boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(),
-                                                     boh->get_size(),
-                                                     device.get_hwctx_handle());
+  boh->log_construct();
   return boh;
 }
 
@@ -1207,9 +1311,7 @@ alloc_sub(const std::shared_ptr<xrt::bo_impl>& parent, size_t size, size_t offse
 {
   XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_sub);
   auto boh = std::make_shared<xrt::buffer_sub>(parent, size, offset);
-  boh->get_usage_logger()->log_buffer_info_construct(boh->get_core_device()->get_device_id(),
-                                                     boh->get_size(),
-                                                     boh->get_hwctx_handle());
+  boh->log_construct();
   return boh;
 }
 
@@ -1227,9 +1329,7 @@ alloc_clone(const std::shared_ptr<xrt::bo_impl>& src, xrt::memory_group grp)
 
   // the clone implmentation lifetime is tied to src
   src->add_clone(clone);
-  clone->get_usage_logger()->log_buffer_info_construct(device->get_device_id(),
-                                                       clone->get_size(),
-                                                       clone->get_hwctx_handle());
+  clone->log_construct();
   return clone;
 }
 
@@ -1558,6 +1658,22 @@ copy(const bo& src, size_t sz, size_t src_offset, size_t dst_offset)
     });
 }
 
+bo::async_handle
+bo::
+async_copy(const bo& src, size_t sz, size_t src_offset, size_t dst_offset)
+{
+  return xdp::native::profiling_wrapper("xrt::bo::async_copy",
+    [this, &src, sz, src_offset, dst_offset]{
+      handle->validate_copy(src.handle.get(), sz, src_offset, dst_offset);
+      auto& engine = copy_engine::get(handle->get_core_device());
+      auto done = engine.submit
+        ([dst = handle, src = src.handle, sz, src_offset, dst_offset] {
+          dst->copy(src.get(), sz, src_offset, dst_offset);
+        });
+      return async_handle{std::make_shared<copy_handle_impl>(*this, src, std::move(done))};
+    });
+}
+
 bo::
 ~bo() = default;
 
@@ -1689,6 +1805,13 @@ get_offset(const xrt::bo& bo)
   return handle->get_offset();
 }
 
+void
+set_owner(const xrt::bo& bo, std::shared_ptr<void> owner)
+{
+  auto handle = bo.get_handle();
+  handle->set_owner(std::move(owner));
+}
+
 static xrt::bo
 create_bo_helper(const xrt::hw_context& hwctx, size_t sz, uint32_t use_flag)
 {
@@ -12,41 +12,210 @@
 #include "core/common/message.h"
 
 #include <elfio/elfio.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
+#include <utility>
 #include <vector>
 
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace {
+
+// class elf_content - Read only view of ELF content
+//
+// A file is memory mapped where supported, otherwise read into a
+// buffer, a stream is read into a buffer.  The content is used for
+// computing the cache key and for parsing the ELF on a cache miss, so
+// a file is never copied into an intermediate buffer.  A cached ELF
+// keeps its content alive to verify cache hits against.
+class elf_content
+{
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+  std::vector<char> m_buffer;
+
+public:
+  explicit
+  elf_content(std::istream& stream)
+    : m_buffer{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()}
+  {
+    if (m_buffer.empty())
+      throw std::runtime_error("not a valid ELF stream");
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+  }
+
+  explicit
+  elf_content(const std::string& fnm)
+  {
+#ifdef _WIN32
+    std::ifstream ifs(fnm, std::ios::binary);
+    if (!ifs)
+      throw std::runtime_error(fnm + " is not found or is not a valid ELF file");
+    m_buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#else
+    auto fd = ::open(fnm.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error(fnm + " is not found or is not a valid ELF file");
+
+    struct stat st {};
+    if (::fstat(fd, &st) || st.st_size == 0) {
+      ::close(fd);
+      throw std::runtime_error(fnm + " is not found or is not a valid ELF file");
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+    auto addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+      throw xrt_core::system_error(errno, "failed to map " + fnm);
+
+    m_data = static_cast<const char*>(addr);
+#endif
+  }
+
+  ~elf_content()
+  {
+#ifndef _WIN32
+    if (m_data && m_buffer.empty())
+      ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+  }
+
+  elf_content(const elf_content&) = delete;
+  elf_content& operator=(const elf_content&) = delete;
+
+  [[nodiscard]] const char*
+  data() const
+  {
+    return m_data;
+  }
+
+  [[nodiscard]] size_t
+  size() const
+  {
+    return m_size;
+  }
+};
+
+// struct memory_streambuf - Seekable input stream buffer over memory
+//
+// ELFIO loads from a std::istream and seeks to section and segment
+// offsets.
+struct memory_streambuf : std::streambuf
+{
+  memory_streambuf(const char* data, size_t size)
+  {
+    auto begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+
+  pos_type
+  seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+  {
+    auto pos = (dir == std::ios_base::beg)
+      ? eback() + off
+      : (dir == std::ios_base::cur) ? gptr() + off : egptr() + off;
+    if (pos < eback() || pos > egptr())
+      return pos_type(off_type(-1));
+
+    setg(eback(), pos, egptr());
+    return pos_type(pos - eback());
+  }
+
+  pos_type
+  seekpos(pos_type pos, std::ios_base::openmode which) override
+  {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
+// FNV-1a hash of ELF content, combined with the content size to key
+// the cache.
+static uint64_t
+content_hash(const char* data, size_t size)
+{
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+} // namespace
+
 namespace xrt {
 
 // class elf_impl - Implementation
 class elf_impl
 {
   ELFIO::elfio m_elf;
+  size_t m_size = 0;
+
+  // ELF content, retained only for cached ELFs such that a cache hit
+  // on content hash can be verified against the actual bytes.
+  std::shared_ptr<const elf_content> m_content;
+
+  // Module parsed from this ELF, shared by all modules constructed
+  // from the ELF while any of them remain alive.
+  std::mutex m_mutex;
+  std::weak_ptr<xrt::module_impl> m_module;
+
 public:
-  explicit elf_impl(const std::string& fnm)
+  elf_impl(const char* data, size_t size, const std::string& name)
+    : m_size(size)
   {
-    if (!m_elf.load(fnm))
-      throw std::runtime_error(fnm + " is not found or is not a valid ELF file");
+    memory_streambuf buf(data, size);
+    std::istream stream(&buf);
+    if (!m_elf.load(stream))
+      throw std::runtime_error(name + " is not found or is not a valid ELF file");
 
     if (xrt_core::config::get_xrt_debug()) {
-      std::string message = "Loaded elf file " + fnm;
+      std::string message = "Loaded elf file " + name;
       xrt_core::message::send( xrt_core::message::severity_level::debug, "xrt_elf", message);
     }
   }
 
-  explicit elf_impl(std::istream& stream)
-  {
-    if (!m_elf.load(stream))
-      throw std::runtime_error("not a valid ELF stream");
-  }
-
   [[nodiscard]] const ELFIO::elfio&
   get_elfio() const
   {
     return m_elf;
   }
 
+  [[nodiscard]] size_t
+  get_size() const
+  {
+    return m_size;
+  }
+
+  elf_impl(std::shared_ptr<const elf_content> content, const std::string& name)
+    : elf_impl(content->data(), content->size(), name)
+  {
+    m_content = std::move(content);
+  }
+
+  [[nodiscard]] bool
+  has_content(const elf_content& content) const
+  {
+    return m_content && m_content->size() == content.size()
+      && std::equal(content.data(), content.data() + content.size(), m_content->data());
+  }
+
   [[nodiscard]] xrt::uuid
   get_cfg_uuid() const
   {
@@ -64,10 +233,112 @@ public:
     std::vector<uint8_t> vec(data, data + sec->get_size());
     return vec;
   }
+
+  std::shared_ptr<xrt::module_impl>
+  get_module(const std::function<std::shared_ptr<xrt::module_impl>()>& create, bool& hit)
+  {
+    std::lock_guard lk(m_mutex);
+    auto module = m_module.lock();
+    hit = (module != nullptr);
+    if (!module) {
+      module = create();
+      m_module = module;
+    }
+    return module;
+  }
 };
 
 } // namespace xrt
 
+namespace {
+
+// class elf_cache - Process wide cache of parsed ELF data
+//
+// Keyed by content, such that xrt::elf objects created from the same
+// file or from streams with identical content share the parsed ELF.
+// The cache holds weak references, entries are parsed again once all
+// xrt::elf objects referring to them are gone.  A lookup matching on
+// hash and size is a hit only if the content compares equal to that
+// of the cached ELF.
+class elf_cache
+{
+  using key_type = std::pair<uint64_t, size_t>;
+
+  std::mutex m_mutex;
+  std::map<key_type, std::weak_ptr<xrt::elf_impl>> m_entries;
+  xrt_core::elf_int::cache_stats m_stats;
+
+  void
+  purge()
+  {
+    for (auto itr = m_entries.begin(); itr != m_entries.end();) {
+      if (itr->second.expired())
+        itr = m_entries.erase(itr);
+      else
+        ++itr;
+    }
+  }
+
+public:
+  std::shared_ptr<xrt::elf_impl>
+  get(std::shared_ptr<const elf_content> content, const std::string& name)
+  {
+    auto size = content->size();
+    if (!xrt_core::config::get_elf_cache())
+      return std::make_shared<xrt::elf_impl>(content->data(), size, name);
+
+    key_type key{content_hash(content->data(), size), size};
+    std::lock_guard lk(m_mutex);
+    if (auto impl = m_entries[key].lock(); impl && impl->has_content(*content)) {
+      ++m_stats.elf_hits;
+      m_stats.bytes_saved += size;
+      return impl;
+    }
+
+    // Miss or hash collision, the latter replaces the cached entry
+    auto impl = std::make_shared<xrt::elf_impl>(std::move(content), name);
+    ++m_stats.elf_misses;
+    purge();
+    m_entries[key] = impl;
+    return impl;
+  }
+
+  void
+  add_module_stat(bool hit)
+  {
+    std::lock_guard lk(m_mutex);
+    ++(hit ? m_stats.module_hits : m_stats.module_misses);
+  }
+
+  xrt_core::elf_int::cache_stats
+  get_stats()
+  {
+    std::lock_guard lk(m_mutex);
+    return m_stats;
+  }
+};
+
+static elf_cache&
+get_elf_cache()
+{
+  static elf_cache cache;
+  return cache;
+}
+
+static std::shared_ptr<xrt::elf_impl>
+create_elf_impl(const std::string& fnm)
+{
+  return get_elf_cache().get(std::make_shared<const elf_content>(fnm), fnm);
+}
+
+static std::shared_ptr<xrt::elf_impl>
+create_elf_impl(std::istream& stream)
+{
+  return get_elf_cache().get(std::make_shared<const elf_content>(stream), "ELF stream");
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////
 // XRT implmentation access to internal elf APIs
 ////////////////////////////////////////////////////////////////
@@ -86,6 +357,24 @@ get_elfio(const xrt::elf& elf)
   return elf.get_handle()->get_elfio();
 }
 
+std::shared_ptr<xrt::module_impl>
+get_module(const xrt::elf& elf, const std::function<std::shared_ptr<xrt::module_impl>()>& create)
+{
+  if (!xrt_core::config::get_elf_cache())
+    return create();
+
+  bool hit = false;
+  auto module = elf.get_handle()->get_module(create, hit);
+  get_elf_cache().add_module_stat(hit);
+  return module;
+}
+
+cache_stats
+get_cache_stats()
+{
+  return get_elf_cache().get_stats();
+}
+
 } // xrt_core::elf_int
 
 ////////////////////////////////////////////////////////////////
@@ -95,12 +384,12 @@ namespace xrt {
 
 elf::
 elf(const std::string& fnm)
-  : detail::pimpl<elf_impl>{std::make_shared<elf_impl>(fnm)}
+  : detail::pimpl<elf_impl>{create_elf_impl(fnm)}
 {}
 
 elf::
 elf(std::istream& stream)
-  : detail::pimpl<elf_impl>{std::make_shared<elf_impl>(stream)}
+  : detail::pimpl<elf_impl>{create_elf_impl(stream)}
 {}
 
 xrt::uuid
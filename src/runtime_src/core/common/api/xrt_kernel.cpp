@@ -43,6 +43,7 @@
 #include "core/common/message.h"
 #include "core/common/system.h"
 #include "core/common/trace.h"
+#include "core/common/latency.h"
 #include "core/common/usage_metrics.h"
 #include "core/common/xclbin_parser.h"
 
@@ -861,13 +862,18 @@ public:
       std::lock_guard<std::mutex> lk(m_mutex);
       if (!m_done)
         throw std::runtime_error("bad command state, can't launch");
-      m_managed = (m_callbacks && !m_callbacks->empty());
+      m_managed = (m_callbacks && !m_callbacks->empty()) || m_hwqueue.scheduled();
       m_done = false;
+      if (m_latency)
+        m_latency_ts = {xrt_core::latency::ticks(), 0, 0, false};
     }
     if (m_managed)
       m_hwqueue.managed_start(this);
     else
       m_hwqueue.unmanaged_start(this);
+
+    if (m_latency)
+      record_submitted();
   }
 
   // Wait for command completion
@@ -883,6 +889,9 @@ public:
       m_hwqueue.wait(this);
     }
 
+    if (m_latency)
+      record_notified();
+
     return get_state_raw(); // state wont change after wait
   }
 
@@ -900,6 +909,9 @@ public:
         return {get_state_raw(), std::cv_status::timeout};
     }
 
+    if (m_latency)
+      record_notified();
+
     return {get_state_raw(), std::cv_status::no_timeout};
   }
 
@@ -932,6 +944,18 @@ public:
       : nullptr;
   }
 
+  priority
+  get_priority() const override
+  {
+    return m_priority;
+  }
+
+  void
+  set_priority(priority prio)
+  {
+    m_priority = prio;
+  }
+
   void
   notify(ert_cmd_state s) const override
   {
@@ -949,15 +973,28 @@ public:
       XRT_DEBUGF("kernel_command::notify() m_uid(%d) m_state(%d)\n", m_uid, s);
       complete = m_done = true;
       callbacks = (m_callbacks && !m_callbacks->empty());
+      if (m_latency)
+        record_completed_nolock();
     }
 
     if (complete) {
       m_exec_done.notify_all();
-      if (callbacks)
+      if (callbacks) {
         run_callbacks(s);
+        // Callbacks are the host notification of managed execution
+        if (m_latency)
+          record_notified();
+      }
     }
   }
 
+  // Record latency of runs of this command in kernel statistics
+  void
+  set_latency_stats(std::shared_ptr<xrt_core::latency::kernel_stats> stats)
+  {
+    m_latency = std::move(stats);
+  }
+
   void
   bind_arg_at_index(size_t index, const xrt::bo& bo)
   {
@@ -975,11 +1012,63 @@ private:
   unsigned int m_uid = 0;
   bool m_managed = false;
   mutable bool m_done = false;
+  priority m_priority = priority::normal; // host side scheduling class
 
   mutable std::mutex m_mutex;
   mutable std::condition_variable m_exec_done;
 
   std::unique_ptr<callback_list> m_callbacks;
+
+  // Latency time stamps of current run, protected by m_mutex.
+  // Submission and completion can be observed in either order by
+  // different threads, execute latency is recorded by the last.
+  struct latency_timestamps
+  {
+    uint64_t start;
+    uint64_t submitted;
+    uint64_t completed;
+    bool notified;
+  };
+  std::shared_ptr<xrt_core::latency::kernel_stats> m_latency;
+  mutable latency_timestamps m_latency_ts {0, 0, 0, false};
+
+  static uint64_t
+  elapsed(uint64_t from, uint64_t to)
+  {
+    return to > from ? to - from : 0;
+  }
+
+  void
+  record_submitted()
+  {
+    auto now = xrt_core::latency::ticks();
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_latency_ts.submitted = now;
+    m_latency->record(xrt_core::latency::phase::submit, elapsed(m_latency_ts.start, now));
+    if (m_latency_ts.completed)
+      m_latency->record(xrt_core::latency::phase::execute, elapsed(now, m_latency_ts.completed));
+  }
+
+  void
+  record_completed_nolock() const
+  {
+    auto now = xrt_core::latency::ticks();
+    m_latency_ts.completed = now;
+    if (m_latency_ts.submitted)
+      m_latency->record(xrt_core::latency::phase::execute, elapsed(m_latency_ts.submitted, now));
+  }
+
+  // First host notification of completion records notify latency
+  void
+  record_notified() const
+  {
+    auto now = xrt_core::latency::ticks();
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_latency_ts.notified || !m_latency_ts.completed)
+      return;
+    m_latency_ts.notified = true;
+    m_latency->record(xrt_core::latency::phase::notify, elapsed(m_latency_ts.completed, now));
+  }
 };
 
 // class argument - get argument value from va_arg
@@ -1321,6 +1410,7 @@ private:
   uint32_t m_ctrl_code_index = 0;      // Index to identify which ctrl code to load in elf
   std::shared_ptr<xrt_core::usage_metrics::base_logger> m_usage_logger =
       xrt_core::usage_metrics::get_usage_metrics_logger();
+  std::shared_ptr<xrt_core::latency::kernel_stats> m_latency; // run latency if enabled
 
   // Open context of a specific compute unit.
   //
@@ -1590,6 +1680,7 @@ public:
     amend_args();
 
     m_usage_logger->log_kernel_info(device->core_device.get(), hwctx, name, args.size());
+    m_latency = xrt_core::latency::get_kernel_stats(name);
   }
 
   kernel_impl(std::shared_ptr<device_type> dev, xrt::hw_context ctx, const std::string& nm)
@@ -1611,6 +1702,7 @@ public:
     // amend args with computed data based on kernel protocol
     amend_args();
     m_usage_logger->log_kernel_info(device->core_device.get(), hwctx, name, args.size());
+    m_latency = xrt_core::latency::get_kernel_stats(name);
   }
 
   std::shared_ptr<kernel_impl>
@@ -1675,6 +1767,12 @@ public:
     return name;
   }
 
+  const std::shared_ptr<xrt_core::latency::kernel_stats>&
+  get_latency_stats() const
+  {
+    return m_latency;
+  }
+
   uint32_t
   get_ctrl_code_index() const
   {
@@ -1846,6 +1944,7 @@ public:
 class run_impl
 {
   friend class mailbox_impl;
+  friend class run_template_impl;
   using ipctx = std::shared_ptr<ip_context>;
   using control_type = kernel_impl::control_type;
   using kernel_type = kernel_impl::kernel_type;
@@ -2151,6 +2250,18 @@ public:
     cmd->pop_callback();
   }
 
+  void
+  set_priority(xrt::run::priority prio)
+  {
+    cmd->set_priority(static_cast<xrt_core::command::priority>(prio));
+  }
+
+  xrt::run::priority
+  get_priority() const
+  {
+    return static_cast<xrt::run::priority>(cmd->get_priority());
+  }
+
   // run_type() - constructor
   //
   // @krnl:  kernel object to run
@@ -2177,6 +2288,7 @@ public:
     , uid(create_uid())
   {
     XRT_DEBUGF("run_impl::run_impl(%d)\n" , uid);
+    cmd->set_latency_stats(kernel->get_latency_stats());
   }
 
   // Clones a run impl, so that the clone can be executed concurrently
@@ -2196,12 +2308,14 @@ public:
     , encode_cumasks(rhs->encode_cumasks)
   {
     XRT_DEBUGF("run_impl::run_impl(%d)\n" , uid);
+    cmd->set_latency_stats(kernel->get_latency_stats());
   }
 
   virtual
   ~run_impl()
   {
     XRT_DEBUGF("run_impl::~run_impl(%d)\n" , uid);
+    m_usage_logger->log_kernel_run_destruct(this);
   }
 
   run_impl(const run_impl&) = delete;
@@ -2845,6 +2959,104 @@ public:
   }
 };
 
+// class run_template_impl - Pre-validated run arguments
+//
+// A prototype run object holds the validated and encoded arguments
+// and the compute units that remain after connectivity validation.
+// Runs are created by cloning the command packet of the prototype,
+// which avoids argument encoding and connectivity validation per run.
+// Kernels with an instruction module patch the module per run
+// object, runs of such kernels replay the template arguments.
+class run_template_impl
+{
+  std::shared_ptr<kernel_impl> m_kernel;
+  std::unique_ptr<run_impl> m_proto;
+  std::map<size_t, xrt::bo> m_bos;                  // global args by index
+  std::map<size_t, std::vector<uint8_t>> m_values;  // scalar args by index
+
+  std::shared_ptr<run_impl>
+  clone() const
+  {
+    auto run = std::make_shared<run_impl>(m_proto.get());
+    for (const auto& [index, bo] : m_bos)
+      run->get_cmd()->bind_arg_at_index(index, bo);
+    return run;
+  }
+
+  std::shared_ptr<run_impl>
+  replay() const
+  {
+    auto run = std::make_shared<run_impl>(m_kernel);
+    for (const auto& [index, value] : m_values)
+      run->set_arg_value(m_kernel->get_arg(index), value.data(), value.size());
+    for (const auto& [index, bo] : m_bos)
+      run->set_arg_value(m_kernel->get_arg(index), bo);
+    run->set_cus(m_proto->get_cumask());
+    return run;
+  }
+
+public:
+  explicit
+  run_template_impl(std::shared_ptr<kernel_impl> kernel)
+    : m_kernel(std::move(kernel))
+  {
+    if (m_kernel->has_mailbox())
+      throw xrt_core::error(std::errc::not_supported, "run template of kernel with mailbox");
+
+    m_proto = std::make_unique<run_impl>(m_kernel);
+  }
+
+  void
+  set_arg_at_index(size_t index, const void* value, size_t bytes)
+  {
+    m_proto->set_arg_at_index(index, value, bytes);
+    auto bytes_ptr = static_cast<const uint8_t*>(value);
+    m_values[index].assign(bytes_ptr, bytes_ptr + bytes);
+  }
+
+  void
+  set_arg_at_index(size_t index, const xrt::bo& argbo)
+  {
+    auto bo = m_proto->validate_bo_at_index(index, argbo);
+    m_proto->set_arg_value(m_kernel->get_arg(index), bo);
+    m_bos[index] = std::move(bo);
+  }
+
+  size_t
+  get_num_cus() const
+  {
+    return m_proto->ips.size();
+  }
+
+  std::shared_ptr<run_impl>
+  create(size_t cu, const std::vector<xrt::run_template::arg_offset>& offsets) const
+  {
+    if (cu != xrt::run_template::any_cu && cu >= m_proto->ips.size())
+      throw xrt_core::error(EINVAL, "No compute unit at index " + std::to_string(cu) + " in run template");
+
+    auto run = m_proto->m_module ? replay() : clone();
+
+    if (cu != xrt::run_template::any_cu) {
+      std::bitset<max_cus> mask;
+      mask.set(m_proto->ips[cu]->get_cuidx());
+      run->set_cus(mask);
+    }
+
+    // A region of a buffer is in the same memory bank as the buffer
+    // so connectivity need not be validated again
+    for (const auto& off : offsets) {
+      auto itr = m_bos.find(off.index);
+      if (itr == m_bos.end())
+        throw xrt_core::error(EINVAL, "No global buffer argument at index " + std::to_string(off.index) + " in run template");
+
+      xrt::bo region{(*itr).second, off.size, off.offset};
+      run->set_arg_value(m_kernel->get_arg(off.index), region);
+    }
+
+    return run;
+  }
+};
+
 // struct run_update_type - RTP update
 //
 // Asynchronous runtime update of kernel arguments.  Each argument is
@@ -3372,6 +3584,202 @@ public:
   {}
 };
 
+// class run_sequence_impl - Captured runs and buffer syncs
+//
+// The captured sequence is split into segments, where a segment is
+// a list of buffer syncs followed by a runlist with the runs captured
+// after the syncs.  A sync captured after a run depends on completion
+// of that run and starts a new segment.  Syncs captured after the
+// last run are in a segment without runs, which is performed when
+// the last runlist has completed.
+//
+// The runlists encode the chained commands once when runs are
+// captured, so a replay of a segment is one execute of its runlist.
+class run_sequence_impl
+{
+  struct sync_type
+  {
+    xrt::bo bo;
+    xclBOSyncDirection dir;
+  };
+
+  struct segment_type
+  {
+    std::vector<sync_type> syncs;
+    std::vector<xrt::run> runs;
+    xrt::runlist runlist;
+  };
+
+  struct variable_type
+  {
+    xrt::run run;
+    int index;
+  };
+
+  xrt::hw_context m_hwctx;
+  std::vector<segment_type> m_segments;
+  std::vector<variable_type> m_variables;
+
+  // Index of segment with the last submitted runlist while the
+  // sequence is executing
+  static constexpr size_t noidx = std::numeric_limits<size_t>::max();
+  size_t m_running = noidx;
+
+  void
+  idle_or_error(const char* what) const
+  {
+    if (m_running != noidx)
+      throw xrt_core::error(std::string{"run sequence is executing, wait() is required before "} + what);
+  }
+
+  segment_type&
+  add_segment()
+  {
+    m_segments.push_back({{}, {}, xrt::runlist{m_hwctx}});
+    return m_segments.back();
+  }
+
+  static void
+  sync(segment_type& segment)
+  {
+    for (auto& sync : segment.syncs)
+      sync.bo.sync(sync.dir);
+  }
+
+  // Wait for runlist of segment at index.  The sequence is no longer
+  // executing if wait throws.
+  std::cv_status
+  wait_segment(size_t idx, const std::chrono::milliseconds& timeout)
+  {
+    try {
+      return m_segments[idx].runlist.wait(timeout);
+    }
+    catch (...) {
+      m_running = noidx;
+      throw;
+    }
+  }
+
+  variable_type&
+  get_variable(size_t var)
+  {
+    idle_or_error("changing a variable");
+    if (var >= m_variables.size())
+      throw xrt_core::error(std::errc::invalid_argument, "no such run sequence variable: " + std::to_string(var));
+    return m_variables[var];
+  }
+
+public:
+  explicit
+  run_sequence_impl(xrt::hw_context hwctx)
+    : m_hwctx{std::move(hwctx)}
+  {}
+
+  void
+  add(const xrt::run& run)
+  {
+    idle_or_error("capturing a run");
+    auto& segment = m_segments.empty() ? add_segment() : m_segments.back();
+    segment.runlist.add(run);
+    segment.runs.push_back(run);
+  }
+
+  void
+  add_sync(const xrt::bo& bo, xclBOSyncDirection dir)
+  {
+    idle_or_error("capturing a sync");
+    auto& segment = (m_segments.empty() || !m_segments.back().runs.empty())
+      ? add_segment()
+      : m_segments.back();
+    segment.syncs.push_back({bo, dir});
+  }
+
+  size_t
+  add_variable(const xrt::run& run, int index)
+  {
+    auto captured = std::any_of(m_segments.begin(), m_segments.end(), [&run](const auto& segment) {
+      return std::any_of(segment.runs.begin(), segment.runs.end(), [&run](const auto& r) {
+        return r.get_handle() == run.get_handle();
+      });
+    });
+
+    if (!captured)
+      throw xrt_core::error(std::errc::invalid_argument, "run object is not captured by run sequence");
+
+    m_variables.push_back({run, index});
+    return m_variables.size() - 1;
+  }
+
+  void
+  set_arg_at_index(size_t var, const void* value, size_t bytes)
+  {
+    auto& variable = get_variable(var);
+    variable.run.get_handle()->set_arg_at_index(variable.index, value, bytes);
+  }
+
+  void
+  set_arg_at_index(size_t var, const xrt::bo& boh)
+  {
+    auto& variable = get_variable(var);
+    variable.run.get_handle()->set_arg_at_index(variable.index, boh);
+  }
+
+  void
+  replay()
+  {
+    idle_or_error("replay");
+
+    size_t last = noidx;
+    for (size_t idx = 0; idx < m_segments.size(); ++idx) {
+      auto& segment = m_segments[idx];
+
+      // Syncs after the last runs are performed by wait()
+      if (segment.runs.empty() && last != noidx)
+        break;
+
+      // Syncs between runs depend on the runs before them
+      if (last != noidx) {
+        m_running = last;
+        wait_segment(last, std::chrono::milliseconds(0));
+        m_running = noidx;
+      }
+
+      sync(segment);
+      if (segment.runs.empty())
+        continue;
+
+      // A runlist that failed submission must be waited for
+      try {
+        segment.runlist.execute();
+      }
+      catch (...) {
+        m_running = idx;
+        throw;
+      }
+      last = idx;
+    }
+
+    m_running = last;
+  }
+
+  std::cv_status
+  wait(const std::chrono::milliseconds& timeout)
+  {
+    if (m_running == noidx)
+      return std::cv_status::no_timeout;
+
+    if (wait_segment(m_running, timeout) == std::cv_status::timeout)
+      return std::cv_status::timeout;
+
+    auto next = m_running + 1;
+    m_running = noidx;
+    if (next < m_segments.size())
+      sync(m_segments[next]);
+
+    return std::cv_status::no_timeout;
+  }
+};
+
 } // namespace xrt
 
 namespace {
@@ -3881,6 +4289,20 @@ add_callback(ert_cmd_state state,
   handle->add_callback([fn = std::move(fcn), key, data](ert_cmd_state state) { fn(key, state, data); });
 }
 
+void
+run::
+set_priority(priority prio)
+{
+  handle->set_priority(prio);
+}
+
+run::priority
+run::
+get_priority() const
+{
+  return handle->get_priority();
+}
+
 ert_packet*
 run::
 get_ert_packet() const
@@ -4160,6 +4582,107 @@ what() const noexcept
 
 } // xrt
 
+////////////////////////////////////////////////////////////////
+// xrt::run_template
+////////////////////////////////////////////////////////////////
+namespace xrt {
+
+run_template::
+run_template(const xrt::kernel& kernel)
+  : detail::pimpl<run_template_impl>(std::make_shared<run_template_impl>(kernel.get_handle()))
+{}
+
+void
+run_template::
+set_arg_at_index(int index, const void* value, size_t bytes)
+{
+  handle->set_arg_at_index(index, value, bytes);
+}
+
+void
+run_template::
+set_arg_at_index(int index, const xrt::bo& boh)
+{
+  handle->set_arg_at_index(index, boh);
+}
+
+size_t
+run_template::
+get_num_cus() const
+{
+  return handle->get_num_cus();
+}
+
+xrt::run
+run_template::
+create(size_t cu, const std::vector<arg_offset>& offsets) const
+{
+  return xrt::run{handle->create(cu, offsets)};
+}
+
+} // xrt
+
+////////////////////////////////////////////////////////////////
+// xrt::run_sequence
+////////////////////////////////////////////////////////////////
+namespace xrt {
+
+run_sequence::
+run_sequence(const xrt::hw_context& hwctx)
+  : detail::pimpl<run_sequence_impl>(std::make_shared<run_sequence_impl>(hwctx))
+{}
+
+void
+run_sequence::
+add(const xrt::run& run)
+{
+  handle->add(run);
+}
+
+void
+run_sequence::
+add_sync(const xrt::bo& bo, xclBOSyncDirection dir)
+{
+  handle->add_sync(bo, dir);
+}
+
+size_t
+run_sequence::
+add_variable(const xrt::run& run, int index)
+{
+  return handle->add_variable(run, index);
+}
+
+void
+run_sequence::
+set_arg_at_index(size_t var, const void* value, size_t bytes)
+{
+  handle->set_arg_at_index(var, value, bytes);
+}
+
+void
+run_sequence::
+set_arg_at_index(size_t var, const xrt::bo& boh)
+{
+  handle->set_arg_at_index(var, boh);
+}
+
+void
+run_sequence::
+replay()
+{
+  handle->replay();
+}
+
+std::cv_status
+run_sequence::
+wait(const std::chrono::milliseconds& timeout) const
+{
+  return handle->wait(timeout);
+}
+
+} // xrt
+
 ////////////////////////////////////////////////////////////////
 // xrt::runlist::command_error
 ////////////////////////////////////////////////////////////////
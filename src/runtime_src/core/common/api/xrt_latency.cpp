@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// This file implements XRT latency APIs as declared in
+// core/include/experimental/xrt_latency.h
+#define XRT_API_SOURCE         // exporting xrt_latency.h
+#define XRT_CORE_COMMON_SOURCE // in same dll as coreutil
+#include "core/include/xrt/experimental/xrt_latency.h"
+
+#include "core/common/latency.h"
+
+////////////////////////////////////////////////////////////////
+// xrt_latency C++ API implementations (xrt_latency.h)
+////////////////////////////////////////////////////////////////
+namespace xrt::ext {
+
+latency_summary
+get_latency(const xrt::kernel& kernel, latency_phase phase)
+{
+  latency_summary summary {};
+  auto stats = xrt_core::latency::get_kernel_stats(kernel.get_name());
+  if (!stats)
+    return summary;
+
+  auto sum = stats->phases[static_cast<size_t>(phase)].get_summary();
+  summary.count = sum.count;
+  summary.min_ns = sum.min_ns;
+  summary.max_ns = sum.max_ns;
+  summary.mean_ns = sum.mean_ns;
+  summary.p50_ns = sum.p50_ns;
+  summary.p90_ns = sum.p90_ns;
+  summary.p99_ns = sum.p99_ns;
+  summary.p999_ns = sum.p999_ns;
+  return summary;
+}
+
+std::string
+get_latency_report()
+{
+  return xrt_core::latency::report();
+}
+
+void
+reset_latency()
+{
+  xrt_core::latency::reset();
+}
+
+} // xrt::ext
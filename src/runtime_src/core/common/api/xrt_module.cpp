@@ -25,6 +25,7 @@
 #include <elfio/elfio.hpp>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <cstring>
@@ -168,10 +169,13 @@ struct patcher
     uint64_t offset_to_patch_buffer;
     uint32_t offset_to_base_bo_addr;
     uint32_t mask; // This field is valid only when patching scheme is scalar_32bit_kind
-    bool dirty = false; // Tells whether this entry is already patched or not
-    uint32_t bd_data_ptrs[max_bd_words]; // array to store bd ptrs original values
   };
 
+  // Original bd ptr values of a patched buffer, keyed by patch location.
+  // The patcher is shared by all modules created from the same ELF, so
+  // this state is owned by the buffer being patched, not by the patcher.
+  using patch_state = std::map<const uint32_t*, std::array<uint32_t, max_bd_words>>;
+
   std::vector<patch_info> m_ctrlcode_patchinfo;
 
   inline static const std::string_view
@@ -290,18 +294,18 @@ struct patcher
   }
 
   void
-  patch_it(uint8_t* base, uint64_t new_value)
+  patch_it(uint8_t* base, uint64_t new_value, patch_state& state)
   {
     for (auto& item : m_ctrlcode_patchinfo) {
       auto bd_data_ptr = reinterpret_cast<uint32_t*>(base + item.offset_to_patch_buffer);
-      if (!item.dirty) {
-        // first time patching cache bd ptr values using bd ptrs array in patch info
-        std::copy(bd_data_ptr, bd_data_ptr + max_bd_words, item.bd_data_ptrs);
-        item.dirty = true;
+      auto [itr, first] = state.try_emplace(bd_data_ptr);
+      if (first) {
+        // first time patching cache bd ptr values in buffer's patch state
+        std::copy(bd_data_ptr, bd_data_ptr + max_bd_words, itr->second.begin());
       }
       else {
-        // not the first time patching, restore bd ptr values from patch info bd ptrs array
-        std::copy(item.bd_data_ptrs, item.bd_data_ptrs + max_bd_words, bd_data_ptr);
+        // not the first time patching, restore bd ptr values from buffer's patch state
+        std::copy(itr->second.begin(), itr->second.end(), bd_data_ptr);
       }
 
       switch (m_symbol_type) {
@@ -548,6 +552,7 @@ public:
   // Patch symbol in control code with patch value
   //
   // @param base - base address of control code buffer object
+  // @param state - original values of locations already patched in base
   // @param symbol - symbol name
   // @param index - argument index
   // @param patch - patch value
@@ -555,7 +560,7 @@ public:
   // @param sec_index - index of section to be patched
   // @Return true if symbol was patched, false otherwise
   virtual bool
-  patch_it(uint8_t*, const std::string&, size_t, uint64_t, patcher::buf_type, uint32_t)
+  patch_it(uint8_t*, patcher::patch_state&, const std::string&, size_t, uint64_t, patcher::buf_type, uint32_t)
   {
     throw std::runtime_error("Not supported");
   }
@@ -661,6 +666,7 @@ public:
 class module_elf : public module_impl
 {
 protected:
+  xrt::elf m_elf;              // keep elf alive while module refers to it
   const ELFIO::elfio& m_elfio; // we should not modify underlying elf
   uint8_t m_os_abi = Elf_Amd_Aie2p;
   std::map<std::string, patcher> m_arg2patcher;
@@ -673,14 +679,15 @@ protected:
 
   explicit module_elf(xrt::elf elf)
     : module_impl{ elf.get_cfg_uuid() }
-    , m_elfio(xrt_core::elf_int::get_elfio(elf))
+    , m_elf(elf)
+    , m_elfio(xrt_core::elf_int::get_elfio(m_elf))
     , m_os_abi(m_elfio.get_os_abi())
   {}
 
 public:
   bool
-  patch_it(uint8_t* base, const std::string& argnm, size_t index, uint64_t patch,
-           patcher::buf_type type, uint32_t sec_index) override
+  patch_it(uint8_t* base, patcher::patch_state& state, const std::string& argnm, size_t index,
+           uint64_t patch, patcher::buf_type type, uint32_t sec_index) override
   {
     const auto key_string = generate_key_string(argnm, type, sec_index);
     auto it = m_arg2patcher.find(key_string);
@@ -693,7 +700,7 @@ public:
         return false;
     }
 
-    it->second.patch_it(base, patch);
+    it->second.patch_it(base, patch, state);
     if (xrt_core::config::get_xrt_debug()) {
       if (not_found_use_argument_name) {
         std::stringstream ss;
@@ -1504,6 +1511,11 @@ class module_sram : public module_impl
   // Must match number of argument patchers in parent module
   std::set<std::string> m_patched_args;
 
+  // Original values of patched locations in this module's buffers.
+  // Kept here rather than in the parent's patchers, which are shared
+  // by every module created from the same ELF.
+  patcher::patch_state m_patch_state;
+
   // Dirty bit to indicate that patching was done prior to last
   // buffer sync to device.
   bool m_dirty{ false };
@@ -1799,18 +1811,18 @@ class module_sram : public module_impl
     if (m_parent->get_os_abi() == Elf_Amd_Aie2p || m_parent->get_os_abi() == Elf_Amd_Aie2p_config) {
       // patch control-packet buffer
       if (m_ctrlpkt_bo) {
-        if (m_parent->patch_it(m_ctrlpkt_bo.map<uint8_t*>(), argnm, index, value, patcher::buf_type::ctrldata, m_ctrlpkt_sec_idx))
+        if (m_parent->patch_it(m_ctrlpkt_bo.map<uint8_t*>(), m_patch_state, argnm, index, value, patcher::buf_type::ctrldata, m_ctrlpkt_sec_idx))
           patched = true;
       }
       // patch instruction buffer
-      if (m_parent->patch_it(m_instr_bo.map<uint8_t*>(), argnm, index, value, patcher::buf_type::ctrltext, m_instr_sec_idx))
+      if (m_parent->patch_it(m_instr_bo.map<uint8_t*>(), m_patch_state, argnm, index, value, patcher::buf_type::ctrltext, m_instr_sec_idx))
           patched = true;
     }
     else {
-      if (m_parent->patch_it(m_buffer.map<uint8_t*>(), argnm, index, value, patcher::buf_type::ctrltext, UINT32_MAX))
+      if (m_parent->patch_it(m_buffer.map<uint8_t*>(), m_patch_state, argnm, index, value, patcher::buf_type::ctrltext, UINT32_MAX))
         patched = true;
 
-      if (m_parent->patch_it(m_buffer.map<uint8_t*>(), argnm, index, value, patcher::buf_type::pad, UINT32_MAX))
+      if (m_parent->patch_it(m_buffer.map<uint8_t*>(), m_patch_state, argnm, index, value, patcher::buf_type::pad, UINT32_MAX))
         patched = true;
     }
 
@@ -1824,7 +1836,7 @@ class module_sram : public module_impl
   patch_instr_value(xrt::bo& bo, const std::string& argnm, size_t index, uint64_t value,
                     patcher::buf_type type, uint32_t sec_index)
   {
-    if (!m_parent->patch_it(bo.map<uint8_t*>(), argnm, index, value, type, sec_index))
+    if (!m_parent->patch_it(bo.map<uint8_t*>(), m_patch_state, argnm, index, value, type, sec_index))
       return false;
 
     m_dirty = true;
@@ -2285,8 +2297,9 @@ patch(const xrt::module& module, uint8_t* ibuf, size_t* sz, const std::vector<st
   std::memcpy(ibuf, inst->data(), *sz);
 
   size_t index = 0;
+  patcher::patch_state state;
   for (auto& [arg_name, arg_addr] : *args) {
-    if (!hdl->patch_it(ibuf, arg_name, index, arg_addr, patcher::buf_type::ctrltext, patch_index))
+    if (!hdl->patch_it(ibuf, state, arg_name, index, arg_addr, patcher::buf_type::ctrltext, patch_index))
       throw std::runtime_error{"Failed to patch " + arg_name};
     index++;
   }
@@ -2350,7 +2363,7 @@ dump_dtrace_buffer(const xrt::module& module)
 namespace
 {
 static std::shared_ptr<xrt::module_elf>
-construct_module_elf(const xrt::elf& elf)
+create_module_elf(const xrt::elf& elf)
 {
   auto os_abi = xrt_core::elf_int::get_elfio(elf).get_os_abi();
   switch (os_abi) {
@@ -2363,6 +2376,15 @@ construct_module_elf(const xrt::elf& elf)
     throw std::runtime_error("unknown ELF type passed\n");
   }
 }
+
+// Modules constructed from the same ELF share the parsed control
+// code and argument patchers, which are identical for all users.
+// Per hw context control code buffers are created by module_sram.
+static std::shared_ptr<xrt::module_impl>
+construct_module_elf(const xrt::elf& elf)
+{
+  return xrt_core::elf_int::get_module(elf, [&elf] { return create_module_elf(elf); });
+}
 }
 
 ////////////////////////////////////////////////////////////////
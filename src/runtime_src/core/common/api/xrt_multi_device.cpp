@@ -0,0 +1,388 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// This file implements XRT multi device APIs as declared in
+// core/include/experimental/xrt_multi_device.h
+#define XRT_API_SOURCE         // exporting xrt_multi_device.h
+#define XRT_CORE_COMMON_SOURCE // in same dll as coreutil
+#include "core/include/xrt/experimental/xrt_multi_device.h"
+#include "core/include/xrt/experimental/xrt_queue.h"
+#include "kernel_int.h"
+
+#include "core/common/error.h"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Slice size such that all slices but the last are of equal size and
+// aligned.  Every device must get a non-empty slice.
+size_t
+get_slice_size(size_t sz, size_t slices, size_t align)
+{
+  if (!slices)
+    throw xrt_core::error(EINVAL, "No devices to stripe buffer across");
+  if (!align)
+    throw xrt_core::error(EINVAL, "Stripe alignment must be a positive number");
+
+  auto slice_size = (sz + slices - 1) / slices;
+  slice_size = (slice_size + align - 1) / align * align;
+  if (slice_size * (slices - 1) >= sz)
+    throw xrt_core::error(EINVAL, "Buffer of size " + std::to_string(sz)
+                          + " is too small to stripe across " + std::to_string(slices) + " devices");
+  return slice_size;
+}
+
+} // namespace
+
+namespace xrt::ext {
+
+// class striped_bo_impl - one xrt::bo per device
+//
+// Operations on slices are executed concurrently, each slice but the
+// first is operated on by its own queue (worker thread), the first
+// slice is operated on by the calling thread.
+class striped_bo_impl
+{
+  size_t m_size;
+  size_t m_slice_size;
+  std::vector<xrt::bo> m_slices;
+  std::vector<xrt::queue> m_queues;
+
+  // Execute op(idx) for all slices concurrently, rethrow first error
+  template <typename Operation>
+  void
+  for_each_slice(Operation&& op)
+  {
+    std::vector<std::shared_future<void>> done;
+    done.reserve(m_queues.size());
+    for (size_t idx = 1; idx < m_slices.size(); ++idx)
+      done.push_back(m_queues[idx - 1].enqueue([&op, idx] { op(idx); }));
+
+    std::exception_ptr eptr;
+    try {
+      op(0);
+    }
+    catch (...) {
+      eptr = std::current_exception();
+    }
+
+    // wait for all slices before reporting error, op is referenced
+    for (auto& f : done) {
+      try {
+        f.get();
+      }
+      catch (...) {
+        if (!eptr)
+          eptr = std::current_exception();
+      }
+    }
+
+    if (eptr)
+      std::rethrow_exception(eptr);
+  }
+
+  size_t
+  length(size_t idx) const
+  {
+    return std::min(m_slice_size, m_size - idx * m_slice_size);
+  }
+
+public:
+  striped_bo_impl(const std::vector<xrt::device>& devices, size_t sz,
+                  const std::vector<xrt::memory_group>& grps, size_t align)
+    : m_size(sz)
+    , m_slice_size(get_slice_size(sz, devices.size(), align))
+    , m_queues(devices.size() - 1)
+  {
+    if (grps.size() != devices.size())
+      throw xrt_core::error(EINVAL, "Number of memory groups does not match number of devices");
+
+    m_slices.reserve(devices.size());
+    for (size_t idx = 0; idx < devices.size(); ++idx) {
+      m_slices.emplace_back(devices[idx], length(idx), xrt::bo::flags::normal, grps[idx]);
+    }
+  }
+
+  size_t
+  get_size() const
+  {
+    return m_size;
+  }
+
+  size_t
+  num_slices() const
+  {
+    return m_slices.size();
+  }
+
+  const xrt::bo&
+  slice(size_t idx) const
+  {
+    return m_slices.at(idx);
+  }
+
+  size_t
+  slice_offset(size_t idx) const
+  {
+    if (idx >= m_slices.size())
+      throw xrt_core::error(EINVAL, "Slice index out of range");
+    return idx * m_slice_size;
+  }
+
+  void
+  sync(xclBOSyncDirection dir)
+  {
+    for_each_slice([this, dir](size_t idx) { m_slices[idx].sync(dir); });
+  }
+
+  void
+  scatter(const void* src)
+  {
+    auto data = static_cast<const char*>(src);
+    for_each_slice([this, data](size_t idx) {
+      m_slices[idx].write(data + idx * m_slice_size, length(idx), 0);
+      m_slices[idx].sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    });
+  }
+
+  void
+  scatter(const xrt::bo& src)
+  {
+    if (src.size() < m_size)
+      throw xrt_core::error(EINVAL, "Source buffer is smaller than striped buffer");
+
+    // xrt::bo::copy imports buffers of other devices as needed
+    for_each_slice([this, &src](size_t idx) {
+      m_slices[idx].copy(src, length(idx), idx * m_slice_size, 0);
+    });
+  }
+
+  void
+  gather(void* dst)
+  {
+    auto data = static_cast<char*>(dst);
+    for_each_slice([this, data](size_t idx) {
+      m_slices[idx].sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+      m_slices[idx].read(data + idx * m_slice_size, length(idx), 0);
+    });
+  }
+
+  void
+  gather(xrt::bo& dst)
+  {
+    if (dst.size() < m_size)
+      throw xrt_core::error(EINVAL, "Destination buffer is smaller than striped buffer");
+
+    for_each_slice([this, &dst](size_t idx) {
+      dst.copy(m_slices[idx], length(idx), 0, idx * m_slice_size);
+    });
+  }
+};
+
+// class broadcast_run_impl - one xrt::run per kernel
+class broadcast_run_impl
+{
+  std::vector<xrt::run> m_runs;
+
+public:
+  explicit
+  broadcast_run_impl(const std::vector<xrt::kernel>& kernels)
+  {
+    if (kernels.empty())
+      throw xrt_core::error(EINVAL, "No kernels to broadcast run to");
+
+    m_runs.reserve(kernels.size());
+    for (const auto& kernel : kernels)
+      m_runs.emplace_back(kernel);
+  }
+
+  size_t
+  size() const
+  {
+    return m_runs.size();
+  }
+
+  xrt::run&
+  get_run(size_t idx)
+  {
+    return m_runs.at(idx);
+  }
+
+  void
+  set_arg(int index, const striped_bo& bo)
+  {
+    if (bo.num_slices() != m_runs.size())
+      throw xrt_core::error(EINVAL, "Number of slices does not match number of runs");
+
+    for (size_t idx = 0; idx < m_runs.size(); ++idx)
+      m_runs[idx].set_arg(index, bo.slice(idx));
+  }
+
+  void
+  start()
+  {
+    for (auto& run : m_runs)
+      run.start();
+  }
+
+  // Runs execute concurrently, waiting for them in order is no
+  // slower than waiting for them concurrently
+  ert_cmd_state
+  wait(const std::chrono::milliseconds& timeout)
+  {
+    auto result = ERT_CMD_STATE_COMPLETED;
+    for (auto& run : m_runs) {
+      auto state = run.wait(timeout);
+      if (state != ERT_CMD_STATE_COMPLETED && result == ERT_CMD_STATE_COMPLETED)
+        result = state;
+    }
+    return result;
+  }
+};
+
+} // xrt::ext
+
+////////////////////////////////////////////////////////////////
+// xrt_multi_device C++ API implementations (xrt_multi_device.h)
+////////////////////////////////////////////////////////////////
+namespace xrt::ext {
+
+striped_bo::
+striped_bo(const std::vector<xrt::device>& devices, size_t sz,
+           const std::vector<xrt::memory_group>& grps, size_t align)
+  : detail::pimpl<striped_bo_impl>(std::make_shared<striped_bo_impl>(devices, sz, grps, align))
+{}
+
+static std::vector<xrt::device>
+get_devices(const std::vector<xrt::kernel>& kernels)
+{
+  std::vector<xrt::device> devices;
+  devices.reserve(kernels.size());
+  for (const auto& kernel : kernels)
+    devices.push_back(xrt_core::kernel_int::get_hw_ctx(kernel).get_device());
+  return devices;
+}
+
+static std::vector<xrt::memory_group>
+get_groups(const std::vector<xrt::kernel>& kernels, int argidx)
+{
+  std::vector<xrt::memory_group> grps;
+  grps.reserve(kernels.size());
+  for (const auto& kernel : kernels)
+    grps.push_back(kernel.group_id(argidx));
+  return grps;
+}
+
+striped_bo::
+striped_bo(const std::vector<xrt::kernel>& kernels, int argidx, size_t sz, size_t align)
+  : striped_bo(get_devices(kernels), sz, get_groups(kernels, argidx), align)
+{}
+
+size_t
+striped_bo::
+size() const
+{
+  return handle->get_size();
+}
+
+size_t
+striped_bo::
+num_slices() const
+{
+  return handle->num_slices();
+}
+
+const xrt::bo&
+striped_bo::
+slice(size_t idx) const
+{
+  return handle->slice(idx);
+}
+
+size_t
+striped_bo::
+slice_offset(size_t idx) const
+{
+  return handle->slice_offset(idx);
+}
+
+void
+striped_bo::
+sync(xclBOSyncDirection dir)
+{
+  handle->sync(dir);
+}
+
+void
+striped_bo::
+scatter(const void* src)
+{
+  handle->scatter(src);
+}
+
+void
+striped_bo::
+scatter(const xrt::bo& src)
+{
+  handle->scatter(src);
+}
+
+void
+striped_bo::
+gather(void* dst)
+{
+  handle->gather(dst);
+}
+
+void
+striped_bo::
+gather(xrt::bo& dst)
+{
+  handle->gather(dst);
+}
+
+broadcast_run::
+broadcast_run(const std::vector<xrt::kernel>& kernels)
+  : detail::pimpl<broadcast_run_impl>(std::make_shared<broadcast_run_impl>(kernels))
+{}
+
+size_t
+broadcast_run::
+size() const
+{
+  return handle->size();
+}
+
+xrt::run&
+broadcast_run::
+get_run(size_t idx)
+{
+  return handle->get_run(idx);
+}
+
+void
+broadcast_run::
+set_arg(int index, const striped_bo& bo)
+{
+  handle->set_arg(index, bo);
+}
+
+void
+broadcast_run::
+start()
+{
+  handle->start();
+}
+
+ert_cmd_state
+broadcast_run::
+wait(const std::chrono::milliseconds& timeout)
+{
+  return handle->wait(timeout);
+}
+
+} // xrt::ext
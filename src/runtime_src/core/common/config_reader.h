@@ -138,6 +138,15 @@ get_device_trace()
   return value;
 }
 
+// Format of device trace files, "csv" or "columnar" (binary, converted
+// back to csv on demand)
+inline std::string
+get_device_trace_format()
+{
+  static std::string value = detail::get_string_value("Debug.device_trace_format", "csv");
+  return value;
+}
+
 inline std::string
 get_profiling_directory()
 {
@@ -233,6 +242,13 @@ get_trace_file_dump_interval_s()
   return value;
 }
 
+inline unsigned int
+get_trace_decode_threads()
+{
+  static unsigned int value = detail::get_uint_value("Debug.trace_decode_threads", 0);
+  return value;
+}
+
 inline std::string
 get_trace_buffer_size()
 {
@@ -308,6 +324,23 @@ get_native_xrt_trace()
   return value;
 }
 
+// Record only start and end time of native XRT API calls into per
+// thread buffers, dumped to native_xrt_timestamps.csv at exit
+inline bool
+get_native_xrt_timestamps()
+{
+  static bool value = detail::get_bool_value("Debug.native_xrt_timestamps", false);
+  return value;
+}
+
+// Number of calls retained per thread in timestamp only mode
+inline unsigned int
+get_native_xrt_timestamps_buffer()
+{
+  static unsigned int value = detail::get_uint_value("Debug.native_xrt_timestamps_buffer", 65536);
+  return value;
+}
+
 inline bool
 get_opencl_trace()
 {
@@ -386,6 +419,61 @@ get_usage_metrics_logging()
   return value;
 }
 
+/**
+ * Record per kernel latency histograms of run submission, execution,
+ * and completion notification (see core/common/latency.h)
+ */
+inline bool
+get_latency_histograms()
+{
+  static bool value = detail::get_bool_value("Runtime.latency_histograms", false);
+  return value;
+}
+
+/**
+ * Signal number on which latency histograms are appended to
+ * xrt_latency_<pid>.txt, 0 disables
+ */
+inline unsigned int
+get_latency_histograms_signal()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.latency_histograms_signal", 0);
+  return value;
+}
+
+/**
+ * Print time spent in startup phases (shim and driver plugin loading,
+ * device enumeration) to stderr at process exit
+ */
+inline bool
+get_startup_timing()
+{
+  static bool value = detail::get_bool_value("Runtime.startup_timing", false);
+  return value;
+}
+
+/**
+ * Share parsed ELF data and ELF modules between xrt::elf objects
+ * constructed from identical ELF content
+ */
+inline bool
+get_elf_cache()
+{
+  static bool value = detail::get_bool_value("Runtime.elf_cache", true);
+  return value;
+}
+
+/**
+ * Publish live usage metrics counters in a per process shared memory
+ * segment (/dev/shm/xrt_usage_metrics.<pid>) for polling by tools
+ */
+inline bool
+get_usage_metrics_shm()
+{
+  static bool value = detail::get_bool_value("Runtime.usage_metrics_shm", false);
+  return value;
+}
+
 inline unsigned int
 get_verbosity()
 {
@@ -547,6 +635,51 @@ get_ert_slotsize()
   return value;
 }
 
+/**
+ * Number of OpenCL NDRange workgroups kept in flight per compute unit
+ * with pre-encoded run objects.  0 dispatches workgroups one at a time
+ * from completion of previous workgroups.
+ */
+inline unsigned int
+get_ocl_workgroup_batch()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.ocl_workgroup_batch",0);
+  return value;
+}
+
+/**
+ * Max size in MB of released OpenCL staging buffers kept for reuse.
+ * Staging buffers back device buffers created from unaligned host
+ * pointers.
+ */
+inline unsigned int
+get_ocl_staging_pool_mb()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.ocl_staging_pool_mb",256);
+  return value;
+}
+
+/**
+ * Chunk size in KB for overlapping copy of unaligned host pointer
+ * data with DMA.
+ */
+inline unsigned int
+get_ocl_staging_chunk_kb()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.ocl_staging_chunk_kb",4096);
+  return value;
+}
+
+/**
+ * Print OpenCL staging buffer statistics at exit
+ */
+inline bool
+get_ocl_staging_stats()
+{
+  static bool value = detail::get_bool_value("Runtime.ocl_staging_stats",false);
+  return value;
+}
+
 inline bool
 get_cdma()
 {
@@ -600,6 +733,109 @@ get_noop_completion_delay_us()
   return delay;
 }
 
+/**
+ * Per CU service time model of the noop shim, comma separated list of
+ * <cu name or index>=<distribution> with '*' matching any CU, e.g.
+ * "vadd_1=uniform:5:15,2=exp:20,*=const:10".  Distributions in us are
+ * const:<t>, uniform:<min>:<max>, exp:<mean> and normal:<mean>:<stddev>.
+ */
+inline std::string
+get_noop_cu_service_time()
+{
+  static std::string value = detail::get_string_value("Runtime.noop_cu_service_time", "");
+  return value;
+}
+
+/**
+ * Number of CUs the noop shim executes concurrently, 0 is unlimited
+ */
+inline unsigned int
+get_noop_concurrent_cus()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_concurrent_cus", 0);
+  return value;
+}
+
+/**
+ * DMA model of noop shim sync_bo, bandwidth in MB/s (0 is infinite)
+ * and fixed latency per transfer
+ */
+inline unsigned int
+get_noop_dma_bandwidth_mbps()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_dma_bandwidth_mbps", 0);
+  return value;
+}
+
+inline unsigned int
+get_noop_dma_latency_us()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_dma_latency_us", 0);
+  return value;
+}
+
+/**
+ * Seed for noop shim service time distributions, runs with same seed
+ * and same submission order produce same service times
+ */
+inline unsigned int
+get_noop_seed()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_seed", 0);
+  return value;
+}
+
+/**
+ * File the noop shim writes its command and DMA event log to at exit
+ */
+inline std::string
+get_noop_event_log()
+{
+  static std::string value = detail::get_string_value("Runtime.noop_event_log", "");
+  return value;
+}
+
+/**
+ * Emulate a device side m2m copy engine in the noop and sw_emu shims
+ * such that xrt::bo::copy and xrt::bo::async_copy copy device side
+ * rather than through host buffers.  The noop shim models the engine
+ * with the Runtime.noop_dma_* latency and bandwidth.
+ */
+inline bool
+get_emulate_m2m()
+{
+  static bool value = detail::get_bool_value("Runtime.emulate_m2m", false);
+  return value;
+}
+
+/**
+ * Host side scheduling of commands by priority class (xrt::run::priority).
+ * Comma separated list of <class>=<limit> where class is high, normal,
+ * or low.
+ *
+ * hw_queue_qos_depth: commands of a class are held back while the
+ * number of commands in flight on the hw queue is at or above the
+ * limit, e.g. "normal=32,low=8".
+ *
+ * hw_queue_qos_rate: token bucket rate limit of a class in commands
+ * per second with optional burst size, e.g. "low=1000:16".
+ *
+ * Scheduling is enabled when either value is specified.
+ */
+inline std::string
+get_hw_queue_qos_depth()
+{
+  static std::string value = detail::get_string_value("Runtime.hw_queue_qos_depth", "");
+  return value;
+}
+
+inline std::string
+get_hw_queue_qos_rate()
+{
+  static std::string value = detail::get_string_value("Runtime.hw_queue_qos_rate", "");
+  return value;
+}
+
 /**
  * Set CMD BO cache size. CUrrently it is only used in xclCopyBO()
  */
@@ -0,0 +1,265 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE
+#include "latency.h"
+
+#include "core/common/config_reader.h"
+#include "core/common/message.h"
+#include "core/common/utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+// Reference point for converting ticks to nanoseconds.  Captured when
+// latency recording is initialized, the conversion ratio is computed
+// over the interval since then.
+struct tick_reference
+{
+  uint64_t ticks = xrt_core::latency::ticks();
+  clock::time_point time = clock::now();
+};
+
+static const tick_reference&
+get_tick_reference()
+{
+  static tick_reference ref;
+  return ref;
+}
+
+// Nanoseconds per tick
+static double
+get_tick_period()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  const auto& ref = get_tick_reference();
+
+  // Make sure the interval is long enough for an accurate ratio
+  constexpr auto min_interval = std::chrono::milliseconds(10);
+  while (clock::now() - ref.time < min_interval)
+    std::this_thread::yield();
+
+  auto ticks = xrt_core::latency::ticks();
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - ref.time).count();
+  return static_cast<double>(ns) / static_cast<double>(ticks - ref.ticks);
+#else
+  return 1.0;
+#endif
+}
+
+// Registry of kernel statistics by kernel name
+static std::mutex s_mutex;
+static std::map<std::string, std::shared_ptr<xrt_core::latency::kernel_stats>> s_kernels;
+
+static const char*
+phase_name(size_t ph)
+{
+  static const char* names[xrt_core::latency::num_phases] = {"submit", "execute", "notify"};
+  return names[ph];
+}
+
+#ifndef _WIN32
+// Dump of report on signal.  The signal handler writes to a pipe,
+// which is async signal safe, and a dump thread blocked on reading
+// the pipe writes the report to xrt_latency_<pid>.txt.
+static int s_dump_pipe[2] = {-1, -1};
+
+extern "C" void
+dump_signal_handler(int)
+{
+  char c = 0;
+  auto ret = write(s_dump_pipe[1], &c, 1);
+  (void)ret;
+}
+
+static void
+dump_loop()
+{
+  char c = 0;
+  while (read(s_dump_pipe[0], &c, 1) > 0) {
+    try {
+      auto file = "xrt_latency_" + std::to_string(xrt_core::utils::get_pid()) + ".txt";
+      std::ofstream ofs(file, std::ios::app);
+      ofs << xrt_core::latency::report() << "\n";
+    }
+    catch (...) {
+    }
+  }
+}
+
+static void
+install_dump_signal(int signum)
+{
+  if (pipe(s_dump_pipe) != 0) {
+    xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                            "Failed to install latency histogram dump signal handler");
+    return;
+  }
+
+  std::thread(dump_loop).detach();
+  std::signal(signum, dump_signal_handler);
+}
+#endif
+
+static bool
+init()
+{
+  if (!xrt_core::config::get_latency_histograms())
+    return false;
+
+  get_tick_reference();
+
+#ifndef _WIN32
+  if (auto signum = xrt_core::config::get_latency_histograms_signal())
+    install_dump_signal(static_cast<int>(signum));
+#endif
+
+  return true;
+}
+
+} // namespace
+
+namespace xrt_core::latency {
+
+uint64_t
+to_ns(uint64_t ticks)
+{
+  static double period = get_tick_period();
+  return static_cast<uint64_t>(std::llround(static_cast<double>(ticks) * period));
+}
+
+void
+histogram::
+reset()
+{
+  for (auto& bucket : m_buckets)
+    bucket.store(0, std::memory_order_relaxed);
+  m_count.store(0, std::memory_order_relaxed);
+  m_sum.store(0, std::memory_order_relaxed);
+  m_min.store(UINT64_MAX, std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t
+histogram::
+percentile(double pct) const
+{
+  // Bucket counts are read without synchronization with concurrent
+  // recording, so the total is computed from the buckets themselves
+  std::array<uint64_t, num_buckets> counts;
+  uint64_t total = 0;
+  for (unsigned int idx = 0; idx < num_buckets; ++idx)
+    total += counts[idx] = m_buckets[idx].load(std::memory_order_relaxed);
+
+  if (!total)
+    return 0;
+
+  auto rank = static_cast<uint64_t>(std::ceil(pct / 100.0 * static_cast<double>(total)));
+  rank = std::clamp<uint64_t>(rank, 1, total);
+
+  uint64_t seen = 0;
+  for (unsigned int idx = 0; idx < num_buckets; ++idx) {
+    seen += counts[idx];
+    if (seen >= rank) {
+      // Report the middle of the bucket bounded by recorded extremes
+      auto low = bucket_value(idx);
+      auto high = (idx + 1 < num_buckets) ? bucket_value(idx + 1) : UINT64_MAX;
+      auto value = low + (high - low) / 2;
+      return std::clamp(value, m_min.load(std::memory_order_relaxed), m_max.load(std::memory_order_relaxed));
+    }
+  }
+
+  return m_max.load(std::memory_order_relaxed);
+}
+
+histogram::summary
+histogram::
+get_summary() const
+{
+  summary sum;
+  sum.count = m_count.load(std::memory_order_relaxed);
+  if (!sum.count)
+    return sum;
+
+  sum.min_ns = to_ns(m_min.load(std::memory_order_relaxed));
+  sum.max_ns = to_ns(m_max.load(std::memory_order_relaxed));
+  sum.mean_ns = to_ns(m_sum.load(std::memory_order_relaxed) / sum.count);
+  sum.p50_ns = to_ns(percentile(50));
+  sum.p90_ns = to_ns(percentile(90));
+  sum.p99_ns = to_ns(percentile(99));
+  sum.p999_ns = to_ns(percentile(99.9));
+  return sum;
+}
+
+bool
+enabled()
+{
+  static bool value = init();
+  return value;
+}
+
+std::shared_ptr<kernel_stats>
+get_kernel_stats(const std::string& name)
+{
+  if (!enabled())
+    return nullptr;
+
+  std::lock_guard lk(s_mutex);
+  auto& stats = s_kernels[name];
+  if (!stats)
+    stats = std::make_shared<kernel_stats>(name);
+  return stats;
+}
+
+std::vector<std::shared_ptr<kernel_stats>>
+get_all_kernel_stats()
+{
+  std::vector<std::shared_ptr<kernel_stats>> all;
+  std::lock_guard lk(s_mutex);
+  all.reserve(s_kernels.size());
+  for (const auto& entry : s_kernels)
+    all.push_back(entry.second);
+  return all;
+}
+
+void
+reset()
+{
+  for (const auto& stats : get_all_kernel_stats())
+    for (auto& hist : stats->phases)
+      hist.reset();
+}
+
+std::string
+report()
+{
+  std::ostringstream os;
+  os << "kernel,phase,count,min_ns,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n";
+  for (const auto& stats : get_all_kernel_stats()) {
+    for (size_t ph = 0; ph < num_phases; ++ph) {
+      auto sum = stats->phases[ph].get_summary();
+      if (!sum.count)
+        continue;
+      os << stats->name << ',' << phase_name(ph) << ',' << sum.count
+         << ',' << sum.min_ns << ',' << sum.mean_ns << ',' << sum.p50_ns
+         << ',' << sum.p90_ns << ',' << sum.p99_ns << ',' << sum.p999_ns
+         << ',' << sum.max_ns << '\n';
+    }
+  }
+  return os.str();
+}
+
+} // xrt_core::latency
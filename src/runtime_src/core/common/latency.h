@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_CORE_LATENCY_H
+#define XRT_CORE_LATENCY_H
+
+#include "core/common/config.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+# ifdef _WIN32
+#  include <intrin.h>
+# else
+#  include <x86intrin.h>
+# endif
+#endif
+
+////////////////////////////////////////////////////////////////
+// namespace xrt_core::latency
+//
+// Per kernel latency histograms of run execution.  Each run records
+// three phases from the host's point of view:
+//
+//  submit:  xrt::run::start() until the command is handed to the driver
+//  execute: command handed to driver until completion is observed
+//  notify:  completion observed until the waiting thread returns
+//
+// Recording is enabled using xrt.ini
+//
+// % cat xrt.ini
+// [Runtime]
+// latency_histograms = true
+// latency_histograms_signal = 12   # dump on SIGUSR2
+////////////////////////////////////////////////////////////////
+namespace xrt_core::latency {
+
+enum class phase { submit, execute, notify };
+constexpr size_t num_phases = 3;
+
+// ticks() - Cheap timestamp
+//
+// Time stamp counter where available, otherwise steady clock
+// nanoseconds.  Use to_ns() to convert differences in ticks.
+inline uint64_t
+ticks()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>
+    (std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Convert ticks to nanoseconds
+XRT_CORE_COMMON_EXPORT
+uint64_t
+to_ns(uint64_t ticks);
+
+// class histogram - HDR style histogram of tick counts
+//
+// Log linear buckets, 16 linear sub buckets per power of 2, give a
+// relative error of at most 1/16 over the full 64 bit range.  Values
+// are recorded lock free with relaxed atomics.
+class histogram
+{
+public:
+  static constexpr unsigned int sub_bits = 4;
+  static constexpr unsigned int sub_buckets = 1u << sub_bits;
+  static constexpr unsigned int num_buckets = (64 - sub_bits + 1) * sub_buckets;
+
+  struct summary
+  {
+    uint64_t count = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t mean_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+  };
+
+private:
+  std::array<std::atomic<uint64_t>, num_buckets> m_buckets {};
+  std::atomic<uint64_t> m_count {0};
+  std::atomic<uint64_t> m_sum {0};
+  std::atomic<uint64_t> m_min {UINT64_MAX};
+  std::atomic<uint64_t> m_max {0};
+
+  static unsigned int
+  msb(uint64_t value)
+  {
+    unsigned int bit = 0;
+    while (value >>= 1)
+      ++bit;
+    return bit;
+  }
+
+public:
+  static unsigned int
+  bucket_index(uint64_t value)
+  {
+    if (value < sub_buckets)
+      return static_cast<unsigned int>(value);
+    auto shift = msb(value) - sub_bits;
+    return (shift + 1) * sub_buckets + static_cast<unsigned int>((value >> shift) & (sub_buckets - 1));
+  }
+
+  // Lowest value recorded in bucket
+  static uint64_t
+  bucket_value(unsigned int idx)
+  {
+    if (idx < sub_buckets)
+      return idx;
+    auto shift = idx / sub_buckets - 1;
+    return static_cast<uint64_t>(sub_buckets + idx % sub_buckets) << shift;
+  }
+
+  void
+  record(uint64_t value)
+  {
+    m_buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto min = m_min.load(std::memory_order_relaxed);
+    while (value < min && !m_min.compare_exchange_weak(min, value, std::memory_order_relaxed)) {}
+    auto max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+  }
+
+  void
+  reset();
+
+  // Value in ticks at percentile (0-100) of recorded values
+  uint64_t
+  percentile(double pct) const;
+
+  // Summary in nanoseconds
+  summary
+  get_summary() const;
+};
+
+// struct kernel_stats - latency histograms of one kernel
+struct kernel_stats
+{
+  std::string name;
+  std::array<histogram, num_phases> phases;
+
+  explicit
+  kernel_stats(std::string nm)
+    : name(std::move(nm))
+  {}
+
+  void
+  record(phase ph, uint64_t ticks)
+  {
+    phases[static_cast<size_t>(ph)].record(ticks);
+  }
+};
+
+// Check if latency recording is enabled in xrt.ini
+XRT_CORE_COMMON_EXPORT
+bool
+enabled();
+
+// Get (create) the statistics of a kernel by name.  Returns nullptr
+// if latency recording is disabled.  The statistics live until
+// program exit.
+XRT_CORE_COMMON_EXPORT
+std::shared_ptr<kernel_stats>
+get_kernel_stats(const std::string& name);
+
+// Get statistics of all kernels
+XRT_CORE_COMMON_EXPORT
+std::vector<std::shared_ptr<kernel_stats>>
+get_all_kernel_stats();
+
+// Reset statistics of all kernels
+XRT_CORE_COMMON_EXPORT
+void
+reset();
+
+// Text report with a summary line per kernel and phase
+XRT_CORE_COMMON_EXPORT
+std::string
+report();
+
+} // xrt_core::latency
+
+#endif
@@ -20,6 +20,10 @@
 #include "memaccess.h"
 
 // System includes
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <future>
 #include <iostream>
 #include <numeric>
 #include <vector>
@@ -126,10 +130,20 @@ enum class operation_type {
   write
 };
 
+// Contiguous range of device memory within one bank
+struct mem_segment
+{
+  uint64_t m_address;  // device address
+  uint64_t m_size;     // bytes in this bank
+  uint64_t m_offset;   // offset relative to start of memory operation
+  std::string m_tag;
+};
+
 // Ensure safe access into a device's memory banks based on memory
-// bank boundary and if the bank is in use
-static void 
-perform_memory_action(xrt_core::device* device, xrt_core::aligned_ptr_type& buf, const uint64_t start_addr, const uint64_t size, operation_type action)
+// bank boundary and if the bank is in use.  Split the memory
+// operation into one segment per bank.
+static std::vector<mem_segment>
+get_memory_segments(xrt_core::device* device, const uint64_t start_addr, const uint64_t size, operation_type action)
 {
   auto vec_banks = get_ddr_banks(device);
   auto validated_start_addr = get_starting_address(vec_banks, start_addr);
@@ -147,11 +161,12 @@ perform_memory_action(xrt_core::device* device, xrt_core::aligned_ptr_type& buf,
   if ((size == 0) && (action == operation_type::read))
     validated_size = available_size;
 
+  std::vector<mem_segment> segments;
   uint64_t current_addr = validated_start_addr;
-  size_t remaining_bytes_to_see = size;
-  size_t bytes_seen = 0;
+  uint64_t remaining_bytes_to_see = validated_size;
+  uint64_t bytes_seen = 0;
 
-  // continue to operate as long as there are bytes left to see or we run out of banks
+  // continue as long as there are bytes left to see or we run out of banks
   for (auto it = start_bank; (it != vec_banks.end()) && (remaining_bytes_to_see > 0); ++it) {
     // Validate the amount of memory the current memory bank has
     uint64_t available_bank_size = 0;
@@ -159,42 +174,107 @@ perform_memory_action(xrt_core::device* device, xrt_core::aligned_ptr_type& buf,
       current_addr = it->m_base_address;
       available_bank_size = it->m_size;
     }
-    else 
+    else
       available_bank_size = it->m_size - (current_addr - it->m_base_address);
 
-    // If the available bank size is less than the source buffer see what bytes we are able to and move to the next bank
-    uint64_t bytes_to_edit = std::min(available_bank_size, validated_size);
+    // If the available bank size is less than the remaining bytes, see what
+    // bytes we are able to and move to the next bank
+    uint64_t bytes_to_edit = std::min(available_bank_size, remaining_bytes_to_see);
+    if (bytes_to_edit)
+      segments.push_back({current_addr, bytes_to_edit, bytes_seen, it->m_tag});
+
+    remaining_bytes_to_see -= bytes_to_edit;
+    bytes_seen += bytes_to_edit;
+  }
 
-    // Update the buffer index based on how far we have read
-    void* current_buffer_location = static_cast<char *>(buf.get()) + bytes_seen;
+  if (remaining_bytes_to_see > 0) {
+    auto err_msg = boost::format("Warning: Saw %llu bytes. Requested %llu bytes") % bytes_seen % validated_size;
+    throw std::runtime_error(err_msg.str());
+  }
+
+  return segments;
+}
+
+// Transfer one segment in chunks.  Chunks after the first are
+// aligned to chunk size in device address space.
+static void
+transfer_segment(xrt_core::device* device, const mem_segment& segment, size_t chunk_size, operation_type action,
+                 const xrt_core::mem_read_sink& sink, const xrt_core::mem_write_source& source)
+{
+  auto buf = xrt_core::aligned_alloc(xrt_core::getpagesize(), chunk_size);
+  if (!buf)
+    throw std::runtime_error("transfer_segment: Failed to allocate aligned buffer");
+
+  auto ptr = static_cast<char*>(buf.get());
+  uint64_t done = 0;
+  while (done < segment.m_size) {
+    auto addr = segment.m_address + done;
+    auto bytes = std::min<uint64_t>(chunk_size - (addr % chunk_size), segment.m_size - done);
     boost::format err_fmt("%s: Code : %d - %s %u bytes from %s(0x%x)");
     err_fmt % __func__;
     switch (action) {
       case operation_type::read:
         try {
-          device->unmgd_pread(current_buffer_location, bytes_to_edit, validated_start_addr);
+          device->unmgd_pread(ptr, bytes, addr);
         } catch (const std::exception&) {
-          const auto err_msg = err_fmt % errno % "reading" % bytes_to_edit % it->m_tag % current_addr;
+          const auto err_msg = err_fmt % errno % "reading" % bytes % segment.m_tag % addr;
           throw xrt_core::error(std::errc::operation_canceled, err_msg.str());
         }
+        sink(segment.m_offset + done, ptr, bytes);
         break;
       case operation_type::write:
+        source(segment.m_offset + done, ptr, bytes);
         try {
-          device->unmgd_pwrite(current_buffer_location, bytes_to_edit, validated_start_addr);
+          device->unmgd_pwrite(ptr, bytes, addr);
         } catch (const std::exception&) {
-          const auto err_msg = err_fmt % errno % "writing" % bytes_to_edit % it->m_tag % current_addr;
+          const auto err_msg = err_fmt % errno % "writing" % bytes % segment.m_tag % addr;
           throw xrt_core::error(std::errc::operation_canceled, err_msg.str());
         }
         break;
     }
-    remaining_bytes_to_see -= bytes_to_edit;
-    bytes_seen += bytes_to_edit;
+    done += bytes;
   }
+}
 
-  if (remaining_bytes_to_see > 0) {
-    auto err_msg = boost::format("Warning: Saw %llu bytes. Requested %llu bytes") % bytes_seen % size;
-    throw std::runtime_error(err_msg.str());
+// Transfer all segments of a memory operation, one thread per bank
+static xrt_core::mem_access_stats
+perform_memory_action(xrt_core::device* device, const uint64_t start_addr, const uint64_t size, size_t chunk_size,
+                      operation_type action, const xrt_core::mem_read_sink& sink, const xrt_core::mem_write_source& source)
+{
+  if (chunk_size == 0)
+    throw xrt_core::error(std::errc::invalid_argument, "Memory access chunk size must be greater than 0");
+
+  auto segments = get_memory_segments(device, start_addr, size, action);
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(segments.size());
+  for (const auto& segment : segments)
+    futures.push_back(std::async(segments.size() > 1 ? std::launch::async : std::launch::deferred,
+                                 transfer_segment, device, std::cref(segment), chunk_size, action,
+                                 std::cref(sink), std::cref(source)));
+
+  // Wait for all banks before propagating first error, the
+  // segments are referenced by the transfers
+  std::exception_ptr eptr;
+  for (auto& future : futures) {
+    try {
+      future.get();
+    }
+    catch (...) {
+      if (!eptr)
+        eptr = std::current_exception();
+    }
   }
+  if (eptr)
+    std::rethrow_exception(eptr);
+
+  xrt_core::mem_access_stats stats;
+  stats.duration = std::chrono::steady_clock::now() - start;
+  stats.banks = static_cast<unsigned int>(segments.size());
+  for (const auto& segment : segments)
+    stats.bytes += segment.m_size;
+  return stats;
 }
 
 } // Empty namespace
@@ -204,32 +284,41 @@ namespace xrt_core {
 std::vector<char>
 device_mem_read(device* device, const uint64_t start_addr, const uint64_t size)
 {
-  // Allocate a buffer to hold the read data
-  auto buf = xrt_core::aligned_alloc(xrt_core::getpagesize(), size);
-  if (!buf)
-    throw std::runtime_error("read_banks: Failed to allocate aligned buffer");
-  std::memset(buf.get(), 0, size);
-
-  // Read from the device
-  perform_memory_action(device, buf, start_addr, size, operation_type::read);
-
-  // Format the read data into the return object
   std::vector<char> data(size);
-  std::memcpy(data.data(), buf.get(), data.size());
+  if (size == 0)
+    return data;
+
+  device_mem_read(device, start_addr, size,
+    [&data](uint64_t offset, const char* buf, size_t bytes) {
+      std::memcpy(data.data() + offset, buf, bytes);
+    });
   return data;
 }
 
 void
-device_mem_write(device* device, const uint64_t start_addr, const std::vector<char>& src) 
+device_mem_write(device* device, const uint64_t start_addr, const std::vector<char>& src)
 {
-  // Prepare the data to write
-  auto buf = xrt_core::aligned_alloc(xrt_core::getpagesize(), src.size());
-  if (!buf)
-    throw std::runtime_error("write_banks: Failed to allocate aligned buffer");
-  std::memcpy(buf.get(), src.data(), src.size());
+  if (src.empty())
+    return;
+
+  device_mem_write(device, start_addr, src.size(),
+    [&src](uint64_t offset, char* buf, size_t bytes) {
+      std::memcpy(buf, src.data() + offset, bytes);
+    });
+}
 
-  // Write to the device
-  perform_memory_action(device, buf, start_addr, src.size(), operation_type::write);
+mem_access_stats
+device_mem_read(device* device, uint64_t start_addr, uint64_t size,
+                const mem_read_sink& sink, size_t chunk_size)
+{
+  return perform_memory_action(device, start_addr, size, chunk_size, operation_type::read, sink, nullptr);
+}
+
+mem_access_stats
+device_mem_write(device* device, uint64_t start_addr, uint64_t size,
+                 const mem_write_source& source, size_t chunk_size)
+{
+  return perform_memory_action(device, start_addr, size, chunk_size, operation_type::write, nullptr, source);
 }
 
 } // xrt_core namespace
@@ -23,9 +23,43 @@
 #include "core/common/device.h"
 
 // System includes
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 namespace xrt_core {
 
+// Callback receiving data read from device memory.  The offset is
+// relative to the start of the read.  The sink is called
+// concurrently for different memory banks, but never concurrently
+// for the same bank.
+using mem_read_sink = std::function<void(uint64_t offset, const char* data, size_t size)>;
+
+// Callback providing data to write to device memory.  The offset is
+// relative to the start of the write.  Same concurrency as for the
+// read sink.
+using mem_write_source = std::function<void(uint64_t offset, char* data, size_t size)>;
+
+// Default size of chunks transferred between host and device
+constexpr size_t mem_access_chunk_size = 4 * 1024 * 1024;
+
+// Statistics of a streaming memory access
+struct mem_access_stats
+{
+  uint64_t bytes = 0;                      // bytes transferred
+  unsigned int banks = 0;                  // number of banks accessed
+  std::chrono::nanoseconds duration {0};   // wall time of access
+
+  // Throughput in MB/s
+  double
+  throughput() const
+  {
+    auto sec = std::chrono::duration<double>(duration).count();
+    return sec > 0 ? bytes / sec / (1024 * 1024) : 0;
+  }
+};
+
 // This function safely reads from a device's memory banks. It will
 // ensure that the read attempts start/end on memory bank borders
 // when applicable. This prevents reading from an unused bank or
@@ -43,6 +77,23 @@ device_mem_read(device* device, const uint64_t start_addr, const uint64_t size);
 XRT_CORE_COMMON_EXPORT
 void
 device_mem_write(device* device, const uint64_t start_addr, const std::vector<char>& src);
+
+// Streaming read of device memory.  Same bank validation as above,
+// but data is read in chunks aligned to chunk_size and passed to the
+// sink as it is read, so host memory use is bounded by one chunk per
+// bank.  Banks are read concurrently.  A size of 0 reads all memory
+// from start address.
+XRT_CORE_COMMON_EXPORT
+mem_access_stats
+device_mem_read(device* device, uint64_t start_addr, uint64_t size,
+                const mem_read_sink& sink, size_t chunk_size = mem_access_chunk_size);
+
+// Streaming write of device memory.  Data to write is requested from
+// the source one chunk at a time.  Banks are written concurrently.
+XRT_CORE_COMMON_EXPORT
+mem_access_stats
+device_mem_write(device* device, uint64_t start_addr, uint64_t size,
+                 const mem_write_source& source, size_t chunk_size = mem_access_chunk_size);
 }
 
 #endif /* MEMACCESS_H */
@@ -7,6 +7,7 @@
 
 #include "core/common/dlfcn.h"
 #include "core/common/config_reader.h"
+#include "core/common/startup_timing.h"
 #include "detail/xilinx_xrt.h"
 
 #include <cstdlib>
@@ -217,9 +218,9 @@ driver_plugin_paths()
 }
 
 static void*
-load_library(const std::string& path)
+load_library(const std::string& path, int flags = RTLD_NOW | RTLD_GLOBAL)
 {
-  if (auto handle = xrt_core::dlopen(path.c_str(), RTLD_NOW | RTLD_GLOBAL))
+  if (auto handle = xrt_core::dlopen(path.c_str(), flags))
     return handle;
 
   throw std::runtime_error("Failed to open library '" + path + "'\n" + xrt_core::dlerror());
@@ -241,8 +242,13 @@ module_loader(const std::string& module_name,
     if (error_function()) 
       return;
 
+  xrt_core::startup_timing::scope timer("load plugin " + module_name);
+
+  // Plugin modules bind function symbols on first use.  A plugin
+  // exports many more entry points than are called by the loading
+  // process, so binding all at load time is wasted startup time.
   auto path = module_path(module_name);
-  auto handle = load_library(path.string());
+  auto handle = load_library(path.string(), RTLD_LAZY | RTLD_GLOBAL);
 
   // Do the plugin specific functionality
   if (register_function)
@@ -266,10 +272,11 @@ shim_loader()
 driver_loader::
 driver_loader()
 {
+  xrt_core::startup_timing::scope timer("load driver plugins");
   auto paths = driver_plugin_paths();
 
   for (const auto& p : paths)
-    load_library(p);
+    load_library(p, RTLD_LAZY | RTLD_GLOBAL);
 }
 
 namespace environment {
@@ -4,6 +4,11 @@
 #ifndef XRT_CORE_GRAPH_HANDLE_H
 #define XRT_CORE_GRAPH_HANDLE_H
 
+#include "core/common/error.h"
+
+#include <cstddef>
+#include <cstdint>
+
 namespace xrt_core {
 class graph_handle
 {
@@ -39,6 +44,52 @@ public:
 
   virtual void
   read_graph_rtp(const char* port, char* buffer, size_t size) = 0;
+
+  // Resolve an RTP port once so repeated updates and reads skip the
+  // port name lookup.  The returned handle is owned by the graph
+  // handle and valid for its lifetime.  Shims that do not support
+  // resolved ports return nullptr and are called by port name.
+  virtual void*
+  resolve_graph_rtp(const char* /*port*/)
+  {
+    return nullptr;
+  }
+
+  virtual void
+  update_resolved_graph_rtp(void* /*rtp*/, const char* /*buffer*/, size_t /*size*/)
+  {
+    throw xrt_core::error(std::errc::not_supported, __func__);
+  }
+
+  virtual void
+  read_resolved_graph_rtp(void* /*rtp*/, char* /*buffer*/, size_t /*size*/)
+  {
+    throw xrt_core::error(std::errc::not_supported, __func__);
+  }
+
+  // One RTP write of a batch, rtp is the resolved handle or nullptr
+  // in which case the port is updated by name
+  struct rtp_update
+  {
+    void* rtp;
+    const char* port;
+    const char* buffer;
+    size_t size;
+  };
+
+  // Apply a batch of RTP writes in order.  Shims override this to
+  // apply the batch under one lock or in one call to the driver.
+  virtual void
+  update_graph_rtps(const rtp_update* updates, size_t count)
+  {
+    for (size_t i = 0; i < count; ++i) {
+      const auto& upd = updates[i];
+      if (upd.rtp)
+        update_resolved_graph_rtp(upd.rtp, upd.buffer, upd.size);
+      else
+        update_graph_rtp(upd.port, upd.buffer, upd.size);
+    }
+  }
 };
 
 } // xrt_core
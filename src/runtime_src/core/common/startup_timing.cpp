@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE
+#include "core/common/startup_timing.h"
+#include "core/common/config_reader.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+struct phase_record
+{
+  std::string phase;
+  unsigned long start_ns;
+  unsigned long end_ns;
+};
+
+// Phases are recorded from multiple threads when devices are
+// enumerated in parallel.  The report is printed when the object
+// is destructed at process exit.
+class recorder
+{
+  std::mutex m_mutex;
+  std::vector<phase_record> m_phases;
+
+public:
+  ~recorder()
+  {
+    try {
+      if (!m_phases.empty())
+        std::cerr << report();
+    }
+    catch (...) {
+    }
+  }
+
+  void
+  record(const std::string& phase, unsigned long start_ns, unsigned long end_ns)
+  {
+    std::lock_guard lk(m_mutex);
+    m_phases.push_back({phase, start_ns, end_ns});
+  }
+
+  std::string
+  report()
+  {
+    std::vector<phase_record> phases;
+    {
+      std::lock_guard lk(m_mutex);
+      phases = m_phases;
+    }
+
+    std::stable_sort(phases.begin(), phases.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.start_ns < rhs.start_ns; });
+
+    std::ostringstream ostr;
+    ostr << "XRT startup timing (us)\n"
+         << std::setw(12) << "start" << std::setw(12) << "duration" << "  phase\n";
+    for (const auto& p : phases)
+      ostr << std::setw(12) << p.start_ns / 1000
+           << std::setw(12) << (p.end_ns - p.start_ns) / 1000
+           << "  " << p.phase << "\n";
+    return ostr.str();
+  }
+};
+
+static recorder&
+get_recorder()
+{
+  static recorder rec;
+  return rec;
+}
+
+} // namespace
+
+namespace xrt_core::startup_timing {
+
+bool
+enabled()
+{
+  static bool value = xrt_core::config::get_startup_timing();
+  return value;
+}
+
+void
+record(const std::string& phase, unsigned long start_ns, unsigned long end_ns)
+{
+  get_recorder().record(phase, start_ns, end_ns);
+}
+
+std::string
+report()
+{
+  return get_recorder().report();
+}
+
+} // xrt_core::startup_timing
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_CORE_STARTUP_TIMING_H
+#define XRT_CORE_STARTUP_TIMING_H
+
+#include "core/common/config.h"
+#include "core/common/time.h"
+
+#include <string>
+
+////////////////////////////////////////////////////////////////
+// namespace xrt_core::startup_timing
+//
+// Timing of process startup phases such as loading of the shim
+// library and driver plugins, and enumeration of devices.  Phases
+// are recorded when enabled in xrt.ini and the report is printed
+// to stderr at process exit.
+//
+// % cat xrt.ini
+// [Runtime]
+// startup_timing = true
+////////////////////////////////////////////////////////////////
+namespace xrt_core::startup_timing {
+
+// Check if startup timing is enabled
+XRT_CORE_COMMON_EXPORT
+bool
+enabled();
+
+// Record a completed phase, times are from xrt_core::time_ns()
+XRT_CORE_COMMON_EXPORT
+void
+record(const std::string& phase, unsigned long start_ns, unsigned long end_ns);
+
+// Formatted report of recorded phases
+XRT_CORE_COMMON_EXPORT
+std::string
+report();
+
+// class scope - Record the lifetime of the object as a phase
+class scope
+{
+  std::string m_phase;
+  unsigned long m_start = 0;
+  bool m_enabled;
+
+public:
+  explicit
+  scope(std::string phase)
+    : m_enabled(enabled())
+  {
+    if (!m_enabled)
+      return;
+    m_phase = std::move(phase);
+    m_start = time_ns();
+  }
+
+  ~scope()
+  {
+    if (m_enabled)
+      record(m_phase, m_start, time_ns());
+  }
+
+  scope(const scope&) = delete;
+  scope& operator=(const scope&) = delete;
+};
+
+} // xrt_core::startup_timing
+
+#endif
@@ -6,6 +6,7 @@
 #include "system.h"
 #include "device.h"
 #include "module_loader.h"
+#include "startup_timing.h"
 
 #include "gen/version.h"
 
@@ -75,6 +76,7 @@ load_shim()
   // this function returns.  This is because the derived system class
   // could have constructor body that is executed after the base
   // class is constructed.
+  xrt_core::startup_timing::scope timer("load shim library");
   static xrt_core::shim_loader shim;
 }
 
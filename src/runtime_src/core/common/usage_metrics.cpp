@@ -20,15 +20,21 @@
 #include <atomic>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
 
 #ifdef _WIN32
 # pragma warning ( disable : 4996 )
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
 #endif
 
 namespace bpt = boost::property_tree;
@@ -308,7 +314,7 @@ public:
   log_buffer_info_construct(device_id, size_t, const xrt_core::hwctx_handle*) override;
 
   void 
-  log_buffer_info_destruct(device_id) override;
+  log_buffer_info_destruct(device_id, size_t) override;
 
   virtual void
   log_buffer_sync(device_id, const xrt_core::hwctx_handle*, size_t, xclBOSyncDirection) override;
@@ -418,7 +424,7 @@ log_buffer_info_construct(device_id dev_id, size_t sz, const xrt_core::hwctx_han
 
 void
 usage_metrics_logger::
-log_buffer_info_destruct(device_id)
+log_buffer_info_destruct(device_id, size_t)
 {
   // TODO :
   // This call is needed to decrement bo active count
@@ -502,14 +508,274 @@ log_kernel_run_info(const xrt::kernel_impl* krnl_impl, const xrt::run_impl* run_
   }
 }
 
+namespace shm = xrt_core::usage_metrics::shm;
+
+// class shm_segment - process wide shared memory segment
+//
+// The segment is created on first use and its name is unlinked at
+// program exit.  The mapping itself is never unmapped because
+// buffers can be deleted during static destruction after the segment
+// object is destructed.
+class shm_segment
+{
+  shm::segment* m_segment = nullptr;
+  std::string m_name;
+
+public:
+  shm_segment()
+  {
+#ifndef _WIN32
+    m_name = shm::name_prefix + std::to_string(xrt_core::utils::get_pid());
+    auto fd = shm_open(m_name.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644); // NOLINT
+    if (fd < 0) {
+      std::cerr << "Failed to create usage metrics shared memory " << m_name << std::endl;
+      return;
+    }
+
+    void* addr = MAP_FAILED;
+    if (ftruncate(fd, sizeof(shm::segment)) == 0)
+      addr = mmap(nullptr, sizeof(shm::segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (addr == MAP_FAILED) {
+      std::cerr << "Failed to map usage metrics shared memory " << m_name << std::endl;
+      shm_unlink(m_name.c_str());
+      return;
+    }
+
+    // ftruncate zero fills the segment, which is the initial state of
+    // all counters.  Magic is written last so readers ignore the
+    // segment until the header is complete.
+    m_segment = static_cast<shm::segment*>(addr);
+    m_segment->version = shm::version;
+    m_segment->max_devices = shm::max_devices;
+    m_segment->slot_size = sizeof(shm::device_slot);
+    m_segment->pid = xrt_core::utils::get_pid();
+    std::atomic_thread_fence(std::memory_order_release);
+    m_segment->magic = shm::magic;
+#endif
+  }
+
+  ~shm_segment()
+  {
+#ifndef _WIN32
+    if (m_segment)
+      shm_unlink(m_name.c_str());
+#endif
+  }
+
+  shm_segment(const shm_segment&) = delete;
+  shm_segment(shm_segment&&) = delete;
+  shm_segment& operator=(const shm_segment&) = delete;
+  shm_segment& operator=(shm_segment&&) = delete;
+
+  shm::device_slot*
+  get_slot(device_id dev_id) const
+  {
+    return (m_segment && dev_id < shm::max_devices)
+      ? &m_segment->devices[dev_id]
+      : nullptr;
+  }
+};
+
+static shm_segment&
+get_shm_segment()
+{
+  static shm_segment segment;
+  return segment;
+}
+
+inline void
+add(shm::device_slot* slot, shm::counter idx, uint64_t value)
+{
+  slot->counters[idx].fetch_add(value, std::memory_order_relaxed);
+}
+
+// class shm_metrics_logger - publish live counters in shared memory
+//
+// Logging objects are created per thread, but all update the same
+// process wide segment using relaxed atomics.  The only lock is the
+// one protecting start times of runs.  Calls are forwarded to the
+// next logger, which is the json logger if that is also enabled.
+class shm_metrics_logger : public xrt_core::usage_metrics::base_logger
+{
+  using clock = std::chrono::steady_clock;
+  struct run_start
+  {
+    clock::time_point time;
+    shm::device_slot* slot;
+  };
+
+  std::shared_ptr<xrt_core::usage_metrics::base_logger> m_next;
+  const shm_segment& m_segment;
+
+  // Start time of runs logged by this logger.  A run logs to the
+  // logger of the thread that constructed it, but may be started and
+  // waited on from any thread.  Entries of runs that are never waited
+  // on are removed when the run is destructed.
+  std::mutex m_mutex;
+  std::unordered_map<const xrt::run_impl*, run_start> m_starts;
+
+  static shm::device_slot*
+  get_kernel_slot(const shm_segment& segment, const xrt::kernel_impl* krnl_impl)
+  {
+    auto kernel = xrt_core::kernel_int::create_kernel_from_implementation(krnl_impl);
+    auto hw_ctx = xrt_core::kernel_int::get_hw_ctx(kernel);
+    return segment.get_slot(xrt_core::hw_context_int::get_core_device_raw(hw_ctx)->get_device_id());
+  }
+
+public:
+  explicit
+  shm_metrics_logger(std::shared_ptr<xrt_core::usage_metrics::base_logger> next)
+    : m_next(std::move(next))
+    , m_segment(get_shm_segment())
+  {}
+
+  void
+  log_device_info(const xrt_core::device* dev) override
+  {
+    m_next->log_device_info(dev);
+    auto slot = m_segment.get_slot(dev->get_device_id());
+    if (!slot)
+      return;
+
+    // First thread to open the device records its bdf
+    uint64_t unused = 0;
+    if (!slot->state.compare_exchange_strong(unused, 1))
+      return;
+
+    try {
+      auto bdf = xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(dev));
+      std::strncpy(slot->bdf, bdf.c_str(), shm::bdf_size - 1);
+    }
+    catch (...) {}
+    slot->state.store(2, std::memory_order_release);
+  }
+
+  void
+  log_hw_ctx_info(const xrt::hw_context_impl* hwctx_impl) override
+  {
+    m_next->log_hw_ctx_info(hwctx_impl);
+    try {
+      auto hw_ctx =
+        xrt_core::hw_context_int::create_hw_context_from_implementation(const_cast<xrt::hw_context_impl*>(hwctx_impl));
+      if (auto slot = m_segment.get_slot(xrt_core::hw_context_int::get_core_device_raw(hw_ctx)->get_device_id()))
+        add(slot, shm::hw_contexts, 1);
+    }
+    catch (...) {}
+  }
+
+  void
+  log_buffer_info_construct(device_id dev_id, size_t sz, const xrt_core::hwctx_handle* handle) override
+  {
+    m_next->log_buffer_info_construct(dev_id, sz, handle);
+    auto slot = m_segment.get_slot(dev_id);
+    if (!slot)
+      return;
+
+    add(slot, shm::bo_allocs, 1);
+    add(slot, shm::bo_live_count, 1);
+    auto live = slot->counters[shm::bo_live_bytes].fetch_add(sz, std::memory_order_relaxed) + sz;
+    auto& peak = slot->counters[shm::bo_peak_bytes];
+    auto old = peak.load(std::memory_order_relaxed);
+    while (old < live && !peak.compare_exchange_weak(old, live, std::memory_order_relaxed)) {}
+  }
+
+  void
+  log_buffer_info_destruct(device_id dev_id, size_t sz) override
+  {
+    m_next->log_buffer_info_destruct(dev_id, sz);
+    auto slot = m_segment.get_slot(dev_id);
+    if (!slot)
+      return;
+
+    slot->counters[shm::bo_live_count].fetch_sub(1, std::memory_order_relaxed);
+    slot->counters[shm::bo_live_bytes].fetch_sub(sz, std::memory_order_relaxed);
+  }
+
+  void
+  log_buffer_sync(device_id dev_id, const xrt_core::hwctx_handle* handle, size_t sz, xclBOSyncDirection dir) override
+  {
+    m_next->log_buffer_sync(dev_id, handle, sz, dir);
+    auto slot = m_segment.get_slot(dev_id);
+    if (!slot)
+      return;
+
+    if (dir == XCL_BO_SYNC_BO_TO_DEVICE) {
+      add(slot, shm::sync_to_device, 1);
+      add(slot, shm::bytes_to_device, sz);
+    }
+    else {
+      add(slot, shm::sync_from_device, 1);
+      add(slot, shm::bytes_from_device, sz);
+    }
+  }
+
+  void
+  log_kernel_info(const xrt_core::device* dev, const xrt::hw_context& ctx, const std::string& name, size_t args) override
+  {
+    m_next->log_kernel_info(dev, ctx, name, args);
+  }
+
+  void
+  log_kernel_run_info(const xrt::kernel_impl* krnl_impl, const xrt::run_impl* run_hdl, ert_cmd_state state) override
+  {
+    auto now = clock::now();
+    m_next->log_kernel_run_info(krnl_impl, run_hdl, state);
+
+    // state ERT_CMD_STATE_NEW indicates kernel start
+    if (state == ERT_CMD_STATE_NEW) {
+      try {
+        auto slot = get_kernel_slot(m_segment, krnl_impl);
+        if (!slot)
+          return;
+
+        add(slot, shm::kernel_starts, 1);
+        std::lock_guard lk(m_mutex);
+        m_starts[run_hdl] = {now, slot};
+      }
+      catch (...) {}
+      return;
+    }
+
+    run_start rs;
+    {
+      std::lock_guard lk(m_mutex);
+      auto itr = m_starts.find(run_hdl);
+      if (itr == m_starts.end())
+        return;
+
+      rs = itr->second;
+      m_starts.erase(itr);
+    }
+    auto [start, slot] = rs;
+    add(slot, (state == ERT_CMD_STATE_COMPLETED) ? shm::kernel_completions : shm::kernel_errors, 1);
+    add(slot, shm::kernel_wait_us, std::chrono::duration_cast<std::chrono::microseconds>(now - start).count());
+  }
+
+  void
+  log_kernel_run_destruct(const xrt::run_impl* run_hdl) override
+  {
+    m_next->log_kernel_run_destruct(run_hdl);
+    std::lock_guard lk(m_mutex);
+    m_starts.erase(run_hdl);
+  }
+};
+
 // Create specific logger if ini option is enabled
 static std::shared_ptr<xrt_core::usage_metrics::base_logger>
 get_logger_object()
 {
+  std::shared_ptr<xrt_core::usage_metrics::base_logger> logger;
   if (xrt_core::config::get_usage_metrics_logging())
-    return std::make_shared<usage_metrics_logger>();
+    logger = std::make_shared<usage_metrics_logger>();
+  else
+    logger = std::make_shared<xrt_core::usage_metrics::base_logger>();
+
+  if (xrt_core::config::get_usage_metrics_shm())
+    return std::make_shared<shm_metrics_logger>(std::move(logger));
 
-  return std::make_shared<xrt_core::usage_metrics::base_logger>();
+  return logger;
 }
 
 } // namespace
@@ -3,6 +3,7 @@
 #ifndef XRT_CORE_USAGE_METRICS_H
 #define XRT_CORE_USAGE_METRICS_H
 
+#include <atomic>
 #include <memory>
 #include <cstdint>
 #include <string>
@@ -32,9 +33,71 @@ using device_id = unsigned int;
 // % cat xrt.ini
 // [Runtime]
 // usage_metrics_logging = true
+//
+// Live counters are published in a per process shared memory
+// segment when enabled using xrt.ini.  The counters are updated with
+// relaxed atomic increments and can be polled by tools such as xbtop
+// while the application is running.
+//
+// % cat xrt.ini
+// [Runtime]
+// usage_metrics_shm = true
 ////////////////////////////////////////////////////////////////
 namespace xrt_core::usage_metrics {
 
+// namespace shm - layout of the shared memory segment
+//
+// The segment is named /xrt_usage_metrics.<pid> and is visible as
+// /dev/shm/xrt_usage_metrics.<pid> on Linux.  It holds a header
+// followed by max_devices device slots indexed by device id.  All
+// fields are native endian, readers must check magic and version.
+// The layout is mirrored by core/tools/xbtop/ReportUsage.py.
+namespace shm {
+
+constexpr uint32_t magic = 0x58525455; // "XRTU"
+constexpr uint32_t version = 1;
+constexpr uint32_t max_devices = 16;
+constexpr size_t bdf_size = 32;
+constexpr const char* name_prefix = "/xrt_usage_metrics.";
+
+// Index of counters in a device slot
+enum counter : uint32_t
+{
+  hw_contexts,         // hw contexts created
+  bo_allocs,           // buffers created
+  bo_live_count,       // buffers currently alive
+  bo_live_bytes,       // bytes of buffers currently alive
+  bo_peak_bytes,       // peak of bo_live_bytes
+  sync_to_device,      // number of syncs to device
+  sync_from_device,    // number of syncs from device
+  bytes_to_device,     // bytes synced to device
+  bytes_from_device,   // bytes synced from device
+  kernel_starts,       // runs started
+  kernel_completions,  // runs waited for and completed
+  kernel_errors,       // runs waited for and not completed successfully
+  kernel_wait_us,      // total time from run start to wait return
+  num_counters = 16    // counters reserved per device
+};
+
+struct device_slot
+{
+  std::atomic<uint64_t> state;  // 0 unused, 1 initializing, 2 valid
+  char bdf[bdf_size];           // nul terminated
+  std::atomic<uint64_t> counters[num_counters];
+};
+
+struct segment
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t max_devices;
+  uint32_t slot_size;
+  uint64_t pid;
+  device_slot devices[shm::max_devices];
+};
+
+} // shm
+
 // class base_logger - class with no op calls
 //
 // when user doesn't set ini option logging should be no op
@@ -51,7 +114,7 @@ public:
   log_buffer_info_construct(device_id, size_t, const xrt_core::hwctx_handle*) {}
   
   virtual void 
-  log_buffer_info_destruct(device_id) {}
+  log_buffer_info_destruct(device_id, size_t) {}
 
   virtual void
   log_buffer_sync(device_id, const xrt_core::hwctx_handle*, size_t, xclBOSyncDirection) {}
@@ -61,6 +124,9 @@ public:
 
   virtual void
   log_kernel_run_info(const xrt::kernel_impl*, const xrt::run_impl*, ert_cmd_state) {}
+
+  virtual void
+  log_kernel_run_destruct(const xrt::run_impl*) {}
 };
 
 // get_usage_metrics_logger() - Return logger object for current thread
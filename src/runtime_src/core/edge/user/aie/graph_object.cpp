@@ -277,27 +277,52 @@ graph_object::update_graph_rtp(const char* port, const char* buffer, size_t size
   auto it = rtps.find(port);
   if (it == rtps.end())
     throw xrt_core::error(-EINVAL, "Can't update graph '" + name + "': RTP port '" + port + "' not found");
-  auto& rtp = it->second;
+
+  update_resolved_graph_rtp(&it->second, buffer, size);
+}
+
+void
+graph_object::read_graph_rtp(const char* port, char* buffer, size_t size)
+{
+  auto it = rtps.find(port);
+  if (it == rtps.end())
+    throw xrt_core::error(-EINVAL, "Can't read graph '" + name + "': RTP port '" + port + "' not found");
+
+  read_resolved_graph_rtp(&it->second, buffer, size);
+}
+
+void*
+graph_object::resolve_graph_rtp(const char* port)
+{
+  // rtps is not modified after construction, so the address of an
+  // element is stable for the lifetime of the graph object
+  auto it = rtps.find(port);
+  if (it == rtps.end())
+    throw xrt_core::error(-EINVAL, "Can't resolve graph '" + name + "': RTP port '" + port + "' not found");
+  return &it->second;
+}
+
+void
+graph_object::update_resolved_graph_rtp(void* hdl, const char* buffer, size_t size)
+{
+  auto& rtp = *static_cast<adf::rtp_config*>(hdl);
 
   if (access_mode == xrt::graph::access_mode::shared && !rtp.isAsync)
     throw xrt_core::error(-EPERM, "Shared context can not update sync RTP");
 
   if (rtp.isPL)
-    throw xrt_core::error(-EINVAL, "Can't update graph '" + name + "': RTP port '" + port + "' is not AIE RTP");
+    throw xrt_core::error(-EINVAL, "Can't update graph '" + name + "': RTP port '" + rtp.portName + "' is not AIE RTP");
 
   graph_api_obj->update(&rtp, (const void*)buffer, size);
 }
 
 void
-graph_object::read_graph_rtp(const char* port, char* buffer, size_t size)
+graph_object::read_resolved_graph_rtp(void* hdl, char* buffer, size_t size)
 {
-  auto it = rtps.find(port);
-  if (it == rtps.end())
-    throw xrt_core::error(-EINVAL, "Can't read graph '" + name + "': RTP port '" + port + "' not found");
-  auto& rtp = it->second;
+  auto& rtp = *static_cast<adf::rtp_config*>(hdl);
 
   if (rtp.isPL)
-    throw xrt_core::error(-EINVAL, "Can't read graph '" + name + "': RTP port '" + port + "' is not AIE RTP");
+    throw xrt_core::error(-EINVAL, "Can't read graph '" + name + "': RTP port '" + rtp.portName + "' is not AIE RTP");
 
   graph_api_obj->read(&rtp, (void*)buffer, size);
 }
@@ -95,6 +95,15 @@ namespace zynqaie {
 
     void
     read_graph_rtp(const char* port, char* buffer, size_t size) override;
+
+    void*
+    resolve_graph_rtp(const char* port) override;
+
+    void
+    update_resolved_graph_rtp(void* rtp, const char* buffer, size_t size) override;
+
+    void
+    read_resolved_graph_rtp(void* rtp, char* buffer, size_t size) override;
   }; // graph_object
 }
 #endif  //_ZYNQ_GRAPH_OBJECT_H_
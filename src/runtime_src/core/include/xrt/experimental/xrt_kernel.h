@@ -12,6 +12,8 @@
 # include "xrt/detail/pimpl.h"
 # include <chrono>
 # include <condition_variable>
+# include <limits>
+# include <vector>
 #endif
 
 #ifdef __cplusplus
@@ -243,6 +245,369 @@ public:
   reset();
 };
 
+/**
+ * class run_sequence - Captured sequence of runs and buffer syncs
+ *
+ * @brief
+ * A run sequence records a fixed sequence of run objects and buffer
+ * syncs once and replays it repeatedly with minimal host overhead.
+ *
+ * @details
+ * Applications that execute the same sequence of kernel runs with
+ * the same buffers over and over can capture the sequence in a
+ * run_sequence.  The run objects are encoded into chained commands
+ * when captured, and a replay submits the pre-encoded chained
+ * commands as is.
+ *
+ * Buffer syncs are captured in order with the run objects.  Syncs
+ * captured before the first run object are performed before the runs
+ * are submitted, syncs captured after the last run object are
+ * performed by wait() after the runs have completed.  A sync captured
+ * between two run objects splits the sequence; the replay then waits
+ * for the runs before the sync to complete before it performs the
+ * sync and submits the remaining runs.
+ *
+ * Kernel arguments that change between replays must be declared as
+ * variables.  Only declared variables can be changed, and only while
+ * the sequence is not executing.
+ *
+ * All run objects must be created from kernels in the hardware
+ * context of the sequence.  A captured run object belongs to the
+ * sequence and cannot be started explicitly or added to a runlist.
+ */
+class run_sequence_impl;
+class run_sequence : public detail::pimpl<run_sequence_impl>
+{
+public:
+  /**
+   * run_sequence() - Construct empty sequence
+   */
+  run_sequence() = default;
+
+  /**
+   * run_sequence() - Construct sequence for a hardware context
+   *
+   * @param hwctx
+   *  Hardware context of all run objects in the sequence
+   */
+  XRT_API_EXPORT
+  explicit
+  run_sequence(const xrt::hw_context& hwctx);
+
+  /**
+   * add() - Capture a run object
+   *
+   * @param run
+   *  Run object with all arguments set
+   *
+   * Throws if the sequence is executing.
+   */
+  XRT_API_EXPORT
+  void
+  add(const xrt::run& run);
+
+  /**
+   * add_sync() - Capture a buffer sync
+   *
+   * @param bo
+   *  Buffer to sync
+   * @param dir
+   *  Direction of sync
+   *
+   * Throws if the sequence is executing.
+   */
+  XRT_API_EXPORT
+  void
+  add_sync(const xrt::bo& bo, xclBOSyncDirection dir);
+
+  /**
+   * add_variable() - Declare an argument of a captured run as variable
+   *
+   * @param run
+   *  Captured run object
+   * @param index
+   *  Index of kernel argument that changes between replays
+   * @return
+   *  Variable id to use with set_arg()
+   *
+   * Throws if the run object is not captured by this sequence.
+   */
+  XRT_API_EXPORT
+  size_t
+  add_variable(const xrt::run& run, int index);
+
+  /**
+   * set_arg() - Set a scalar variable
+   *
+   * @param var
+   *  Variable id returned by add_variable()
+   * @param arg
+   *  The scalar argument value to set
+   */
+  template <typename ArgType>
+  void
+  set_arg(size_t var, ArgType&& arg)
+  {
+    set_arg_at_index(var, &arg, sizeof(arg));
+  }
+
+  /**
+   * set_arg() - Set a global buffer variable
+   *
+   * @param var
+   *  Variable id returned by add_variable()
+   * @param boh
+   *  The global buffer argument value to set
+   */
+  void
+  set_arg(size_t var, const xrt::bo& boh)
+  {
+    set_arg_at_index(var, boh);
+  }
+
+  /**
+   * set_arg - xrt::bo variant for lvalue
+   */
+  void
+  set_arg(size_t var, xrt::bo& boh)
+  {
+    set_arg_at_index(var, boh);
+  }
+
+  /**
+   * set_arg - xrt::bo variant for rvalue
+   */
+  void
+  set_arg(size_t var, xrt::bo&& boh)
+  {
+    set_arg_at_index(var, boh);
+  }
+
+  /**
+   * replay() - Execute the captured sequence
+   *
+   * Performs leading buffer syncs and submits the captured runs.  If
+   * the sequence is split by syncs between runs, the function blocks
+   * until all but the last part of the sequence have completed.
+   *
+   * Throws if the sequence is executing.
+   */
+  XRT_API_EXPORT
+  void
+  replay();
+
+  /**
+   * wait() - Wait for the sequence to complete
+   *
+   * @param timeout
+   *  Timeout for wait (default block till completion)
+   * @return
+   *  std::cv_status::no_timeout when the sequence has completed,
+   *  std::cv_status::timeout otherwise
+   *
+   * Upon completion of the runs, buffer syncs captured after the
+   * last run object are performed.  Throws
+   * `xrt::runlist::command_error` with the first failing run object
+   * if any.
+   */
+  XRT_API_EXPORT
+  std::cv_status
+  wait(const std::chrono::milliseconds& timeout) const;
+
+  /**
+   * wait() - Wait for the sequence to complete
+   */
+  void
+  wait() const
+  {
+    wait(std::chrono::milliseconds(0));
+  }
+
+private:
+  XRT_API_EXPORT
+  void
+  set_arg_at_index(size_t var, const void* value, size_t bytes);
+
+  XRT_API_EXPORT
+  void
+  set_arg_at_index(size_t var, const xrt::bo& boh);
+};
+
+/**
+ * class run_template - Pre-validated arguments for creating run objects
+ *
+ * @brief
+ * A run template validates and encodes a set of kernel arguments
+ * once and creates run objects with these arguments cheaply.
+ *
+ * @details
+ * Fanning one job out to all compute units of a kernel requires one
+ * run object per compute unit.  Setting arguments on each run object
+ * repeats validation of the arguments and of compute unit
+ * connectivity for global buffers.  A run template does this once;
+ * run objects created from the template copy the encoded arguments
+ * and can be restricted to a single compute unit or use a different
+ * region of a global buffer argument without validation.
+ *
+ * The compute units of a template are the compute units of the kernel
+ * that are connected to all global buffer arguments set in the
+ * template.
+ *
+ * Run objects created from a template are independent of the template
+ * and of each other.  Arguments can be changed on a created run object
+ * as usual.  The template must not be modified while run objects are
+ * being created from it.
+ *
+ * Kernels with a mailbox are not supported.
+ */
+class run_template_impl;
+class run_template : public detail::pimpl<run_template_impl>
+{
+public:
+  /**
+   * @struct arg_offset - region of a global buffer argument
+   *
+   * @var index
+   *  Index of a global buffer argument set in the template
+   * @var offset
+   *  Offset of region in the template buffer
+   * @var size
+   *  Size of region
+   */
+  struct arg_offset
+  {
+    int index;
+    size_t offset;
+    size_t size;
+  };
+
+  /**
+   * any_cu - Use any compute unit of the template
+   */
+  static constexpr size_t any_cu = std::numeric_limits<size_t>::max();
+
+  /**
+   * run_template() - Construct empty template
+   *
+   * It is undefined behavior to use a default constructed template
+   * for anything but assignment.
+   */
+  run_template() = default;
+
+  /**
+   * run_template() - Construct template for kernel
+   *
+   * @param kernel
+   *  Kernel to create run objects for
+   */
+  XRT_API_EXPORT
+  explicit
+  run_template(const xrt::kernel& kernel);
+
+  /**
+   * set_arg() - Set and validate a scalar argument
+   *
+   * @param index
+   *  Index of kernel argument
+   * @param arg
+   *  The scalar argument value to set
+   */
+  template <typename ArgType>
+  void
+  set_arg(int index, ArgType&& arg)
+  {
+    set_arg_at_index(index, &arg, sizeof(arg));
+  }
+
+  /**
+   * set_arg() - Set and validate a global buffer argument
+   *
+   * @param index
+   *  Index of kernel argument
+   * @param boh
+   *  The global buffer argument value to set
+   *
+   * Compute units of the template are restricted to those connected
+   * to the memory bank of the buffer.
+   */
+  void
+  set_arg(int index, const xrt::bo& boh)
+  {
+    set_arg_at_index(index, boh);
+  }
+
+  /**
+   * set_arg - xrt::bo variant for lvalue
+   */
+  void
+  set_arg(int index, xrt::bo& boh)
+  {
+    set_arg_at_index(index, boh);
+  }
+
+  /**
+   * set_arg - xrt::bo variant for rvalue
+   */
+  void
+  set_arg(int index, xrt::bo&& boh)
+  {
+    set_arg_at_index(index, boh);
+  }
+
+  /**
+   * get_num_cus() - Number of compute units of the template
+   *
+   * @return
+   *  Number of compute units connected to the global buffer arguments
+   *  set in the template.  Compute units are indexed 0 to
+   *  get_num_cus() - 1 when creating run objects.
+   */
+  XRT_API_EXPORT
+  size_t
+  get_num_cus() const;
+
+  /**
+   * create() - Create a run object with the template arguments
+   *
+   * @param cu
+   *  Index of compute unit (0 .. get_num_cus() - 1) that executes the
+   *  run object, or any_cu for any compute unit of the template
+   * @param offsets
+   *  Regions of global buffer arguments to use instead of the full
+   *  buffers set in the template
+   * @return
+   *  New run object
+   *
+   * Throws if cu is out of range or if an offset refers to an
+   * argument that is not a global buffer set in the template, or to
+   * a region outside the buffer.
+   */
+  XRT_API_EXPORT
+  xrt::run
+  create(size_t cu, const std::vector<arg_offset>& offsets) const;
+
+  /**
+   * create() - Create a run object with the template arguments
+   *
+   * @param cu
+   *  Index of compute unit, or any_cu for any compute unit
+   */
+  xrt::run
+  create(size_t cu = any_cu) const
+  {
+    return create(cu, {});
+  }
+
+private:
+  XRT_API_EXPORT
+  void
+  set_arg_at_index(int index, const void* value, size_t bytes);
+
+  XRT_API_EXPORT
+  void
+  set_arg_at_index(int index, const xrt::bo& boh);
+};
+
 } // namespace xrt
 
 #endif // __cplusplus
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_LATENCY_H_
+#define XRT_LATENCY_H_
+
+// Latency distribution of kernel runs
+// These extensions are experimental
+
+#include "xrt/detail/config.h"
+#include "xrt/xrt_kernel.h"
+
+#ifdef __cplusplus
+# include <cstdint>
+# include <string>
+#endif
+
+#ifdef __cplusplus
+namespace xrt::ext {
+
+/**
+ * @enum latency_phase - phase of a kernel run
+ *
+ * @var submit
+ *  From xrt::run::start() until the command is submitted to the driver
+ * @var execute
+ *  From submission until completion of the run is observed by XRT
+ * @var notify
+ *  From observed completion until the host is notified, i.e. wait()
+ *  returns or completion callbacks have been called
+ */
+enum class latency_phase { submit, execute, notify };
+
+/**
+ * struct latency_summary - latency distribution of a phase
+ *
+ * All latencies are in nanoseconds.  Percentiles are computed from a
+ * histogram with a relative error of at most 1/16.
+ */
+struct latency_summary
+{
+  uint64_t count;
+  uint64_t min_ns;
+  uint64_t max_ns;
+  uint64_t mean_ns;
+  uint64_t p50_ns;
+  uint64_t p90_ns;
+  uint64_t p99_ns;
+  uint64_t p999_ns;
+};
+
+/**
+ * get_latency() - Latency distribution of runs of a kernel
+ *
+ * @param kernel
+ *  Kernel to get latency of, runs of all kernel objects with the same
+ *  kernel name are aggregated
+ * @param phase
+ *  Phase of runs to get latency of
+ * @return
+ *  Summary of latency distribution, count is 0 if no runs recorded
+ *
+ * Latency is recorded when enabled in xrt.ini
+ *
+ * @code
+ *  [Runtime]
+ *  latency_histograms = true
+ * @endcode
+ *
+ * Additionally ``latency_histograms_signal = <signum>`` appends
+ * get_latency_report() to ``xrt_latency_<pid>.txt`` when the process
+ * receives the signal.
+ */
+XRT_API_EXPORT
+latency_summary
+get_latency(const xrt::kernel& kernel, latency_phase phase);
+
+/**
+ * get_latency_report() - Latency of all kernels in CSV format
+ *
+ * One line per kernel and phase with count, min, mean, p50, p90,
+ * p99, p99.9, and max in nanoseconds.
+ */
+XRT_API_EXPORT
+std::string
+get_latency_report();
+
+/**
+ * reset_latency() - Reset recorded latency of all kernels
+ */
+XRT_API_EXPORT
+void
+reset_latency();
+
+} // xrt::ext
+
+#endif // __cplusplus
+#endif
@@ -0,0 +1,288 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_MULTI_DEVICE_H_
+#define XRT_MULTI_DEVICE_H_
+
+// Data parallel execution across several devices
+// These extensions are experimental
+
+#include "xrt/detail/config.h"
+#include "xrt/detail/pimpl.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+
+#ifdef __cplusplus
+# include <chrono>
+# include <cstddef>
+# include <vector>
+#endif
+
+#ifdef __cplusplus
+namespace xrt::ext {
+
+/*!
+ * @class striped_bo
+ *
+ * @brief
+ * xrt::ext::striped_bo is a buffer striped across several devices
+ *
+ * @details
+ * A striped buffer of size `sz` is split into one contiguous slice
+ * per device.  Slice `i` is an xrt::bo on device `i` holding bytes
+ * [slice_offset(i), slice_offset(i) + slice(i).size()) of the striped
+ * buffer.  All slices but the last are of equal size, a multiple of
+ * the requested alignment.
+ *
+ * Operations on all slices (sync, scatter, gather) are issued to the
+ * devices concurrently and return when all have completed.
+ */
+class striped_bo_impl;
+class striped_bo : public detail::pimpl<striped_bo_impl>
+{
+public:
+  striped_bo() = default;
+
+  /**
+   * striped_bo() - Constructor for buffer striped across devices
+   *
+   * @param devices
+   *  Devices to stripe the buffer across, one slice per device
+   * @param sz
+   *  Total size of the buffer
+   * @param grps
+   *  Memory group of the slice on each device, same size as devices
+   * @param align
+   *  Alignment in bytes of the slice boundaries
+   */
+  XRT_API_EXPORT
+  striped_bo(const std::vector<xrt::device>& devices, size_t sz,
+             const std::vector<xrt::memory_group>& grps, size_t align = 4096);
+
+  /**
+   * striped_bo() - Constructor for buffer used as kernel argument
+   *
+   * @param kernels
+   *  Same kernel opened on each device, one slice per kernel
+   * @param argidx
+   *  Argument index of the kernels, determines memory group of slices
+   * @param sz
+   *  Total size of the buffer
+   * @param align
+   *  Alignment in bytes of the slice boundaries
+   */
+  XRT_API_EXPORT
+  striped_bo(const std::vector<xrt::kernel>& kernels, int argidx, size_t sz, size_t align = 4096);
+
+  /**
+   * size() - Total size of the striped buffer
+   */
+  XRT_API_EXPORT
+  size_t
+  size() const;
+
+  /**
+   * num_slices() - Number of slices, same as number of devices
+   */
+  XRT_API_EXPORT
+  size_t
+  num_slices() const;
+
+  /**
+   * slice() - Buffer object of a slice
+   *
+   * @param idx
+   *  Index of slice, matches index of device
+   */
+  XRT_API_EXPORT
+  const xrt::bo&
+  slice(size_t idx) const;
+
+  /**
+   * slice_offset() - Offset of a slice in the striped buffer
+   *
+   * @param idx
+   *  Index of slice, matches index of device
+   */
+  XRT_API_EXPORT
+  size_t
+  slice_offset(size_t idx) const;
+
+  /**
+   * sync() - Synchronize all slices concurrently
+   *
+   * @param dir
+   *  Direction of sync
+   */
+  XRT_API_EXPORT
+  void
+  sync(xclBOSyncDirection dir);
+
+  /**
+   * scatter() - Write host data to slices and sync them to devices
+   *
+   * @param src
+   *  Source data of size() bytes
+   *
+   * Each slice is written and synced concurrently with other slices.
+   */
+  XRT_API_EXPORT
+  void
+  scatter(const void* src);
+
+  /**
+   * scatter() - Copy content of a buffer object into slices
+   *
+   * @param src
+   *  Source buffer of at least size() bytes
+   *
+   * Each slice is copied concurrently with other slices.  Slices on a
+   * different device than the source buffer are copied from an import
+   * of the source buffer.
+   */
+  XRT_API_EXPORT
+  void
+  scatter(const xrt::bo& src);
+
+  /**
+   * gather() - Sync slices from devices and read them to host memory
+   *
+   * @param dst
+   *  Destination of size() bytes
+   */
+  XRT_API_EXPORT
+  void
+  gather(void* dst);
+
+  /**
+   * gather() - Copy content of slices into a buffer object
+   *
+   * @param dst
+   *  Destination buffer of at least size() bytes
+   *
+   * Slices on a different device than the destination buffer are
+   * copied through an import of the slice.
+   */
+  XRT_API_EXPORT
+  void
+  gather(xrt::bo& dst);
+};
+
+/*!
+ * @class broadcast_run
+ *
+ * @brief
+ * xrt::ext::broadcast_run starts the same kernel on several devices
+ *
+ * @details
+ * A broadcast run holds one xrt::run per kernel.  A striped buffer
+ * argument assigns each run its slice, other arguments are assigned
+ * to all runs.  start() starts all runs and wait() waits for all to
+ * complete.
+ */
+class broadcast_run_impl;
+class broadcast_run : public detail::pimpl<broadcast_run_impl>
+{
+public:
+  broadcast_run() = default;
+
+  /**
+   * broadcast_run() - Constructor from kernels
+   *
+   * @param kernels
+   *  Same kernel opened on each device
+   */
+  XRT_API_EXPORT
+  explicit
+  broadcast_run(const std::vector<xrt::kernel>& kernels);
+
+  /**
+   * size() - Number of runs, same as number of kernels
+   */
+  XRT_API_EXPORT
+  size_t
+  size() const;
+
+  /**
+   * get_run() - Run of a device
+   *
+   * @param idx
+   *  Index of run, matches index of kernel
+   *
+   * The run can be used to set device specific arguments.
+   */
+  XRT_API_EXPORT
+  xrt::run&
+  get_run(size_t idx);
+
+  /**
+   * set_arg() - Assign slices of a striped buffer to runs
+   *
+   * @param index
+   *  Index of kernel argument
+   * @param bo
+   *  Striped buffer with one slice per run
+   */
+  XRT_API_EXPORT
+  void
+  set_arg(int index, const striped_bo& bo);
+
+  /**
+   * set_arg - striped_bo variant for non-const lvalue
+   */
+  void
+  set_arg(int index, striped_bo& bo)
+  {
+    set_arg(index, static_cast<const striped_bo&>(bo));
+  }
+
+  /**
+   * set_arg - striped_bo variant for rvalue
+   */
+  void
+  set_arg(int index, striped_bo&& bo)
+  {
+    set_arg(index, static_cast<const striped_bo&>(bo));
+  }
+
+  /**
+   * set_arg() - Assign same argument to all runs
+   *
+   * @param index
+   *  Index of kernel argument
+   * @param arg
+   *  Argument value
+   */
+  template <typename ArgType>
+  void
+  set_arg(int index, ArgType&& arg)
+  {
+    for (size_t idx = 0; idx < size(); ++idx)
+      get_run(idx).set_arg(index, arg);
+  }
+
+  /**
+   * start() - Start all runs
+   */
+  XRT_API_EXPORT
+  void
+  start();
+
+  /**
+   * wait() - Wait for all runs to complete
+   *
+   * @param timeout
+   *  Timeout applied to the wait of each run, 0 waits until complete
+   * @return
+   *  ERT_CMD_STATE_COMPLETED if all runs completed, otherwise state
+   *  of first run that did not complete
+   */
+  XRT_API_EXPORT
+  ert_cmd_state
+  wait(const std::chrono::milliseconds& timeout = std::chrono::milliseconds{0});
+};
+
+} // xrt::ext
+
+#endif // __cplusplus
+#endif
@@ -746,6 +746,49 @@ public:
     copy(src, src.size());
   }
 
+  /**
+   * async_copy() - Start deep copy of BO content from another buffer
+   *
+   * @param src
+   *  Source BO to copy from
+   * @param sz
+   *  Size of data to copy
+   * @param src_offset
+   *  Offset into src buffer copy from
+   * @param dst_offset
+   *  Offset into this buffer to copy to
+   * @return
+   *  Handle to wait on for completion of the copy
+   *
+   * The copy is performed in the background as if by copy() and
+   * copies to buffers of the same device complete in the order
+   * started.  The source and destination buffers are kept alive
+   * until the copy completes, but must not be modified by the host
+   * while the copy is in progress.
+   *
+   * Throws if copy size is 0 or sz + src/dst_offset is out of bounds.
+   * Errors during the copy are thrown by async_handle::wait().
+   */
+  XCL_DRIVER_DLLESPEC
+  async_handle
+  async_copy(const bo& src, size_t sz, size_t src_offset=0, size_t dst_offset=0);
+
+  /**
+   * async_copy() - Start deep copy of BO content from another buffer
+   *
+   * @param src
+   *  Source BO to copy from
+   * @return
+   *  Handle to wait on for completion of the copy
+   *
+   * Throws if src is larger than this buffer.
+   */
+  async_handle
+  async_copy(const bo& src)
+  {
+    return async_copy(src, src.size());
+  }
+
   /**
    * ~bo() - Destructor for bo object
    */
@@ -26,8 +26,10 @@
 
 #ifdef __cplusplus
 # include <chrono>
+# include <memory>
 # include <string>
 # include <cstdint>
+# include <vector>
 # include "xrt/xrt_hw_context.h"
 #endif
 
@@ -67,6 +69,62 @@ public:
    */
   enum class access_mode : uint8_t { exclusive = 0, primary = 1, shared = 2 };
 
+  /*!
+   * @class rtp
+   *
+   * @brief
+   * xrt::graph::rtp is a Run Time Parameter port resolved by get_rtp()
+   *
+   * @details
+   * Updating or reading a resolved port skips the lookup of the port
+   * by name.  A resolved port can only be used with the graph it was
+   * resolved from.
+   */
+  class rtp_impl;
+  class rtp
+  {
+  public:
+    rtp() = default;
+
+    explicit
+    rtp(std::shared_ptr<rtp_impl> impl)
+      : handle(std::move(impl))
+    {}
+
+    /// @cond
+    const std::shared_ptr<rtp_impl>&
+    get_handle() const
+    {
+      return handle;
+    }
+    /// @endcond
+
+  private:
+    std::shared_ptr<rtp_impl> handle;
+  };
+
+  /*!
+   * @struct rtp_update
+   *
+   * @brief
+   * One RTP write of a batched update()
+   *
+   * @details
+   * The port and the value are referenced, not copied, and must be
+   * valid until update() returns.
+   */
+  struct rtp_update
+  {
+    template <typename ArgType>
+    rtp_update(const rtp& rtp_port, const ArgType& arg)
+      : port(&rtp_port), value(&arg), bytes(sizeof(arg))
+    {}
+
+    const rtp* port;
+    const void* value;
+    size_t bytes;
+  };
+
   /**
    * graph() - Constructor from a device, xclbin and graph name
    *
@@ -227,6 +285,61 @@ public:
     read_port(port_name, &arg, sizeof(arg));
   }
 
+  /**
+   * get_rtp() - Resolve a Run Time Parameter port.
+   *
+   * @param port_name
+   *  Hierarchical name of RTP port.
+   * @return
+   *  Port to use with update() and read() in place of the port name
+   *
+   * Resolve a port once when it is updated or read repeatedly.
+   */
+  rtp
+  get_rtp(const std::string& port_name) const;
+
+  /**
+   * update() - Update graph Run Time Parameter of resolved port.
+   *
+   * @param port
+   *  RTP port resolved by get_rtp().
+   * @param arg
+   *  The argument to set.
+   */
+  template<typename ArgType>
+  void
+  update(const rtp& port, ArgType&& arg)
+  {
+    update_port(port, &arg, sizeof(arg));
+  }
+
+  /**
+   * read() - Read graph Run Time Parameter value of resolved port.
+   *
+   * @param port
+   *  RTP port resolved by get_rtp().
+   * @param arg
+   *  The RTP value is written to.
+   */
+  template<typename ArgType>
+  void
+  read(const rtp& port, ArgType& arg)
+  {
+    read_port(port, &arg, sizeof(arg));
+  }
+
+  /**
+   * update() - Update several graph Run Time Parameters.
+   *
+   * @param updates
+   *  Resolved ports and values to set, e.g. ``{{rtp1, value1}, {rtp2, value2}}``
+   *
+   * The updates are applied in order.  Where supported by the driver
+   * the batch is applied in one call, otherwise port by port.
+   */
+  void
+  update(const std::vector<rtp_update>& updates);
+
 private:
   std::shared_ptr<graph_impl> handle;
 
@@ -235,6 +348,12 @@ private:
 
   void
   read_port(const std::string& port_name, void* value, size_t bytes);
+
+  void
+  update_port(const rtp& port, const void* value, size_t bytes);
+
+  void
+  read_port(const rtp& port, void* value, size_t bytes);
 };
 
 } // namespace xrt
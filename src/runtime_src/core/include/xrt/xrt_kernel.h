@@ -122,6 +122,27 @@ public:
     std::shared_ptr<command_error_impl> m_impl;
   };
 
+  /**
+   * @enum priority - host side scheduling class of a run
+   *
+   * @var high
+   *  Latency sensitive, admitted ahead of other classes
+   * @var normal
+   *  Default class
+   * @var low
+   *  Batch work, typically held back when the device is busy
+   *
+   * @details
+   * The priority applies when host side scheduling is enabled in
+   * xrt.ini (``Runtime.hw_queue_qos_depth``,
+   * ``Runtime.hw_queue_qos_rate``).  Runs sharing a hardware
+   * context are then admitted to the device in priority order, and
+   * runs of a class are held back while the number of runs in
+   * flight exceeds the depth limit of the class or while the class
+   * exceeds its rate limit.  Otherwise the priority is ignored.
+   */
+  enum class priority : uint8_t { high, normal, low };
+
 public:
   /**
    * run() - Construct empty run object
@@ -414,6 +435,24 @@ public:
                std::function<void(const void*, ert_cmd_state, void*)> callback,
                void* data);
 
+  /**
+   * set_priority() - Set host side scheduling class of run
+   *
+   * @param prio    Priority class of subsequent starts of this run
+   *
+   * See xrt::run::priority.  Default priority is ``priority::normal``.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  set_priority(priority prio);
+
+  /**
+   * get_priority() - Get host side scheduling class of run
+   */
+  XCL_DRIVER_DLLESPEC
+  priority
+  get_priority() const;
+
   /**
    * operator bool() - Check if run handle is valid
    *
@@ -1745,15 +1745,15 @@ namespace xclswemuhal2
     }
     else if (!xclemulation::xocl_bo_host_only(sBO) && !xclemulation::xocl_bo_host_only(dBO) && (dBO->fd < 0) && (sBO->fd < 0))
     {
-      unsigned char temp_buffer[size];
+      std::vector<unsigned char> temp_buffer(size);
       // copy data from source buffer to temp buffer
-      if (xclCopyBufferDevice2Host((void*)temp_buffer, sBO->base, size, src_offset) != size)
+      if (xclCopyBufferDevice2Host((void*)temp_buffer.data(), sBO->base, size, src_offset) != size)
       {
         std::cerr << "ERROR: copy buffer from device to host failed " << std::endl;
         return -1;
       }
       // copy data from temp buffer to destination buffer
-      if (xclCopyBufferHost2Device(dBO->base, (void*)temp_buffer, size, dst_offset) != size)
+      if (xclCopyBufferHost2Device(dBO->base, (void*)temp_buffer.data(), size, dst_offset) != size)
       {
         std::cerr << "ERROR: copy buffer from host to device failed " << std::endl;
         return -1;
@@ -2143,6 +2143,11 @@ namespace xclswemuhal2
         mQueryTable[key_type::nodma] = (dmaVal == "none" ? "enabled" : "disabled");
       }
     }
+
+    // xclCopyBO copies device buffers directly, advertise it as m2m
+    // when emulation is requested and the platform doesn't say otherwise
+    if (xrt_core::config::get_emulate_m2m() && mQueryTable.find(key_type::m2m) == mQueryTable.end())
+      mQueryTable[key_type::m2m] = "enabled";
   }
 
   int SwEmuShim::deviceQuery(key_type queryKey)
@@ -2416,6 +2421,36 @@ namespace xclswemuhal2
     return 0;
   }
 
+  /**
+* xrtGraphUpdateRTPs() - Update RTP values of several ports
+*
+* @gh:              Handle to graph previously opened with xrtGraphOpen.
+* @updates:         ports by hierarchical name, values and sizes.
+* @count:           number of updates.
+*
+* Return:          0 on success, -1 on error.
+*/
+  int SwEmuShim::xrtGraphUpdateRTPs(void *gh, const xrt_core::graph_handle::rtp_update* updates, size_t count)
+  {
+    if (mLogStream.is_open())
+      mLogStream << __func__ << ", " << std::this_thread::get_id() << std::endl;
+
+    std::lock_guard lk(mApiMtx);
+    auto ghPtr = (xclswemuhal2::GraphType *)gh;
+    if (!ghPtr)
+      return -1;
+
+    auto graphhandle = ghPtr->getGraphHandle();
+    for (size_t i = 0; i < count; ++i) {
+      const auto& upd = updates[i];
+      DEBUG_MSGS("%s, %d(size: %zx hierPathPort: %s)\n", __func__, __LINE__, upd.size, upd.port);
+      xclGraphUpdateRTP_RPC_CALL(xclGraphUpdateRTP, graphhandle, upd.port, upd.buffer, upd.size);
+    }
+    PRINTENDFUNC
+    DEBUG_MSGS("%s, %d(Success and got the ack)\n", __func__, __LINE__);
+    return 0;
+  }
+
   /**
 * xrtGraphUpdateRTP() - Read RTP value of port with hierarchical name
 *
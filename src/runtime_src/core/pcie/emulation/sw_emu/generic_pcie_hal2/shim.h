@@ -39,9 +39,11 @@
 
 #include <atomic>
 #include <filesystem>
+#include <set>
 #include <thread>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #ifndef _WINDOWS
 #include <dlfcn.h>
@@ -170,7 +172,8 @@ namespace xclswemuhal2
       copy(const buffer_handle* src, size_t size, size_t dst_offset, size_t src_offset) override
       {
         auto bo_src = static_cast<const buffer_object*>(src);
-        m_shim->xclCopyBO(m_hdl, bo_src->get_handle(), size, dst_offset, src_offset);
+        if (m_shim->xclCopyBO(m_hdl, bo_src->get_handle(), size, dst_offset, src_offset))
+          throw xrt_core::system_error(EIO, "fail to copy bo");
       }
 
       properties
@@ -280,6 +283,8 @@ namespace xclswemuhal2
     {
       SwEmuShim* m_shim;
       xclGraphHandle m_xclGraphHandle;
+      // Resolved RTP ports, the simulator addresses ports by name
+      std::set<std::string> m_rtps;
 
     public:
       graph_object(SwEmuShim* shim, const xrt::uuid& uuid , const char* name, xrt::graph::access_mode am)
@@ -359,6 +364,38 @@ namespace xclswemuhal2
         if (auto ret = xclGraphReadRTP(m_xclGraphHandle, port, buffer, size))
           throw xrt_core::system_error(ret, "fail to read graph rtp");
       }
+
+      void*
+      resolve_graph_rtp(const char* port) override
+      {
+        auto& name = *m_rtps.insert(port).first;
+        return const_cast<std::string*>(&name);
+      }
+
+      void
+      update_resolved_graph_rtp(void* rtp, const char* buffer, size_t size) override
+      {
+        update_graph_rtp(static_cast<std::string*>(rtp)->c_str(), buffer, size);
+      }
+
+      void
+      read_resolved_graph_rtp(void* rtp, char* buffer, size_t size) override
+      {
+        read_graph_rtp(static_cast<std::string*>(rtp)->c_str(), buffer, size);
+      }
+
+      void
+      update_graph_rtps(const rtp_update* updates, size_t count) override
+      {
+        std::vector<rtp_update> named(updates, updates + count);
+        for (auto& upd : named) {
+          if (upd.rtp)
+            upd.port = static_cast<std::string*>(upd.rtp)->c_str();
+        }
+
+        if (auto ret = m_shim->xrtGraphUpdateRTPs(m_xclGraphHandle, named.data(), named.size()))
+          throw xrt_core::system_error(ret, "fail to update graph rtps");
+      }
     }; // graph_object
   public:
     static const unsigned TAG;
@@ -566,6 +603,21 @@ namespace xclswemuhal2
     int
     xrtGraphUpdateRTP(void *gh, const char *hierPathPort, const char *buffer, size_t size);
 
+    /**
+      * xrtGraphUpdateRTPs() - Update RTP values of several ports
+      *
+      * @gh:              Handle to graph previously opened with xrtGraphOpen.
+      * @updates:         ports by hierarchical name, values and sizes.
+      * @count:           number of updates.
+      *
+      * Return:          0 on success, -1 on error.
+      *
+      * Note: The updates are sent in order while holding the API lock
+      *       once, so no other API call is interleaved with the batch.
+      */
+    int
+    xrtGraphUpdateRTPs(void *gh, const xrt_core::graph_handle::rtp_update* updates, size_t count);
+
     /**
       * xrtGraphUpdateRTP() - Read RTP value of port with hierarchical name
       *
@@ -473,8 +473,6 @@ dev(std::shared_ptr<const drv> driver, std::string sysfs)
       m_driver->dev_node_prefix());
   }
 
-  sysfs_get<int>("", "userbar", err, m_user_bar, 0);
-  m_user_bar_size = bar_size(sysfs::dev_root + m_sysfs_name, m_user_bar);
   sysfs_get<bool>("", "ready", err, m_is_ready, false);
   m_user_bar_map = reinterpret_cast<char *>(MAP_FAILED);
 }
@@ -495,6 +493,12 @@ map_usr_bar() const
   if (m_user_bar_map != MAP_FAILED)
     return 0;
 
+  // BAR info is not needed for device enumeration, read on first use
+  std::ifstream ifs(sysfs::dev_root + m_sysfs_name + "/userbar");
+  if (!(ifs >> m_user_bar))
+    m_user_bar = 0;
+  m_user_bar_size = bar_size(sysfs::dev_root + m_sysfs_name, m_user_bar);
+
   int dev_handle = open("", O_RDWR);
   if (dev_handle < 0)
     return -errno;
@@ -75,8 +75,10 @@ public:
   uint16_t m_func =             INVALID_ID;
   uint32_t m_instance =         INVALID_ID;
   std::string m_sysfs_name;     // dir name under /sys/bus/pci/devices
-  int m_user_bar =              0;  // BAR mapped in by tools, default is BAR0
-  size_t m_user_bar_size =      0;
+  // BAR mapped in by tools, default is BAR0.  Read from sysfs when
+  // the BAR is first mapped, since most processes never map it.
+  mutable int m_user_bar =      0;
+  mutable size_t m_user_bar_size = 0;
   bool m_is_mgmt =              false;
   bool m_is_ready =             false;
 
@@ -2,7 +2,9 @@
 // Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
 
 #include "pcidrv.h"
+#include <algorithm>
 #include <filesystem>
+#include <future>
 
 namespace xrt_core { namespace pci {
 
@@ -22,24 +24,41 @@ scan_devices(std::vector<std::shared_ptr<dev>>& ready_list,
   std::vector<sfs::path> vec{ sfs::directory_iterator(drvpath), sfs::directory_iterator() };
   std::sort(vec.begin(), vec.end());
 
-  for (auto& path : vec) {
+  // Construction of a pcidev reads several sysfs nodes, which for
+  // many cards adds up to a noticeable part of process startup.
+  // Construct the devices in parallel, but insert them in sorted
+  // order so that device indices remain stable.
+  auto create = [this](const sfs::path& path) -> std::shared_ptr<dev> {
     try {
       auto pf = create_pcidev(path.filename().string());
 
       // In docker, all host sysfs nodes are available. So, we need to check
       // devnode to make sure the device is really assigned to docker.
       if (!sfs::exists(pf->get_subdev_path("", -1)))
-        continue;
+        return nullptr;
 
-      // Insert detected device into proper list.
-      if (pf->m_is_ready)
-        ready_list.push_back(std::move(pf));
-      else
-        nonready_list.push_back(std::move(pf));
+      return pf;
     }
-    catch (const std::invalid_argument& ex) {
-      continue;
+    catch (const std::invalid_argument&) {
+      return nullptr;
     }
+  };
+
+  std::vector<std::future<std::shared_ptr<dev>>> futures;
+  futures.reserve(vec.size());
+  for (auto& path : vec)
+    futures.push_back(std::async(vec.size() > 1 ? std::launch::async : std::launch::deferred, create, path));
+
+  for (auto& future : futures) {
+    auto pf = future.get();
+    if (!pf)
+      continue;
+
+    // Insert detected device into proper list.
+    if (pf->m_is_ready)
+      ready_list.push_back(std::move(pf));
+    else
+      nonready_list.push_back(std::move(pf));
   }
 }
 
@@ -10,6 +10,7 @@
 #include "pcidrv_xocl.h"
 #include "core/common/module_loader.h"
 #include "core/common/query_requests.h"
+#include "core/common/startup_timing.h"
 
 // 3rd Party Library - Include files
 #include <boost/algorithm/string/predicate.hpp>
@@ -155,6 +156,7 @@ system_linux()
   }
 
   for (const auto& driver : driver_list::get()) {
+    xrt_core::startup_timing::scope timer("enumerate " + driver->name() + " devices");
     if (driver->is_user())
       driver->scan_devices(user_ready_list, user_nonready_list);
     else
@@ -3,6 +3,7 @@
 #include "device_noop.h"
 #include "shim.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/query_requests.h"
 
 #include <string>
@@ -33,6 +34,18 @@ struct xclbin_slots
   }
 };
 
+// Device side copy is available when m2m is emulated
+struct m2m
+{
+  using result_type = xrt_core::query::m2m::result_type;
+
+  static result_type
+  get(const xrt_core::device*, key_type)
+  {
+    return xrt_core::config::get_emulate_m2m() ? 1 : 0;
+  }
+};
+
 static std::map<xrt_core::query::key_type, std::unique_ptr<xrt_core::query::request>> query_tbl;
 
 template <typename QueryRequestType, typename Getter>
@@ -62,6 +75,7 @@ initialize_query_table()
 {
   emplace_function0_getter<xrt_core::query::kds_cu_info,               kds_cu_info>();
   emplace_function0_getter<xrt_core::query::xclbin_slots,              xclbin_slots>();
+  emplace_function0_getter<xrt_core::query::m2m,                       m2m>();
 }
 
 struct X { X() { initialize_query_table(); }};
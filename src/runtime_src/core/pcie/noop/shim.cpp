@@ -17,17 +17,28 @@
 #include "core/common/device.h"
 #include "core/common/message.h"
 #include "core/common/system.h"
-#include "core/common/task.h"
 #include "core/common/thread.h"
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/hwctx_handle.h"
 
 #include "core/common/api/hw_context_int.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
 #include <mutex>
+#include <queue>
+#include <random>
+#include <shared_mutex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace { // private implementation details
 
@@ -57,41 +68,47 @@ struct bo
   { if (own) free(own); }
 };
 
-static std::mutex mutex;
-static unsigned int handle = 0;
-static std::map<unsigned int, std::unique_ptr<bo>> h2b;
+// Handles index the table directly and are recycled when freed.
+// Lookups are far more frequent than alloc and free and only take
+// a shared lock.
+static std::shared_mutex mutex;
+static std::vector<std::unique_ptr<bo>> h2b;
+static std::vector<unsigned int> free_handles;
 
-auto
-find(unsigned int handle)
+bo*
+get(unsigned int handle)
 {
-  std::lock_guard<std::mutex> lk(mutex);
-  auto itr = h2b.find(handle);
-  if (itr == h2b.end())
+  std::shared_lock lk(mutex);
+  if (handle >= h2b.size() || !h2b[handle])
     throw std::runtime_error("no such bo handle: " + std::to_string(handle));
-  return itr;
+  return h2b[handle].get();
 }
 
-bo*
-get(unsigned int handle)
+static unsigned int
+insert(std::unique_ptr<bo> bo)
 {
-  auto itr = find(handle);
-  return (*itr).second.get();
+  std::lock_guard lk(mutex);
+  if (free_handles.empty()) {
+    h2b.push_back(std::move(bo));
+    return static_cast<unsigned int>(h2b.size() - 1);
+  }
+
+  auto handle = free_handles.back();
+  free_handles.pop_back();
+  h2b[handle] = std::move(bo);
+  return handle;
 }
 
 unsigned int
 alloc(size_t size, unsigned int flags)
 {
-  std::lock_guard<std::mutex> lk(mutex);
-  h2b.insert(std::make_pair(handle, std::make_unique<bo>(size, flags)));
-  return handle++;
+  return insert(std::make_unique<bo>(size, flags));
 }
 
 unsigned int
 alloc(void* uptr, size_t size, unsigned int flags)
 {
-  std::lock_guard<std::mutex> lk(mutex);
-  h2b.insert(std::make_pair(handle, std::make_unique<bo>(uptr, size, flags)));
-  return handle++;
+  return insert(std::make_unique<bo>(uptr, size, flags));
 }
 
 void*
@@ -104,8 +121,15 @@ map(unsigned int handle)
 void
 free(unsigned int handle)
 {
-  auto itr = find(handle);
-  h2b.erase(itr);
+  std::unique_ptr<bo> bo;
+  {
+    std::lock_guard lk(mutex);
+    if (handle >= h2b.size() || !h2b[handle])
+      throw std::runtime_error("no such bo handle: " + std::to_string(handle));
+    bo = std::move(h2b[handle]);
+    free_handles.push_back(handle);
+  }
+  // host memory is released outside the lock
 }
 
 } // buffer
@@ -243,6 +267,15 @@ public:
     }
   }
 
+  // name of cu with given index, empty if no context is open on the cu
+  std::string
+  get_cu_name(uint32_t cuidx)
+  {
+    std::lock_guard lk(m_mutex);
+    auto itr = m_idx2cu.find(cuidx);
+    return itr == m_idx2cu.end() ? std::string{} : (*itr).second.name;
+  }
+
   xrt_core::query::kds_cu_info::result_type
   kds_cu_info()
   {
@@ -283,83 +316,419 @@ public:
 static std::vector<std::shared_ptr<pl::device>> s_devices;
 
 
-// Simulate asynchronous command completion.
+// Synthetic device model.
+//
+// Without any configuration commands complete immediately.  With only
+// Runtime.noop_completion_delay_us each command completes that long
+// after it was submitted.
+//
+// Otherwise each command is assigned a service time drawn from the
+// distribution configured for its CU (Runtime.noop_cu_service_time)
+// and scheduled on a model of the device: a CU executes one command at
+// a time and at most Runtime.noop_concurrent_cus CUs execute at once.
+// A completer thread marks commands complete at their modeled finish
+// time.  Random draws are seeded (Runtime.noop_seed) so a given
+// submission sequence is repeatable.
+//
+// sync_bo is modeled as one DMA engine per direction with a fixed
+// latency per transfer and a bandwidth (Runtime.noop_dma_*).  With
+// Runtime.emulate_m2m, device side buffer copies execute on a separate
+// m2m engine with the same latency and bandwidth.
 //
-// Command handles are added to a producer/consumer queue A worker
-// thread pretends to run the command and marks it complete only if
-// the command was enqueue some constant time before now.
+// Commands and transfers are logged to Runtime.noop_event_log if set.
 namespace cmd {
 
-static unsigned int completion_delay_us = 0;
-static xrt_core::task::queue running_queue;
-static std::thread completer;
-static std::atomic<uint64_t> completion_count {0};
+using clock = std::chrono::steady_clock;
 
-struct cmd_type
-{
-  xclBufferHandle handle;
-  unsigned long queue_time;
-  cmd_type(xclBufferHandle h)
-    : handle(h), queue_time(xrt_core::time_ns())
-  {}
-};
+// Final interval before a modeled finish time that is spun rather
+// than slept to keep short service times accurate
+constexpr auto spin_interval = std::chrono::microseconds(100);
 
+// Wait until given time point, sleep for most of it and spin for the
+// remainder
 static void
-init()
+wait_until(clock::time_point tp)
 {
-  if ( (completion_delay_us = xrt_core::config::get_noop_completion_delay_us()) )
-    completer = std::move(xrt_core::thread(xrt_core::task::worker, std::ref(running_queue)));
+  auto now = clock::now();
+  if (tp - now > spin_interval)
+    std::this_thread::sleep_until(tp - spin_interval);
+  while (clock::now() < tp) ;
 }
 
-static void
-stop()
+// Service time distribution, parameters in us
+struct distribution
 {
-  if (completion_delay_us) {
-    running_queue.stop();
-    completer.join();
+  enum class kind { constant, uniform, exponential, normal };
+  kind type = kind::constant;
+  double p1 = 0;
+  double p2 = 0;
+
+  std::chrono::nanoseconds
+  sample(std::mt19937_64& rng) const
+  {
+    double us = p1;
+    switch (type) {
+    case kind::constant:
+      break;
+    case kind::uniform:
+      us = std::uniform_real_distribution<double>(p1, p2)(rng);
+      break;
+    case kind::exponential:
+      us = p1 > 0 ? std::exponential_distribution<double>(1.0 / p1)(rng) : 0;
+      break;
+    case kind::normal:
+      us = std::normal_distribution<double>(p1, p2)(rng);
+      break;
+    }
+    return std::chrono::nanoseconds(static_cast<int64_t>(std::max(us, 0.0) * 1000));
   }
-}
+};
 
-static void
-wait()
+static distribution
+parse_distribution(const std::string& spec)
 {
-  while (!completion_count) ;
-  --completion_count;
-}
+  std::vector<std::string> tokens;
+  std::stringstream ss(spec);
+  for (std::string token; std::getline(ss, token, ':');)
+    tokens.push_back(token);
 
-static void
-mark_cmd_handle_complete(xclBufferHandle handle)
-{
-  //XRT_PRINTF("handle(%d) is complete\n", handle);
-  auto hbuf = buffer::map(handle);
-  auto cmd = reinterpret_cast<ert_packet*>(hbuf);
-  cmd->state = ERT_CMD_STATE_COMPLETED;
-  ++completion_count;
+  auto param = [&tokens, &spec](size_t idx) {
+    if (idx >= tokens.size())
+      throw xrt_core::error("Missing parameter in noop service time: " + spec);
+    return std::stod(tokens[idx]);
+  };
+
+  distribution dist;
+  if (tokens.empty())
+    throw xrt_core::error("Empty noop service time distribution");
+  else if (tokens[0] == "const")
+    dist = {distribution::kind::constant, param(1), 0};
+  else if (tokens[0] == "uniform")
+    dist = {distribution::kind::uniform, param(1), param(2)};
+  else if (tokens[0] == "exp")
+    dist = {distribution::kind::exponential, param(1), 0};
+  else if (tokens[0] == "normal")
+    dist = {distribution::kind::normal, param(1), param(2)};
+  else
+    throw xrt_core::error("Unknown noop service time distribution: " + spec);
+  return dist;
 }
 
-static void
-mark_cmd_complete(cmd_type ct)
+struct event
 {
-  while (xrt_core::time_ns() - ct.queue_time < completion_delay_us * 1000);
-  mark_cmd_handle_complete(ct.handle);
-}
+  const char* type;
+  std::string cu;
+  size_t bytes;
+  clock::time_point submit;
+  clock::time_point start;
+  clock::time_point end;
+};
 
-static void
-add(xclBufferHandle handle)
+struct completion
 {
-  if (completion_delay_us)
-    xrt_core::task::createF(running_queue, mark_cmd_complete, cmd_type(handle));
-  else
-    mark_cmd_handle_complete(handle);
-}
+  clock::time_point finish;
+  xclBufferHandle handle;
+
+  bool
+  operator>(const completion& rhs) const
+  {
+    return finish > rhs.finish;
+  }
+};
 
-struct X
+class device_model
 {
-  X() { init(); }
-  ~X() { stop(); }
+  std::mutex m_mutex;
+  std::condition_variable m_work;  // completer wakeup
+  std::condition_variable m_done;  // command completed
+  std::priority_queue<completion, std::vector<completion>, std::greater<>> m_pending;
+  uint64_t m_completed = 0;
+  bool m_stop = false;
+  std::thread m_completer;
+
+  // service time per cu name or index, "*" for any cu
+  std::map<std::string, distribution> m_service;
+  distribution m_default;
+  bool m_async = false;      // complete commands from completer thread
+  bool m_serialize = false;  // model cu occupancy and concurrency
+  std::mt19937_64 m_rng;
+
+  // cu occupancy per device and cu index
+  std::map<std::pair<const void*, uint32_t>, clock::time_point> m_cu_busy;
+  // concurrently executing cus, empty if unlimited
+  std::vector<clock::time_point> m_slots;
+
+  // dma engine per direction and m2m engine
+  enum engine { h2d, d2h, m2m, num_engines };
+  std::chrono::nanoseconds m_dma_latency {0};
+  double m_dma_ns_per_byte = 0;
+  clock::time_point m_dma_busy[num_engines];
+
+  std::string m_log_file;
+  std::vector<event> m_log;
+  clock::time_point m_epoch = clock::now();
+
+  static void
+  mark_cmd_handle_complete(xclBufferHandle handle)
+  {
+    auto hbuf = buffer::map(handle);
+    auto cmd = reinterpret_cast<ert_packet*>(hbuf);
+    cmd->state = ERT_CMD_STATE_COMPLETED;
+  }
+
+  void
+  completed()
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      ++m_completed;
+    }
+    m_done.notify_all();
+  }
+
+  void
+  completer()
+  {
+    std::unique_lock lk(m_mutex);
+    while (true) {
+      m_work.wait(lk, [this] { return m_stop || !m_pending.empty(); });
+      if (m_stop)
+        break;
+
+      auto next = m_pending.top();
+      auto now = clock::now();
+      if (now < next.finish - spin_interval) {
+        // a command finishing earlier may be submitted while waiting,
+        // submit notifies m_work and the earliest command is re-examined
+        m_work.wait_until(lk, next.finish - spin_interval);
+        continue;
+      }
+
+      if (now < next.finish) {
+        lk.unlock();
+        while (clock::now() < next.finish) ;
+        lk.lock();
+        continue;
+      }
+
+      m_pending.pop();
+      lk.unlock();
+      mark_cmd_handle_complete(next.handle);
+      completed();
+      lk.lock();
+    }
+  }
+
+  // index of first cu in the cu masks of a start command, -1 if none
+  static int
+  get_cuidx(const ert_packet* pkt)
+  {
+    if (pkt->opcode != ERT_START_CU && pkt->opcode != ERT_EXEC_WRITE && pkt->opcode != ERT_START_FA)
+      return -1;
+
+    auto skcmd = reinterpret_cast<const ert_start_kernel_cmd*>(pkt);
+    constexpr int bits = 32;
+    for (uint32_t i = 0; i <= skcmd->extra_cu_masks; ++i) {
+      uint32_t mask = (i == 0) ? skcmd->cu_mask : (&skcmd->cu_mask)[i];
+      for (int bit = 0; bit < bits; ++bit)
+        if (mask & (1u << bit))
+          return static_cast<int>(i) * bits + bit;
+    }
+    return -1;
+  }
+
+  const distribution&
+  get_distribution(const std::string& name, int cuidx)
+  {
+    auto itr = m_service.find(name);
+    if (itr == m_service.end())
+      itr = m_service.find(std::to_string(cuidx));
+    if (itr == m_service.end())
+      itr = m_service.find("*");
+    return itr == m_service.end() ? m_default : (*itr).second;
+  }
+
+  double
+  us(clock::time_point tp) const
+  {
+    return std::chrono::duration<double, std::micro>(tp - m_epoch).count();
+  }
+
+  void
+  write_log()
+  {
+    std::ofstream ofs(m_log_file);
+    ofs << "type,cu,bytes,submit_us,start_us,end_us\n";
+    for (const auto& ev : m_log)
+      ofs << ev.type << "," << ev.cu << "," << ev.bytes << ","
+          << us(ev.submit) << "," << us(ev.start) << "," << us(ev.end) << "\n";
+  }
+
+public:
+  device_model()
+    : m_rng(xrt_core::config::get_noop_seed())
+    , m_log_file(xrt_core::config::get_noop_event_log())
+  {
+    // Invalid entries are reported and ignored
+    std::stringstream ss(xrt_core::config::get_noop_cu_service_time());
+    for (std::string entry; std::getline(ss, entry, ',');) {
+      try {
+        auto pos = entry.find('=');
+        if (pos == std::string::npos)
+          throw xrt_core::error("Invalid noop service time: " + entry);
+        m_service[entry.substr(0, pos)] = parse_distribution(entry.substr(pos + 1));
+      }
+      catch (const std::exception& ex) {
+        xrt_core::message::send(xrt_core::message::severity_level::error, "XRT",
+                                std::string{"Ignoring noop service time '"} + entry + "': " + ex.what());
+      }
+    }
+
+    auto delay = xrt_core::config::get_noop_completion_delay_us();
+    m_default = {distribution::kind::constant, static_cast<double>(delay), 0};
+
+    auto concurrent = xrt_core::config::get_noop_concurrent_cus();
+    m_slots.resize(concurrent);
+
+    m_serialize = !m_service.empty() || concurrent;
+    m_async = m_serialize || delay;
+
+    constexpr double ns_per_s = 1e9;
+    constexpr double bytes_per_mb = 1e6;
+    if (auto bandwidth = xrt_core::config::get_noop_dma_bandwidth_mbps())
+      m_dma_ns_per_byte = ns_per_s / (bandwidth * bytes_per_mb);
+    m_dma_latency = std::chrono::microseconds(xrt_core::config::get_noop_dma_latency_us());
+
+    if (m_async)
+      m_completer = xrt_core::thread([this] { completer(); });
+  }
+
+  ~device_model()
+  {
+    if (m_async) {
+      {
+        std::lock_guard lk(m_mutex);
+        m_stop = true;
+      }
+      m_work.notify_all();
+      m_completer.join();
+    }
+
+    if (!m_log_file.empty()) {
+      try {
+        write_log();
+      }
+      catch (...) {
+      }
+    }
+  }
+
+  void
+  submit(xclBufferHandle handle, pl::device* pldev)
+  {
+    auto submit = clock::now();
+    if (!m_async && m_log_file.empty()) {
+      mark_cmd_handle_complete(handle);
+      completed();
+      return;
+    }
+
+    auto pkt = reinterpret_cast<const ert_packet*>(buffer::map(handle));
+    auto cuidx = get_cuidx(pkt);
+    auto name = (cuidx >= 0) ? pldev->get_cu_name(cuidx) : std::string{};
+
+    std::lock_guard lk(m_mutex);
+    auto start = submit;
+    auto finish = submit;
+    if (m_async) {
+      auto service = get_distribution(name, cuidx).sample(m_rng);
+      if (m_serialize) {
+        if (cuidx >= 0)
+          start = std::max(start, m_cu_busy[{pldev, cuidx}]);
+        auto slot = std::min_element(m_slots.begin(), m_slots.end());
+        if (slot != m_slots.end()) {
+          start = std::max(start, *slot);
+          *slot = start + service;
+        }
+        if (cuidx >= 0)
+          m_cu_busy[{pldev, cuidx}] = start + service;
+      }
+      finish = start + service;
+      m_pending.push({finish, handle});
+      m_work.notify_one();
+    }
+
+    if (!m_log_file.empty())
+      m_log.push_back({"cmd", name.empty() ? std::to_string(cuidx) : name, 0, submit, start, finish});
+
+    if (!m_async) {
+      mark_cmd_handle_complete(handle);
+      ++m_completed;
+      m_done.notify_all();
+    }
+  }
+
+  int
+  wait(int msec)
+  {
+    std::unique_lock lk(m_mutex);
+    auto pred = [this] { return m_completed > 0; };
+    if (msec > 0) {
+      if (!m_done.wait_for(lk, std::chrono::milliseconds(msec), pred))
+        return 0;
+    }
+    else
+      m_done.wait(lk, pred);
+
+    --m_completed;
+    return 1;
+  }
+
+  // Transfer size bytes on engine, returns when transfer is done
+  void
+  transfer(engine eng, size_t size)
+  {
+    if (!m_dma_latency.count() && m_dma_ns_per_byte == 0 && m_log_file.empty())
+      return;
+
+    static const char* names[num_engines] = {"h2d", "d2h", "m2m"};
+    auto submit = clock::now();
+    auto duration = m_dma_latency +
+      std::chrono::nanoseconds(static_cast<int64_t>(m_dma_ns_per_byte * static_cast<double>(size)));
+
+    clock::time_point finish;
+    {
+      std::lock_guard lk(m_mutex);
+      auto& busy = m_dma_busy[eng];
+      auto start = std::max(submit, busy);
+      finish = busy = start + duration;
+      if (!m_log_file.empty())
+        m_log.push_back({names[eng], "", size, submit, start, finish});
+    }
+    wait_until(finish);
+  }
+
+  void
+  dma(xclBOSyncDirection dir, size_t size)
+  {
+    transfer(dir == XCL_BO_SYNC_BO_TO_DEVICE ? h2d : d2h, size);
+  }
+
+  void
+  copy(size_t size)
+  {
+    transfer(m2m, size);
+  }
 };
 
-static X x;
+// Constructed on first use rather than at static initialization such
+// that configuration is read only when the noop shim is exercised
+static device_model&
+get_model()
+{
+  static device_model model;
+  return model;
+}
 
 } // cmd
 
@@ -438,9 +807,14 @@ struct shim
     }
 
     void
-    copy(const buffer_handle*, size_t, size_t, size_t) override
+    copy(const buffer_handle* src, size_t size, size_t dst_offset, size_t src_offset) override
     {
-      throw xrt_core::error(std::errc::not_supported, __func__);
+      if (!xrt_core::config::get_emulate_m2m())
+        throw xrt_core::error(std::errc::not_supported, __func__);
+
+      auto bo_src = static_cast<const buffer_object*>(src);
+      if (auto ret = m_shim->copy_bo(m_fd, bo_src->get_fd(), size, dst_offset, src_offset))
+        throw xrt_core::system_error(ret, "failed to copy bo");
     }
 
     properties
@@ -582,8 +956,25 @@ public:
   }
 
   int
-  sync_bo(buffer_handle_type, xclBOSyncDirection, size_t, size_t)
+  sync_bo(buffer_handle_type, xclBOSyncDirection dir, size_t size, size_t)
   {
+    cmd::get_model().dma(dir, size);
+    return 0;
+  }
+
+  // Emulated m2m copy, the device side of a noop buffer is its host
+  // side buffer
+  int
+  copy_bo(buffer_handle_type dst, buffer_handle_type src, size_t size, size_t dst_offset, size_t src_offset)
+  {
+    auto dst_bo = buffer::get(dst);
+    auto src_bo = buffer::get(src);
+    if (dst_offset + size > dst_bo->size || src_offset + size > src_bo->size)
+      return -EINVAL;
+
+    std::memmove(static_cast<char*>(dst_bo->hbuf) + dst_offset,
+                 static_cast<const char*>(src_bo->hbuf) + src_offset, size);
+    cmd::get_model().copy(size);
     return 0;
   }
 
@@ -609,15 +1000,14 @@ public:
   int
   exec_buf(buffer_handle_type handle)
   {
-    cmd::add(handle);
+    cmd::get_model().submit(handle, m_pldev);
     return 0;
   }
 
   int
   exec_wait(int msec)
   {
-    cmd::wait();
-    return 1;
+    return cmd::get_model().wait(msec);
   }
 
   int
@@ -894,6 +1284,11 @@ xclCopyBO(xclDeviceHandle handle, xclBufferHandle dstBoHandle,
           xclBufferHandle srcBoHandle, size_t size, size_t dst_offset,
           size_t src_offset)
 {
+  if (xrt_core::config::get_emulate_m2m()) {
+    auto shim = get_shim_object(handle);
+    return shim->copy_bo(dstBoHandle, srcBoHandle, size, dst_offset, src_offset);
+  }
+
   xrt_core::message::
     send(xrt_core::message::severity_level::debug, "XRT", "xclCopyBO() NOT IMPLEMENTED");
   return ENOSYS;
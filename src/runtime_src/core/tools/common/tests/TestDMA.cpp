@@ -11,6 +11,8 @@
 #include "dmatest.h"
 namespace XBU = XBUtilities;
 
+#include <boost/algorithm/string.hpp>
+
 
 constexpr uint64_t operator"" _gb(unsigned long long v)  { return 1024u * 1024u * 1024u * v; }
 
@@ -82,10 +84,61 @@ TestDMA::run(std::shared_ptr<xrt_core::device> dev)
       ptree.put("status", XBValidateUtils::test_token_failed);
       XBValidateUtils::logger(ptree, "Error", ex.what());
     }
+
+    if (!m_queue_depths.empty())
+      run_sweep(dev, ptree, static_cast<unsigned int>(midx), reinterpret_cast<const char*>(mem.m_tag), totalSize);
   }
   return ptree;
 }
 
+/*
+ * Sweep block sizes (4KB up to block-size in powers of 4) and queue
+ * depths.  Each point is added to the "dma_sweep" matrix of the test
+ * result.
+ */
+void
+TestDMA::run_sweep(const std::shared_ptr<xrt_core::device>& dev, boost::property_tree::ptree& ptree,
+                   unsigned int midx, const std::string& tag, size_t totalSize)
+{
+  std::vector<size_t> block_sizes;
+  for (size_t sz = 4 * 1024; sz < m_block_size; sz *= 4)
+    block_sizes.push_back(sz);
+  block_sizes.push_back(m_block_size);
+
+  boost::property_tree::ptree matrix = ptree.get_child("dma_sweep", boost::property_tree::ptree());
+  try {
+    xcldev::DMASweep sweep(dev, midx, totalSize);
+    for (auto dir : {XCL_BO_SYNC_BO_TO_DEVICE, XCL_BO_SYNC_BO_FROM_DEVICE}) {
+      for (auto block_size : block_sizes) {
+        for (auto depth : m_queue_depths) {
+          auto result = sweep.run(dir, block_size, depth);
+          boost::property_tree::ptree point;
+          point.put("memory", tag);
+          point.put("direction", dir == XCL_BO_SYNC_BO_TO_DEVICE ? "write" : "read");
+          point.put("block_size", result.blockSize);
+          point.put("queue_depth", result.queueDepth);
+          point.put("transfers", result.transfers);
+          point.put("bandwidth_mbps", result.bandwidth);
+          point.put("latency_avg_us", result.latencyAvg);
+          point.put("latency_p99_us", result.latencyP99);
+          matrix.push_back(std::make_pair("", point));
+
+          XBValidateUtils::logger(ptree, "Details", boost::str(boost::format(
+            "%s %s block size %s queue depth %d: %.1f MB/s, latency avg %.1f us p99 %.1f us")
+            % tag % (dir == XCL_BO_SYNC_BO_TO_DEVICE ? "write" : "read")
+            % xrt_core::utils::unit_convert(block_size) % depth
+            % result.bandwidth % result.latencyAvg % result.latencyP99));
+        }
+      }
+    }
+  }
+  catch (const xrt_core::error& ex) {
+    ptree.put("status", XBValidateUtils::test_token_failed);
+    XBValidateUtils::logger(ptree, "Error", ex.what());
+  }
+  ptree.put_child("dma_sweep", matrix);
+}
+
 /*
  * Pass in custom parameters for dma test
 */
@@ -103,5 +156,24 @@ TestDMA::set_param(const std::string key, const std::string value)
         throw xrt_core::error(std::errc::operation_canceled);
       }
   }
+  else if(key == "queue-depth") {
+    // Comma separated list of queue depths enables the dma sweep
+    m_queue_depths.clear();
+    std::vector<std::string> depths;
+    boost::split(depths, value, boost::is_any_of(","));
+    try {
+      for (const auto& depth : depths)
+        m_queue_depths.push_back(static_cast<size_t>(std::stoul(depth, nullptr, 0)));
+    }
+    catch (const std::exception&) {
+      m_queue_depths.clear();
+    }
+    if (m_queue_depths.empty() || std::find(m_queue_depths.begin(), m_queue_depths.end(), 0) != m_queue_depths.end()) {
+      std::cerr << boost::format(
+        "ERROR: The parameter '%s' value '%s' is invalid for the test '%s'. Please specify a comma separated list of queue depths greater than zero.'\n")
+        % "queue-depth" % value % "dma" ;
+      throw xrt_core::error(std::errc::operation_canceled);
+    }
+  }
   
 }
@@ -5,6 +5,7 @@
 #define __TestDMA_h_
 
 #include "tools/common/TestRunner.h"
+#include <vector>
 
 class TestDMA : public TestRunner {
   public:
@@ -15,7 +16,11 @@ class TestDMA : public TestRunner {
     TestDMA();
   
   private:
+    void run_sweep(const std::shared_ptr<xrt_core::device>& dev, boost::property_tree::ptree& ptree,
+                   unsigned int midx, const std::string& tag, size_t totalSize);
+
     size_t m_block_size = 16 * 1024 * 1024; //16MB
+    std::vector<size_t> m_queue_depths;      // dma sweep queue depths, empty if no sweep
 };
 
 #endif
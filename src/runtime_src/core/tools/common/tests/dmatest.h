@@ -5,11 +5,14 @@
 #ifndef DMATEST_H
 #define DMATEST_H
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <vector>
 #include <cstring>
 #include <iostream>
+#include <numeric>
 
 
 #include "core/common/device.h"
@@ -190,6 +193,103 @@ namespace xcldev {
             return validate();
         }
     };
+
+    // Bandwidth and latency of one point in a DMA sweep
+    struct DMAResult {
+        xclBOSyncDirection dir;
+        size_t blockSize;
+        size_t queueDepth;
+        size_t transfers;
+        double bandwidth;   // MB/s
+        double latencyAvg;  // us per transfer
+        double latencyP99;  // us per transfer
+    };
+
+    // DMA bandwidth and latency as a function of block size and number
+    // of outstanding transfers per DMA channel.
+    //
+    // Buffer sync is synchronous per call, so queueDepth outstanding
+    // transfers per channel are kept in flight by queueDepth submitting
+    // threads per channel, each owning its own buffer.
+    class DMASweep {
+        using buffer_and_deleter = std::pair<std::unique_ptr<xrt_core::buffer_handle>, xrt_core::aligned_ptr_type>;
+        std::shared_ptr<xrt_core::device> mHandle;
+        std::unique_ptr<xrt_core::hwctx_handle> mhwCtxHandle;
+        unsigned mFlags;
+        size_t mTotalSize;  // bytes transferred per sweep point
+        size_t mChannels;
+
+        static void runWorker(const buffer_and_deleter& bo, size_t size, xclBOSyncDirection dir,
+                              std::atomic<size_t>& next, size_t transfers, std::vector<long long>& latencies) {
+            while (next.fetch_add(1) < transfers) {
+                Timer timer;
+                try {
+                    bo.first->sync(static_cast<xrt_core::buffer_handle::direction>(dir), size, 0);
+                }
+                catch (const std::exception&) {
+                    throw xrt_core::error(-EIO, "DMA failed");
+                }
+                latencies.push_back(timer.stop());
+            }
+        }
+
+    public:
+        DMASweep(const std::shared_ptr<xrt_core::device>& handle, unsigned flags, size_t totalSize) :
+                mHandle(handle),
+                mFlags(flags),
+                mTotalSize(totalSize) {
+            auto dma_threads = xrt_core::device_query<xrt_core::query::dma_threads_raw>(mHandle);
+            if (dma_threads.empty())
+                throw xrt_core::error(-EINVAL, "Unable to determine number of DMA channels.");
+            mChannels = dma_threads.size();
+
+            mhwCtxHandle = mHandle->create_hw_context(mHandle->get_xclbin_uuid().get(), {}, xrt::hw_context::access_mode::shared);
+            xcl_bo_flags xflags{mFlags};
+            xflags.slot = static_cast<uint8_t>(mhwCtxHandle->get_slotidx());
+            mFlags = xflags.flags;
+        }
+
+        DMAResult run(xclBOSyncDirection dir, size_t blockSize, size_t queueDepth) const {
+            if (blockSize == 0 || queueDepth == 0)
+                throw xrt_core::error(-EINVAL, "DMA block size and queue depth must be greater than zero.");
+
+            auto workers = mChannels * queueDepth;
+            std::vector<buffer_and_deleter> bos;
+            for (size_t i = 0; i < workers; ++i) {
+                xrt_core::aligned_ptr_type buf = xrt_core::aligned_alloc(xrt_core::getpagesize(), blockSize);
+                auto bo = mhwCtxHandle->alloc_bo(buf.get(), blockSize, mFlags);
+                if (!bo)
+                    throw xrt_core::error(-ENOMEM, "No DMA buffers could be allocated.");
+                bos.emplace_back(std::move(bo), std::move(buf));
+            }
+
+            auto transfers = std::max(workers, mTotalSize / blockSize);
+            std::atomic<size_t> next{0};
+            std::vector<std::vector<long long>> latencies(workers);
+            std::vector<std::future<void>> threads;
+
+            Timer timer;
+            for (size_t i = 0; i < workers; ++i)
+                threads.push_back(std::async(std::launch::async, &DMASweep::runWorker, std::cref(bos[i]), blockSize,
+                                             dir, std::ref(next), transfers, std::ref(latencies[i])));
+            std::for_each(threads.begin(), threads.end(), [](std::future<void>& v) {v.get();});
+            auto elapsed = timer.stop();
+
+            std::vector<long long> all;
+            for (auto& l : latencies)
+                all.insert(all.end(), l.begin(), l.end());
+            std::sort(all.begin(), all.end());
+
+            DMAResult result{dir, blockSize, queueDepth, transfers, 0, 0, 0};
+            if (elapsed > 0)
+                result.bandwidth = static_cast<double>(transfers * blockSize) / 0x100000 / elapsed * 1000000;
+            if (!all.empty()) {
+                result.latencyAvg = static_cast<double>(std::accumulate(all.begin(), all.end(), 0LL)) / all.size();
+                result.latencyP99 = static_cast<double>(all[std::min(all.size() - 1, all.size() * 99 / 100)]);
+            }
+            return result;
+        }
+    };
 }
 
 #endif /* DMATEST_H */
@@ -3,39 +3,159 @@
 
 #include "replay.hpp"
 
+#include <fstream>
+#include <iostream>
+
 namespace xrt_core::tools::xbreplay {
 
 
+namespace {
+
+/*
+ * This function is used to check if given API is an ordering point
+ * between replay threads, i.e constructors, destructors and device calls.
+ */
+bool
+is_order_point(const std::string& api_id)
+{
+  auto paren = api_id.find('(');
+  auto name = api_id.substr(0, paren);
+  auto pos = name.rfind("::");
+  if (pos == std::string::npos || pos < 2)
+    return true;
+
+  auto method = name.substr(pos + 2);
+  auto cls_end = pos;
+  auto cls_pos = name.rfind("::", cls_end - 1);
+  auto cls = (cls_pos == std::string::npos) ? name.substr(0, cls_end)
+                                            : name.substr(cls_pos + 2, cls_end - cls_pos - 2);
+
+  return method == cls || method[0] == '~' || name.rfind("xrt::device::", 0) == 0;
+}
+
+const char*
+mode_to_string(replay_mode mode)
+{
+  switch (mode)
+  {
+    case replay_mode::timed:
+      return "timed";
+    case replay_mode::flat:
+      return "flat";
+    default:
+      return "sequential";
+  }
+}
+
+}
+
+/*
+ * This function returns the worker replaying calls of given thread,
+ * the worker is created on first use.
+ */
+replay_worker& replay_master::get_worker(uint64_t tid)
+{
+  if (m_options.m_mode == replay_mode::sequential)
+    tid = 0;
+
+  auto& worker = m_workers[tid];
+  if (!worker)
+  {
+    auto sync = (m_options.m_mode == replay_mode::sequential) ? nullptr : &m_sync;
+    worker = std::make_unique<replay_worker>(m_api, m_options.m_mode, sync, m_start, m_first_ts_ns);
+    worker->start();
+  }
+  return *worker;
+}
+
+/*
+ * This function assigns replay order to a call and forwards it to the
+ * worker of the thread which issued it in the trace.
+ */
+void replay_master::dispatch(std::shared_ptr<utils::message> msg)
+{
+  if (!m_seq)
+  {
+    m_start = std::chrono::steady_clock::now();
+    m_first_ts_ns = msg->m_ts_ns;
+  }
+
+  msg->m_seq = ++m_seq;
+  msg->m_is_order_point = is_order_point(msg->m_api_id);
+  msg->m_order_point = m_order_point;
+  if (msg->m_is_order_point)
+    m_order_point = msg->m_seq;
+
+  get_worker(msg->m_tid).send(std::move(msg));
+}
+
+/*
+ * This function prints and optionally saves the replay statistics.
+ */
+void replay_master::report()
+{
+  auto elapsed = std::chrono::steady_clock::now() - m_start;
+  auto elapsed_ns = m_seq ? static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) : 0;
+
+  utils::replay_stats stats;
+  for (const auto& worker : m_workers)
+    stats.merge(worker.second->get_stats());
+
+  if (m_options.m_report)
+  {
+    std::cout << "Replay mode: " << mode_to_string(m_options.m_mode)
+              << ", threads: " << m_workers.size() << "\n";
+    stats.print(std::cout, elapsed_ns);
+  }
+
+  if (!m_options.m_report_file.empty())
+  {
+    std::ofstream out(m_options.m_report_file);
+    if (!out)
+    {
+      XBREPLAY_ERROR("Failed to open report file: ", m_options.m_report_file);
+      return;
+    }
+    stats.write_json(out, mode_to_string(m_options.m_mode), elapsed_ns);
+  }
+}
+
 /**
  * This is replay master thread function, receives
  * command from seq reconstructor and forwards to
- * Replay worker thread.
+ * Replay worker threads.
  */
 void replay_master::replay_master_main()
 {
   XBREPLAY_INFO("Replay Master started");
 
-  /* start replay worker thread */
-  m_replay_worker.start();
-
-  bool loop = true;
-  while (loop)
+  while (true)
   {
     auto msg = m_in_msgq.receive();
-    if (msg->get_msgtype() != utils::message_type::stop_replay)
-    {
-      if (!msg_skip(msg))
-      {
-        /* send to worker thread */
-        m_out_msgq.send(msg);
-      }
-    }
-    else
-    {
-      m_out_msgq.send(msg);
+    if (msg->get_msgtype() == utils::message_type::stop_replay)
       break;
+
+    if (!msg_skip(msg))
+    {
+      /* send to worker thread */
+      dispatch(msg);
     }
   }
+
+  /* stop all workers and wait for outstanding calls to complete */
+  for (auto& worker : m_workers)
+  {
+    auto msg = std::make_shared<utils::message>();
+    msg->set_msgtype(utils::message_type::stop_replay);
+    worker.second->send(msg);
+  }
+
+  for (auto& worker : m_workers)
+    worker.second->th_join();
+
+  report();
+  m_api.clear_map();
   XBREPLAY_INFO("Replay Master Exited");
 }
 
@@ -50,29 +170,42 @@ void replay_worker::replay_worker_main()
   while (true)
   {
     auto msg = m_in_msgq.receive();
-    if (msg->get_msgtype() != utils::message_type::stop_replay)
+    if (msg->get_msgtype() == utils::message_type::stop_replay)
+      break;
+
+    /* honor the original gap from start of trace */
+    if (m_mode == replay_mode::timed && msg->m_ts_ns > m_first_ts_ns)
+      std::this_thread::sleep_until(m_start + std::chrono::nanoseconds(msg->m_ts_ns - m_first_ts_ns));
+
+    if (m_sync && !m_sync->wait(*msg))
+      break;
+
+    try
+    {
+      auto start = std::chrono::steady_clock::now();
+      m_api.invoke(msg);
+      auto end = std::chrono::steady_clock::now();
+      m_stats.record(msg->m_api_id, static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+    }
+    catch (const std::exception& e)
     {
-      try
-      {
-        m_api.invoke(msg);
-      }
-      catch (const std::exception& e)
-      {
-        XBREPLAY_ERROR("Exception occurred during API invocation: {}", e.what());
-        break;
-      }
-      catch (...)
-      {
-        XBREPLAY_ERROR("An unknown error occurred");
-        break;
-      }
+      XBREPLAY_ERROR("Exception occurred during API invocation: {}", e.what());
+      if (m_sync)
+        m_sync->abort();
+      break;
     }
-    else
+    catch (...)
     {
+      XBREPLAY_ERROR("An unknown error occurred");
+      if (m_sync)
+        m_sync->abort();
       break;
     }
+
+    if (m_sync)
+      m_sync->done(*msg);
   }
-  m_api.clear_map();
   XBREPLAY_INFO("Replay Worker Exited");
 }
 
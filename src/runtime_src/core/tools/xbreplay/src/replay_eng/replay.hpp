@@ -5,25 +5,125 @@
 
 #include "replay_xrt.hpp"
 #include "utils/message_queue.hpp"
+#include "utils/replay_stats.hpp"
 
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace xrt_core::tools::xbreplay {
 
+/*
+ * Replay modes
+ *  sequential - all calls are replayed in trace order from a single thread.
+ *  timed      - calls of each traced thread are replayed from a separate
+ *               thread honoring the original inter call gaps.
+ *  flat       - as timed but calls are issued back to back, to find the
+ *               maximum rate the captured traffic can be replayed at.
+ */
+enum class replay_mode { sequential, timed, flat };
+
+struct replay_options
+{
+  replay_mode m_mode = replay_mode::sequential;
+
+  /* Print per API latency and throughput once replay completes */
+  bool m_report = false;
+
+  /* Optional path to write the report as JSON */
+  std::string m_report_file;
+};
+
+/*
+ * Ordering between replay threads.
+ *
+ * Calls of different traced threads are only related through objects, an
+ * object must be created before and destroyed after all calls using it.
+ * Hence constructors, destructors and device level calls are treated as
+ * ordering points, an ordering point is replayed once every preceding call
+ * has completed and no call following it is replayed before it completes.
+ * Calls in between ordering points are replayed concurrently.
+ */
+class replay_sync
+{
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  uint64_t m_completed = 0;
+  uint64_t m_last_order_point = 0;
+  bool m_abort = false;
+
+  public:
+  /*
+   * This function blocks until given call can be replayed, returns
+   * false if replay is aborted.
+   */
+  bool wait(const utils::message& msg)
+  {
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this, &msg]
+    {
+      if (m_abort)
+        return true;
+      if (msg.m_is_order_point)
+        return m_completed + 1 >= msg.m_seq;
+      return m_last_order_point >= msg.m_order_point;
+    });
+    return !m_abort;
+  }
+
+  void done(const utils::message& msg)
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      ++m_completed;
+      if (msg.m_is_order_point)
+        m_last_order_point = msg.m_seq;
+    }
+    m_cv.notify_all();
+  }
+
+  void abort()
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      m_abort = true;
+    }
+    m_cv.notify_all();
+  }
+};
+
 /**
  * Replay worker class
  */
 class replay_worker
 {
-  utils::message_queue& m_in_msgq;
+  utils::message_queue m_in_msgq;
   std::thread m_replay_thrd;
-  replay_xrt m_api;
+  replay_xrt& m_api;
+  replay_mode m_mode;
+
+  /* Shared with other workers, null in sequential mode */
+  replay_sync* m_sync;
+
+  /* Replay start and trace time of first call, used in timed mode */
+  std::chrono::steady_clock::time_point m_start;
+  uint64_t m_first_ts_ns;
+
+  utils::replay_stats m_stats;
 
   public:
-  replay_worker(utils::message_queue& mqueues)
-  :m_in_msgq(mqueues)
+  replay_worker(replay_xrt& api, replay_mode mode, replay_sync* sync,
+                std::chrono::steady_clock::time_point start, uint64_t first_ts_ns)
+  : m_api(api)
+  , m_mode(mode)
+  , m_sync(sync)
+  , m_start(start)
+  , m_first_ts_ns(first_ts_ns)
   {}
 
   void replay_worker_main();
@@ -35,6 +135,16 @@ class replay_worker
     });
   }
 
+  void send(std::shared_ptr<utils::message> msg)
+  {
+    m_in_msgq.send(std::move(msg));
+  }
+
+  const utils::replay_stats& get_stats() const
+  {
+    return m_stats;
+  }
+
   void th_join()
   {
     m_replay_thrd.join();
@@ -59,13 +169,31 @@ class replay_master
   std::vector<std::pair<std::string, std::string>> m_api_skip;
 
   utils::message_queue& m_in_msgq;
-  utils::message_queue m_out_msgq;
   std::thread m_replay_thrd;
   uint64_t m_api_skip_flag_cnt;
 
   /* vector<pair<API_ID ,TID>>  */
   std::vector<std::pair<std::string, uint64_t>>m_api_skip_list;
-  replay_worker m_replay_worker;
+
+  replay_options m_options;
+
+  /* Objects replayed are shared by all workers */
+  replay_xrt m_api;
+  replay_sync m_sync;
+
+  /* Workers indexed by traced thread ID, single worker in sequential mode */
+  std::map<uint64_t, std::unique_ptr<replay_worker>> m_workers;
+
+  /* Sequence number of the last call and of the last ordering point */
+  uint64_t m_seq = 0;
+  uint64_t m_order_point = 0;
+
+  std::chrono::steady_clock::time_point m_start;
+  uint64_t m_first_ts_ns = 0;
+
+  replay_worker& get_worker(uint64_t tid);
+  void dispatch(std::shared_ptr<utils::message> msg);
+  void report();
 
   void init_api_skip_list()
   {
@@ -82,9 +210,9 @@ class replay_master
   }
 
   public:
-  replay_master(utils::message_queue& msg_q)
+  replay_master(utils::message_queue& msg_q, replay_options options)
   : m_in_msgq(msg_q)
-  , m_replay_worker(m_out_msgq)
+  , m_options(std::move(options))
   {
     m_api_skip_flag_cnt = 0;
     init_api_skip_list();
@@ -154,7 +282,6 @@ class replay_master
   void th_join()
   {
     m_replay_thrd.join();
-    m_replay_worker.th_join();
   }
 };
 }// end of namespace
@@ -10,8 +10,10 @@
 #include "xrt/experimental/xrt_ext.h"
 #include "xrt/deprecated/xrt.h"
 #include "xrt/detail/xclbin.h"
+#include "utils/handle_map.hpp"
 #include "utils/message.hpp"
 
+#include <atomic>
 #include <functional>
 #include <fstream>
 #include <iostream>
@@ -35,45 +37,45 @@ class replay_xrt
 {
   private:
   /*Map between handle from tracelog and device */
-  std::unordered_map<uint64_t, std::shared_ptr<xrt::device>> m_device_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xrt::device>> m_device_hndle_map;
 
   /*Map between handle from tracelog and kernel */
-  std::unordered_map<uint64_t, std::shared_ptr<xrt::kernel>> m_kernel_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xrt::kernel>> m_kernel_hndle_map;
 
   /*Map between handle from tracelog and xcldevice handle */
-  std::unordered_map<uint64_t, std::shared_ptr<xclDeviceHandle>> m_xcldev_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xclDeviceHandle>> m_xcldev_hndle_map;
 
   /*Map between handle from tracelog and xcldevice handle */
-  std::unordered_map<uint64_t, std::shared_ptr<xclBufferExportHandle>> m_xclBufExp_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xclBufferExportHandle>> m_xclBufExp_hndle_map;
 
   /*Map between handle from tracelog and xcldevice handle */
-  std::unordered_map<uint64_t, std::shared_ptr<axlf>> m_axlf_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<axlf>> m_axlf_hndle_map;
 
   /*Map between handle from  tracelog and xcldevice handle */
-  std::unordered_map<uint64_t, std::shared_ptr<xrt::hw_context>> m_hwctx_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xrt::hw_context>> m_hwctx_hndle_map;
 
   /*Map between handle from log and run */
-  std::unordered_map<uint64_t, std::shared_ptr<xrt::run>> m_run_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xrt::run>> m_run_hndle_map;
 
   /*Map between handle from log and bo */
-  std::unordered_map<uint64_t, std::shared_ptr<xrt::bo>> m_bo_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xrt::bo>> m_bo_hndle_map;
 
   /*Map between handle from log and bo */
-  std::unordered_map<uint64_t, std::shared_ptr<xrt::xclbin>> m_xclbin_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xrt::xclbin>> m_xclbin_hndle_map;
 
   /*Map between group id */
-  std::unordered_map<uint64_t, xrt::memory_group> m_kernel_grp_id;
+  utils::handle_map<uint64_t, xrt::memory_group> m_kernel_grp_id;
 
   /* Map betgween uuid & device handle */
-  std::unordered_map<std::shared_ptr<xrt::device>, xrt::uuid> m_uuid_device_map;
+  utils::handle_map<std::shared_ptr<xrt::device>, xrt::uuid> m_uuid_device_map;
 
   std::map <std::string, std::function < void (std::shared_ptr<utils::message>)>> m_api_map;
 
   /*Map between handle from log and xrt::module */
-  std::unordered_map<uint64_t, std::shared_ptr<xrt::module>> m_module_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xrt::module>> m_module_hndle_map;
 
   /*Map between handle from log and xrt::elf */
-  std::unordered_map<uint64_t, std::shared_ptr<xrt::elf>> m_elf_hndle_map;
+  utils::handle_map<uint64_t, std::shared_ptr<xrt::elf>> m_elf_hndle_map;
 
   /* Registers device class API's */
   void register_device_class_func();
@@ -144,10 +146,14 @@ class replay_xrt
    */
   void invoke (std::shared_ptr<utils::message> msg)
   {
-    if (m_api_map.find (msg->m_api_id) != m_api_map.end ())
+    /* The API map is read only once constructed, lookup without
+     * modifying it since workers may invoke concurrently.
+     */
+    auto it = m_api_map.find(msg->m_api_id);
+    if (it != m_api_map.end())
     {
       msg->print_args();
-      m_api_map[msg->m_api_id] (msg);
+      it->second(msg);
     }
     else
     {
@@ -179,7 +185,7 @@ class replay_xrt
   std::string save_buf_to_file(std::shared_ptr<utils::message> msg, std::string file_ext)
   {
     /* To create unique file name */
-    static uint64_t i = 0;
+    static std::atomic<uint64_t> i = 0;
 
     // Define the file path
     std::filesystem::path currentpath = std::filesystem::current_path();
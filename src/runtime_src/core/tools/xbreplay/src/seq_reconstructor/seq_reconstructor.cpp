@@ -3,25 +3,13 @@
 
 #include "seq_reconstructor.hpp"
 
+#include <algorithm>
+#include <map>
 #include <tuple>
 
 namespace xrt_core::tools::xbreplay {
 
-/**
- * This function is used to find the line attributes such as
- *  TID, PID, API_ID etc. of entry/exit marker lines.
- */
-std::string
-find_attribute(const std::string& line, uint8_t offset, const std::string& pattern)
-{
-  std::regex Regex(pattern);
-  std::smatch match;
-
-  if (std::regex_search(line, match, Regex))
-    return match[offset].str();
-
-  return "";
-}
+namespace binfmt = xrt::tools::xbtracer::binfmt;
 
 /**
  * This function is used to retrive Entry/Exit Marker line attributes which
@@ -30,17 +18,25 @@ find_attribute(const std::string& line, uint8_t offset, const std::string& patte
  *
  */
 std::tuple<std::string, std::string, std::string>
-get_line_attributes(const std::string& line, const std::string& regex_pattern)
+get_line_attributes(const std::string& line, const std::regex& pattern)
 {
   /* TID, handle, API ID */
   std::tuple<std::string, std::string, std::string> entry_id = {};
 
+  /* All attributes are retrieved from a single match */
+  std::smatch match;
+  if (!std::regex_search(line, match, pattern))
+  {
+    XBREPLAY_WARN("Failed to find API ID", line);
+    return entry_id;
+  }
+
   /* update TID */
-  std::get<0>(entry_id) = find_attribute(line, utils::match_idx_tid, regex_pattern);
+  std::get<0>(entry_id) = match[utils::match_idx_tid].str();
 
   /* Update handle */
-  std::get<1>(entry_id) = find_attribute(line, utils::match_idx_handle, regex_pattern);
-  std::string api = find_attribute(line, utils::match_idx_api, regex_pattern);
+  std::get<1>(entry_id) = match[utils::match_idx_handle].str();
+  std::string api = match[utils::match_idx_api].str();
   std::string api_id;
 
   size_t pos = api.find(")");
@@ -64,69 +60,246 @@ get_line_attributes(const std::string& line, const std::string& regex_pattern)
 void xrt_seq_reconstructor::start_reconstruction()
 {
   XBREPLAY_INFO("th:Seq Reconstruction start");
-  std::string line;
   m_replay_master.start();
 
   try
   {
-    while (std::getline(m_trace_file, line))
-    {
-      std::pair<std::string, std::string> trace = {};
+    if (m_trace_map)
+      reconstruct_binary();
+    else
+      reconstruct_text();
+  }
+  catch (const std::runtime_error& e)
+  {
+    XBREPLAY_ERROR("Runtime error: ", e.what());
+  }
+
+  auto msg = std::make_shared<utils::message>();
+  msg->set_msgtype(utils::message_type::stop_replay);
+  m_msgq.send(msg);
 
-      /* Save current position */
-      std::streampos cur_pos = m_trace_file.tellg();
+  XBREPLAY_INFO("th:Seq Reconstruction exit");
+}
 
-      if (line.find("ENTRY") != std::string::npos)
+/*
+ * Reconstructs the sequence from a text trace.
+ */
+void xrt_seq_reconstructor::reconstruct_text()
+{
+  static const std::regex entry_pattern(utils::regex_entry_pattern);
+  static const std::regex exit_pattern(utils::regex_exit_pattern);
+  std::string line;
+
+  while (std::getline(m_trace_file, line))
+  {
+    std::pair<std::string, std::string> trace = {};
+
+    /* Save current position */
+    std::streampos cur_pos = m_trace_file.tellg();
+
+    if (line.find("ENTRY") != std::string::npos)
+    {
+      /* store the Entry marker*/
+      trace.first = line;
+      auto entry_id = get_line_attributes(line, entry_pattern);
+      bool exit_found = false;
+      while (std::getline(m_trace_file, line))
       {
-        /* store the Entry marker*/
-        trace.first = line;
-        auto entry_id = get_line_attributes(line, utils::regex_entry_pattern);
-        bool exit_found = false;
-        while (std::getline(m_trace_file, line))
+        if (line.find("EXIT") != std::string::npos)
         {
-          if (line.find("EXIT") != std::string::npos)
+          auto exit_id = get_line_attributes(line, exit_pattern);
+          if (exit_id == entry_id)
           {
-            auto exit_id = get_line_attributes(line, utils::regex_exit_pattern);
-            if (exit_id == entry_id)
-            {
-               /* found match, send to replay master */
-               trace.second = line;
-               exit_found = true;
-               break;
-            }
+             /* found match, send to replay master */
+             trace.second = line;
+             exit_found = true;
+             break;
           }
-          else
-            continue;
         }
-        if (!exit_found)
-          XBREPLAY_ERROR("Cannot find exit line for entry:", trace.first);
+        else
+          continue;
+      }
+      if (!exit_found)
+        XBREPLAY_ERROR("Cannot find exit line for entry:", trace.first);
+
+      auto msg = std::make_shared<utils::message>(trace, m_mem_file_path,
+                    m_is_mem_file_available);
+
+      if (msg->is_success())
+        m_msgq.send(msg);
+      else
+        throw std::runtime_error("Failed to send message: Invalid line\n" +
+                    trace.first + "\n" + trace.second);
+    }
+
+    /* While searching entry and corresponding exit the file seek postion has
+     * moved, we need to set it back to the right starting point.
+     */
+    m_trace_file.seekg(cur_pos);
+  } /* end of  while loop */
+}
+
+/*
+ * Decodes a memory mapped binary trace. Exit records are matched to
+ * their entry in a single pass, innermost call first for calls with the
+ * same thread, handle and API.
+ */
+bin_trace decode_bin_trace(const char* data, size_t size)
+{
+  binfmt::reader rd(data, size);
+  bin_trace trace;
+
+  uint64_t ver = 0;
+  if (!rd.get_preamble(ver) || ver != binfmt::version)
+    throw std::runtime_error("Unsupported binary trace version");
 
-        auto msg = std::make_shared<utils::message>(trace, m_mem_file_path,
-                      m_is_mem_file_available);
+  /* (tid, handle, api) -> entries waiting for their exit */
+  std::map<std::tuple<uint64_t, uint64_t, uint64_t>, std::vector<size_t>> pending;
+  binfmt::record tag = {};
 
-        if (msg->is_success())
-          m_msgq.send(msg);
+  while (rd.get_tag(tag))
+  {
+    bool ok = true;
+    switch (tag)
+    {
+      case binfmt::record::header:
+      {
+        uint64_t start_ns = 0;
+        std::string_view os;
+        ok = rd.get_varint(trace.m_pid) && rd.get_varint(start_ns)
+          && rd.get_string(trace.m_pname) && rd.get_string(trace.m_xrt_ver)
+          && rd.get_string(os) && rd.get_string(trace.m_start_time);
+        trace.m_os = os;
+        break;
+      }
+      case binfmt::record::api_name:
+      {
+        uint64_t id = 0;
+        std::string_view name;
+        ok = rd.get_varint(id) && rd.get_string(name) && id == trace.m_apis.size();
+        trace.m_apis.push_back(name);
+        break;
+      }
+      case binfmt::record::entry:
+      case binfmt::record::exit:
+      {
+        utils::trace_record rec;
+        ok = rd.get_varint(rec.m_ts_ns) && rd.get_varint(rec.m_tid)
+          && rd.get_varint(rec.m_handle) && rd.get_varint(rec.m_api)
+          && rd.get_string(rec.m_detail) && rec.m_api < trace.m_apis.size();
+        if (!ok)
+          break;
+
+        auto key = std::make_tuple(rec.m_tid, rec.m_handle, rec.m_api);
+        if (tag == binfmt::record::entry)
+        {
+          pending[key].push_back(trace.m_entries.size());
+          trace.m_entries.push_back(rec);
+          trace.m_exits.push_back(utils::trace_record{});
+          trace.m_has_exit.push_back(false);
+        }
         else
-          throw std::runtime_error("Failed to send message: Invalid line\n" +
-                      trace.first + "\n" + trace.second);
+        {
+          auto it = pending.find(key);
+          if (it == pending.end() || it->second.empty())
+          {
+            XBREPLAY_WARN("Exit record without entry: ", std::string(trace.m_apis[rec.m_api]));
+            break;
+          }
+          auto idx = it->second.back();
+          it->second.pop_back();
+          trace.m_exits[idx] = rec;
+          trace.m_has_exit[idx] = true;
+        }
+        break;
       }
+      case binfmt::record::end:
+        ok = rd.get_string(trace.m_end_time);
+        break;
+      default:
+        ok = false;
+        break;
+    }
 
-      /* While searching entry and corresponding exit the file seek postion has
-       * moved, we need to set it back to the right starting point.
-       */
-      m_trace_file.seekg(cur_pos);
-    } /* end of  while loop */
+    if (!ok)
+    {
+      /* A trace of a program that crashed can be truncated */
+      XBREPLAY_WARN("Truncated or invalid binary trace record, stop parsing");
+      break;
+    }
   }
-  catch (const std::runtime_error& e)
+  return trace;
+}
+
+/*
+ * Reconstructs the sequence from a binary trace.
+ */
+void xrt_seq_reconstructor::reconstruct_binary()
+{
+  auto trace = decode_bin_trace(m_trace_map->data(), m_trace_map->size());
+
+  for (size_t idx = 0; idx < trace.m_entries.size(); ++idx)
   {
-    XBREPLAY_ERROR("Runtime error: ", e.what());
+    const auto& entry = trace.m_entries[idx];
+    const auto* exit = trace.m_has_exit[idx] ? &trace.m_exits[idx] : nullptr;
+    auto msg = std::make_shared<utils::message>(entry, exit, trace.m_apis[entry.m_api],
+                  m_mem_file_path, m_is_mem_file_available);
+
+    if (msg->is_success())
+      m_msgq.send(msg);
+    else
+      throw std::runtime_error("Failed to send message: Invalid record for " +
+                  std::string(trace.m_apis[entry.m_api]));
   }
+}
 
-  auto msg = std::make_shared<utils::message>();
-  msg->set_msgtype(utils::message_type::stop_replay);
-  m_msgq.send(msg);
+/*
+ * Writes a binary trace as an equivalent text trace.
+ */
+void export_text_trace(const std::string& bin_file, const std::string& text_file)
+{
+  constexpr uint64_t giga = 1000000000UL;
+  constexpr int fw_9 = 9;
 
-  XBREPLAY_INFO("th:Seq Reconstruction exit");
+  utils::mapped_file map(bin_file);
+  if (!binfmt::reader::is_binary(map.data(), map.size()))
+    throw std::runtime_error("Not a binary trace: " + bin_file);
+
+  std::ofstream ofs(text_file);
+  if (!ofs.is_open())
+    throw std::runtime_error("Failed to open output file: " + text_file);
+
+  auto trace = decode_bin_trace(map.data(), map.size());
+
+  ofs << "|HEADER|pname:\"" << trace.m_pname << "\"|m_pid:" << trace.m_pid
+      << "|xrt_ver:" << trace.m_xrt_ver << "|os:" << trace.m_os << "|time:"
+      << trace.m_start_time << "|\n";
+  ofs << "|START|" << trace.m_start_time << "|\n";
+
+  /* Entries and exits interleaved in time order */
+  std::vector<std::pair<const utils::trace_record*, bool>> recs;
+  recs.reserve(trace.m_entries.size() * 2);
+  for (size_t idx = 0; idx < trace.m_entries.size(); ++idx)
+  {
+    recs.emplace_back(&trace.m_entries[idx], true);
+    if (trace.m_has_exit[idx])
+      recs.emplace_back(&trace.m_exits[idx], false);
+  }
+  std::stable_sort(recs.begin(), recs.end(), [](const auto& a, const auto& b)
+  {
+    return a.first->m_ts_ns < b.first->m_ts_ns;
+  });
+
+  for (const auto& [rec, is_entry] : recs)
+  {
+    ofs << (is_entry ? "|ENTRY|" : "|EXIT|") << rec->m_ts_ns / giga << "."
+        << std::setfill('0') << std::setw(fw_9) << rec->m_ts_ns % giga << "|"
+        << trace.m_pid << "|" << rec->m_tid << "|0x" << std::hex << rec->m_handle
+        << std::dec << "|" << trace.m_apis[rec->m_api] << rec->m_detail << "|\n";
+  }
+
+  if (!trace.m_end_time.empty())
+    ofs << "|END|" << trace.m_end_time << "|\n";
 }
 
 }// end of namespace
@@ -4,16 +4,47 @@
 #pragma once
 
 #include "replay.hpp"
+#include "trace_format.h"
+#include "utils/mapped_file.hpp"
 #include "utils/message_queue.hpp"
 
 #include <fstream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
 namespace xrt_core::tools::xbreplay {
 
+/**
+ * Decoded binary trace, strings point into the mapped trace file.
+ * Exit records are stored at the index of their matching entry.
+ */
+struct bin_trace
+{
+  uint64_t m_pid = 0;
+  std::string_view m_pname;
+  std::string_view m_xrt_ver;
+  std::string_view m_os;
+  std::string_view m_start_time;
+  std::string_view m_end_time;
+  std::vector<std::string_view> m_apis;
+  std::vector<utils::trace_record> m_entries;
+  std::vector<utils::trace_record> m_exits;
+  std::vector<bool> m_has_exit;
+};
+
+/*
+ * This function is used to decode binary trace generated by xbtracer.
+ */
+bin_trace decode_bin_trace(const char* data, size_t size);
+
+/*
+ * This function is used to convert binary trace to text trace.
+ */
+void export_text_trace(const std::string& bin_file, const std::string& text_file);
+
 /**
  * Sequence Reconstructor  abstract class
  */
@@ -39,6 +70,12 @@ class xrt_seq_reconstructor : public seq_reconstructor
   utils::message_queue m_msgq;
   replay_master m_replay_master;
 
+  /* Set when the input is a binary trace */
+  std::unique_ptr<utils::mapped_file> m_trace_map;
+
+  void reconstruct_text();
+  void reconstruct_binary();
+
   public:
   bool m_is_mem_file_available;
   std::string m_mem_file_path;
@@ -53,13 +90,25 @@ class xrt_seq_reconstructor : public seq_reconstructor
 
   /* constructor */
   xrt_seq_reconstructor(const std::string &trace_file_path,
-                        const std::string &mem_dmp_file_path)
-      : m_replay_master(m_msgq)
+                        const std::string &mem_dmp_file_path,
+                        const replay_options &options)
+      : m_replay_master(m_msgq, options)
   {
-    m_trace_file.open(trace_file_path.c_str());
+    /* Binary traces are memory mapped, text traces are read line by line */
+    auto map = std::make_unique<utils::mapped_file>(trace_file_path);
+    if (xrt::tools::xbtracer::binfmt::reader::is_binary(map->data(), map->size()))
+    {
+      XBREPLAY_INFO("Binary trace file detected");
+      m_trace_map = std::move(map);
+    }
+    else
+    {
+      map.reset();
+      m_trace_file.open(trace_file_path.c_str());
 
-    if (!m_trace_file.is_open())
-      throw std::runtime_error("Failed to open input file: " + trace_file_path);
+      if (!m_trace_file.is_open())
+        throw std::runtime_error("Failed to open input file: " + trace_file_path);
+    }
 
     if (!mem_dmp_file_path.empty())
     {
@@ -100,9 +149,10 @@ class seq_reconstructor_factory
   public:
   std::shared_ptr<seq_reconstructor>
   create_seq_recon(const std::string &tracer_file,
-                   const std::string &dump_file)
+                   const std::string &dump_file,
+                   const replay_options &options = {})
   {
-    return std::make_shared<xrt_seq_reconstructor>(tracer_file, dump_file);
+    return std::make_shared<xrt_seq_reconstructor>(tracer_file, dump_file, options);
   }
 };
 
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+namespace xrt_core::tools::xbreplay::utils {
+
+/*
+ * Map between handles from the trace log and replayed objects.
+ *
+ * The map is shared by all replay worker threads, the map itself is
+ * protected by a lock.  Returned references stay valid across inserts
+ * since unordered_map never relocates its elements, objects of a given
+ * handle are only accessed by the thread replaying calls on that handle.
+ */
+template <typename Key, typename Value>
+class handle_map
+{
+  std::unordered_map<Key, Value> m_map;
+  mutable std::mutex m_mutex;
+
+  public:
+  Value& operator[](const Key& key)
+  {
+    std::lock_guard lock(m_mutex);
+    return m_map[key];
+  }
+
+  size_t erase(const Key& key)
+  {
+    std::lock_guard lock(m_mutex);
+    return m_map.erase(key);
+  }
+
+  void clear()
+  {
+    std::lock_guard lock(m_mutex);
+    m_map.clear();
+  }
+};
+
+}// end of namespace
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace xrt_core::tools::xbreplay::utils {
+
+/*
+ * Read only memory mapping of a complete file.
+ */
+class mapped_file
+{
+  public:
+  mapped_file() = default;
+
+  explicit mapped_file(const std::string& path)
+  {
+#ifdef _WIN32
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+      fail("Failed to open input file: " + path);
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size))
+      fail("Failed to get size of file: " + path);
+
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (!m_size)
+      return;
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+      fail("Failed to map file: " + path);
+
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0)
+      fail("Failed to open input file: " + path);
+
+    struct stat st = {};
+    if (fstat(m_fd, &st) < 0)
+      fail("Failed to get size of file: " + path);
+
+    m_size = static_cast<size_t>(st.st_size);
+    if (!m_size)
+      return;
+
+    void* addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (addr == MAP_FAILED)
+      fail("Failed to map file: " + path);
+
+    // The trace is parsed front to back exactly once
+    madvise(addr, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(addr);
+#endif
+    if (!m_data)
+      fail("Failed to map file: " + path);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  ~mapped_file()
+  {
+    release();
+  }
+
+  const char* data() const
+  {
+    return m_data;
+  }
+
+  size_t size() const
+  {
+    return m_size;
+  }
+
+  private:
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  HANDLE m_file = INVALID_HANDLE_VALUE;
+  HANDLE m_mapping = nullptr;
+#else
+  int m_fd = -1;
+#endif
+
+  void release()
+  {
+#ifdef _WIN32
+    if (m_data)
+      UnmapViewOfFile(m_data);
+    if (m_mapping)
+      CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE)
+      CloseHandle(m_file);
+#else
+    if (m_data)
+      munmap(const_cast<char*>(m_data), m_size);
+    if (m_fd >= 0)
+      close(m_fd);
+#endif
+  }
+
+  [[noreturn]] void fail(const std::string& msg)
+  {
+    release();
+    throw std::runtime_error(msg);
+  }
+};
+
+}// end of namespace
@@ -15,6 +15,19 @@ void trim_spaces(std::string& entry)
   }).base(), entry.end());
 }
 
+/*
+ * This function is used to convert "<sec>.<nsec>" trace time to nanoseconds
+ */
+uint64_t time_to_ns(const std::string& time)
+{
+  constexpr uint64_t giga = 1000000000UL;
+  auto pos = time.find('.');
+  if (pos == std::string::npos)
+    return 0;
+
+  return std::stoull(time.substr(0, pos)) * giga + std::stoull(time.substr(pos + 1));
+}
+
 /*
  * This function is used to retrive arguments from given string.
  */
@@ -43,6 +56,11 @@ replay_status message::update_args(const std::pair <std::string&, std::string&>
   uint32_t i = 0;
   for (auto &arg : m_args)
   {
+    if (i >= val.size())
+    {
+      XBREPLAY_WARN("Missing value for argument: ", arg.first);
+      break;
+    }
     std::string& arg_value = val[i];
     trim_spaces(arg_value);
     arg.second = arg_value;
@@ -59,7 +77,7 @@ replay_status message::update_args(const std::pair <std::string&, std::string&>
 void message::rmv_return_type(std::string& str)
 {
   /* Regular expression to match function signature (excluding return type)*/
-  std::regex pattern(regex_func_pattern);
+  static const std::regex pattern(regex_func_pattern);
 
   /* Check if the input string contains a function signature */
   std::smatch match;
@@ -96,7 +114,7 @@ replay_status message::decode_args(const std::string& line)
 
   if (line.find("...") != std::string::npos)
   {
-    std::regex pattern(regex_decode_args_pattern);
+    static const std::regex pattern(regex_decode_args_pattern);
     std::smatch matches;
     if (std::regex_search(line, matches, pattern))
     {
@@ -134,8 +152,8 @@ replay_status message::decode_args(const std::string& line)
       *        update the values.
       *
       */
-    std::regex regexFirst(regex_args_type_pattern);
-    std::regex regexSecond(regex_args_value_pattern);
+    static const std::regex regexFirst(regex_args_type_pattern);
+    static const std::regex regexSecond(regex_args_value_pattern);
 
     std::smatch match_firstline, match_secondline;
 
@@ -170,9 +188,12 @@ replay_status message::decode_entry_line(const std::string& line)
    * Entry trace marker is of below format and correspondigly update regex
    * ENTRY <number> <number> <number> <hex-value> ClassName::MethodName(arguments).
    **/
-  std::regex pattern(regex_entry_pattern);
+  static const std::regex pattern(regex_entry_pattern);
   if (std::regex_search(line, match, pattern))
   {
+    /* get entry time */
+    m_ts_ns = time_to_ns(match[match_idx_time]);
+
     /* get thread ID */
     m_tid = std::stoul(match[match_idx_tid], nullptr, base_hex);
 
@@ -314,7 +335,7 @@ void message::load_user_data(const uint32_t offset, std::vector<char>* user_data
  */
 replay_status message::decode_exit_line(const std::string& line)
 {
-  std::regex pattern(regex_exit_pattern);
+  static const std::regex pattern(regex_exit_pattern);
   std::smatch match;
   replay_status estatus = replay_status::success;
 
@@ -322,7 +343,10 @@ replay_status message::decode_exit_line(const std::string& line)
   {
     std::string mem_tag = match[match_idx_memtag].str();
 
-    std::regex return_val_pattern(regex_ret_val_pattern);
+    auto exit_ns = time_to_ns(match[match_idx_time]);
+    m_duration_ns = exit_ns > m_ts_ns ? exit_ns - m_ts_ns : 0;
+
+    static const std::regex return_val_pattern(regex_ret_val_pattern);
     std::smatch ret_match;
     const std::string& api = match[match_idx_api].str();
     const std::string substr = ")=";
@@ -354,5 +378,80 @@ replay_status message::decode_exit_line(const std::string& line)
   return estatus;
 }
 
+/*
+ * This function is used to decode binary trace entry record.
+ * The API name is the function signature and the detail holds the
+ * argument values in parenthesis, e.g.
+ *   api    : "xrt::bo::bo(const xrt::device&, size_t, xrt::memory_group)"
+ *   detail : "(0x5566, 4096, 1)"
+ */
+replay_status message::decode_entry_record(const trace_record& entry, std::string_view api)
+{
+  m_ts_ns = entry.m_ts_ns;
+  m_tid = entry.m_tid;
+  m_handle = entry.m_handle;
+
+  auto open = api.find('(');
+  auto close = api.find(')');
+  if (open == std::string_view::npos || close == std::string_view::npos || close < open)
+  {
+    XBREPLAY_ERROR("Invalid API in entry record: ", std::string(api));
+    return replay_status::failure;
+  }
+  m_api_id = std::string(api.substr(0, close + 1));
+
+  /* Variadic signatures use a different layout, defer to the text decoder */
+  if (api.find("...") != std::string_view::npos)
+    return decode_args(std::string(api) + std::string(entry.m_detail));
+
+  std::string args_type(api.substr(open + 1, close - open - 1));
+  auto detail = entry.m_detail;
+  if (args_type.empty() || detail.size() < 2)
+    return replay_status::success;
+
+  std::string args_value(detail.substr(1, detail.size() - 2));
+  return update_args({args_type, args_value});
+}
+
+/*
+ * This function is used to decode binary trace exit record.
+ * The detail holds an optional return value followed by the named
+ * values, e.g. "=1|" or "|buf=mem@0x10[filename:memdump.bin]"
+ */
+void message::decode_exit_record(const trace_record& exit, bool found)
+{
+  m_ret_val = 0;
+
+  if (!found)
+  {
+    // some cases we may not find an exit if the program is
+    // terminated, proceed with the invocation.
+    XBREPLAY_ERROR("Cannot find exit for entry: ", m_api_id);
+    m_ret_val = m_handle;
+    return;
+  }
+
+  m_duration_ns = exit.m_ts_ns > m_ts_ns ? exit.m_ts_ns - m_ts_ns : 0;
+
+  auto detail = exit.m_detail;
+  auto sep = detail.find('|');
+  auto ret = detail.substr(0, sep);
+  if (!ret.empty() && ret[0] == '=')
+  {
+    for (size_t i = 1; i < ret.size() && std::isdigit(static_cast<unsigned char>(ret[i])); ++i)
+      m_ret_val = m_ret_val * 10 + static_cast<uint64_t>(ret[i] - '0');
+  }
+
+  /* update handle to return value if no return found in  API */
+  if (m_ret_val == 0)
+    m_ret_val = exit.m_handle;
+
+  if (m_is_mem_file_available && sep != std::string_view::npos)
+  {
+    auto mem_tag = detail.substr(sep + 1);
+    get_user_data(std::string(mem_tag.substr(0, mem_tag.find('|'))));
+  }
+}
+
 }// end of namespace
 
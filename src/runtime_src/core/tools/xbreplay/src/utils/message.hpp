@@ -14,6 +14,7 @@
 #include <fstream>
 #include <memory>
 #include <array>
+#include <string_view>
 
 namespace xrt_core::tools::xbreplay::utils {
 
@@ -30,6 +31,7 @@ constexpr const char* regex_func_pattern =
 constexpr const char* regex_ret_val_pattern = (R"(=(\d+))");
 
 constexpr uint32_t mem_tag_value = 0x6d656du;
+constexpr uint32_t match_idx_time = 1u;
 constexpr uint32_t match_idx_arg_type = 1u;
 constexpr uint32_t match_idx_arg_value = 2u;
 constexpr uint32_t match_idx_tid = 3u;
@@ -53,6 +55,19 @@ enum class replay_status {
   success
 };
 
+/*
+ * Entry or exit record decoded from a binary trace. The detail points
+ * into the mapped trace file.
+ */
+struct trace_record
+{
+  uint64_t m_ts_ns = 0;
+  uint64_t m_tid = 0;
+  uint64_t m_handle = 0;
+  uint64_t m_api = 0;
+  std::string_view m_detail;
+};
+
 class message
 {
   public:
@@ -61,6 +76,13 @@ class message
   uint64_t  m_ret_val;
   uint64_t  m_handle;
   uint64_t  m_tid;
+  uint64_t  m_ts_ns = 0;      /* entry time since start of trace */
+  uint64_t  m_duration_ns = 0; /* entry to exit time in the trace */
+
+  /* Replay ordering, assigned by replay master */
+  uint64_t  m_seq = 0;
+  uint64_t  m_order_point = 0;
+  bool      m_is_order_point = false;
   std::vector<char>m_buf;
   bool m_is_mem_file_available;
   std::vector<std::pair<std::string, std::string>> m_args;
@@ -78,6 +100,22 @@ class message
     }
   }
 
+  /*
+   * Constructs message from binary trace records, the fields are already
+   * separated so no pattern matching is needed. The exit record can be
+   * null if the program terminated before the API returned.
+   */
+  message(const trace_record& entry, const trace_record* exit,
+          std::string_view api, const std::string& file_path, bool file_available)
+  : m_is_mem_file_available(file_available)
+  , m_mem_file_path(file_path)
+  {
+    m_status = decode_entry_record(entry, api);
+
+    if (replay_status::success == m_status)
+      decode_exit_record(exit ? *exit : entry, exit != nullptr);
+  }
+
   message() = default;
   ~message() = default;
 
@@ -167,6 +205,16 @@ class message
    * from the function exit marker line.
    */
   replay_status decode_exit_line(const std::string& line);
+
+  /*
+   * This function is used to decode binary trace entry record.
+   */
+  replay_status decode_entry_record(const trace_record& entry, std::string_view api);
+
+  /*
+   * This function is used to decode binary trace exit record.
+   */
+  void decode_exit_record(const trace_record& exit, bool found);
 };
 
 }// end of namespace
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace xrt_core::tools::xbreplay::utils {
+
+/*
+ * Log-linear latency histogram in nanoseconds.
+ *
+ * Values are bucketed by their power of two and each power of two is
+ * split in sub_buckets linear buckets, so the relative error of a
+ * reported percentile is bounded by 1/sub_buckets independent of the
+ * magnitude.  Recording is a handful of integer operations and the
+ * histogram has a fixed size, so it is cheap enough to update for every
+ * replayed call.
+ */
+class latency_histogram
+{
+  public:
+  static constexpr uint32_t sub_bucket_bits = 3;
+  static constexpr uint32_t sub_buckets = 1u << sub_bucket_bits;
+  static constexpr uint32_t num_buckets = 64 * sub_buckets;
+
+  static uint32_t bucket_index(uint64_t ns)
+  {
+    if (ns < sub_buckets)
+      return static_cast<uint32_t>(ns);
+
+    uint32_t msb = 0;
+    for (auto v = ns; v >>= 1;)
+      ++msb;
+
+    auto sub = static_cast<uint32_t>((ns >> (msb - sub_bucket_bits)) & (sub_buckets - 1));
+    return (msb - sub_bucket_bits + 1) * sub_buckets + sub;
+  }
+
+  static uint64_t bucket_lower(uint32_t idx)
+  {
+    if (idx < sub_buckets)
+      return idx;
+
+    uint32_t msb = idx / sub_buckets + sub_bucket_bits - 1;
+    uint64_t sub = idx % sub_buckets;
+    return (uint64_t(1) << msb) | (sub << (msb - sub_bucket_bits));
+  }
+
+  void record(uint64_t ns)
+  {
+    ++m_buckets[bucket_index(ns)];
+    ++m_count;
+    m_sum += ns;
+    m_min = std::min(m_min, ns);
+    m_max = std::max(m_max, ns);
+  }
+
+  void merge(const latency_histogram& other)
+  {
+    for (uint32_t i = 0; i < num_buckets; ++i)
+      m_buckets[i] += other.m_buckets[i];
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+  }
+
+  /*
+   * This function returns lower bound of the bucket holding given
+   * percentile (0 - 100), clamped to the recorded range.
+   */
+  uint64_t percentile(double pct) const
+  {
+    if (!m_count)
+      return 0;
+
+    auto rank = static_cast<uint64_t>(pct / 100.0 * static_cast<double>(m_count - 1)) + 1;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < num_buckets; ++i)
+    {
+      seen += m_buckets[i];
+      if (seen >= rank)
+        return std::clamp(bucket_lower(i), m_min, m_max);
+    }
+    return m_max;
+  }
+
+  uint64_t count() const { return m_count; }
+  uint64_t sum() const { return m_sum; }
+  uint64_t min() const { return m_count ? m_min : 0; }
+  uint64_t max() const { return m_max; }
+  uint64_t mean() const { return m_count ? m_sum / m_count : 0; }
+  const std::array<uint64_t, num_buckets>& buckets() const { return m_buckets; }
+
+  private:
+  std::array<uint64_t, num_buckets> m_buckets = {};
+  uint64_t m_count = 0;
+  uint64_t m_sum = 0;
+  uint64_t m_min = std::numeric_limits<uint64_t>::max();
+  uint64_t m_max = 0;
+};
+
+/*
+ * Per API latency statistics of a replay.  Each replay worker owns one
+ * instance, these are merged once replay has completed.
+ */
+class replay_stats
+{
+  std::map<std::string, latency_histogram> m_api_hist;
+
+  public:
+  void record(const std::string& api, uint64_t ns)
+  {
+    m_api_hist[api].record(ns);
+  }
+
+  void merge(const replay_stats& other)
+  {
+    for (const auto& [api, hist] : other.m_api_hist)
+      m_api_hist[api].merge(hist);
+  }
+
+  uint64_t count() const
+  {
+    uint64_t total = 0;
+    for (const auto& it : m_api_hist)
+      total += it.second.count();
+    return total;
+  }
+
+  /*
+   * This function prints per API latency table along with overall
+   * throughput of the replay.
+   */
+  void print(std::ostream& os, uint64_t elapsed_ns) const
+  {
+    constexpr double giga = 1e9;
+    constexpr double kilo = 1e3;
+    auto us = [kilo](uint64_t ns) { return static_cast<double>(ns) / kilo; };
+
+    os << std::fixed << std::setprecision(2);
+    os << std::left << std::setw(72) << "API" << std::right
+       << std::setw(10) << "count" << std::setw(12) << "mean(us)"
+       << std::setw(12) << "p50(us)" << std::setw(12) << "p90(us)"
+       << std::setw(12) << "p99(us)" << std::setw(12) << "max(us)" << "\n";
+
+    for (const auto& [api, hist] : m_api_hist)
+    {
+      os << std::left << std::setw(72) << api.substr(0, 71) << std::right
+         << std::setw(10) << hist.count() << std::setw(12) << us(hist.mean())
+         << std::setw(12) << us(hist.percentile(50)) << std::setw(12) << us(hist.percentile(90))
+         << std::setw(12) << us(hist.percentile(99)) << std::setw(12) << us(hist.max()) << "\n";
+    }
+
+    auto secs = static_cast<double>(elapsed_ns) / giga;
+    os << "Replayed " << count() << " calls in " << secs << " s";
+    if (elapsed_ns)
+      os << " (" << static_cast<double>(count()) / secs << " calls/s)";
+    os << "\n";
+  }
+
+  /*
+   * This function writes the statistics as JSON, buckets are written
+   * sparse as [lower bound ns, count] pairs.
+   */
+  void write_json(std::ostream& os, const std::string& mode, uint64_t elapsed_ns) const
+  {
+    auto escape = [](const std::string& str)
+    {
+      std::string out;
+      for (auto c : str)
+      {
+        if (c == '"' || c == '\\')
+          out += '\\';
+        out += c;
+      }
+      return out;
+    };
+
+    os << "{\n  \"mode\": \"" << mode << "\",\n"
+       << "  \"elapsed_ns\": " << elapsed_ns << ",\n"
+       << "  \"calls\": " << count() << ",\n"
+       << "  \"apis\": [";
+
+    const char* sep = "\n";
+    for (const auto& [api, hist] : m_api_hist)
+    {
+      os << sep << "    {\"api\": \"" << escape(api) << "\""
+         << ", \"count\": " << hist.count() << ", \"sum_ns\": " << hist.sum()
+         << ", \"min_ns\": " << hist.min() << ", \"max_ns\": " << hist.max()
+         << ", \"p50_ns\": " << hist.percentile(50) << ", \"p90_ns\": " << hist.percentile(90)
+         << ", \"p99_ns\": " << hist.percentile(99) << ", \"buckets\": [";
+
+      const char* bsep = "";
+      const auto& buckets = hist.buckets();
+      for (uint32_t i = 0; i < latency_histogram::num_buckets; ++i)
+      {
+        if (!buckets[i])
+          continue;
+        os << bsep << "[" << latency_histogram::bucket_lower(i) << ", " << buckets[i] << "]";
+        bsep = ", ";
+      }
+      os << "]}";
+      sep = ",\n";
+    }
+    os << "\n  ]\n}\n";
+  }
+};
+
+}// end of namespace
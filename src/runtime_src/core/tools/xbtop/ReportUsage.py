@@ -0,0 +1,164 @@
+#!/usr/bin/python3
+
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Copyright (C) 2024 Advanced Micro Devices, Inc
+#
+
+import glob
+import math
+import mmap
+import struct
+import time
+import XBUtil
+
+# found in PYTHONPATH
+import pyxrt
+
+
+# Reader of the per process usage metrics shared memory segments that
+# XRT applications publish when xrt.ini has
+#
+#   [Runtime]
+#   usage_metrics_shm = true
+#
+# The layout must match xrt_core::usage_metrics::shm in
+# core/common/usage_metrics.h
+class UsageSegment:
+    MAGIC = 0x58525455
+    VERSION = 1
+    HEADER = struct.Struct("=IIIIQ")
+    SLOT_STATE = struct.Struct("=Q")
+    BDF_SIZE = 32
+    NUM_COUNTERS = 16
+    COUNTERS = ["hw_contexts", "bo_allocs", "bo_live_count", "bo_live_bytes", "bo_peak_bytes",
+                "sync_to_device", "sync_from_device", "bytes_to_device", "bytes_from_device",
+                "kernel_starts", "kernel_completions", "kernel_errors", "kernel_wait_us"]
+
+    def __init__(self, path):
+        self.path = path
+        with open(path, "rb") as f:
+            self._mm = mmap.mmap(f.fileno(), 0, prot=mmap.PROT_READ)
+        magic, version, self.max_devices, self.slot_size, self.pid = self.HEADER.unpack_from(self._mm, 0)
+        if magic != self.MAGIC or version != self.VERSION:
+            self._mm.close()
+            raise ValueError("Not a usage metrics segment: %s" % path)
+
+    def close(self):
+        self._mm.close()
+
+    # Return the counters of the device with specified bdf, or None if
+    # the process doesn't use the device
+    def read(self, bdf):
+        counters_fmt = struct.Struct("=%dQ" % self.NUM_COUNTERS)
+        for idx in range(self.max_devices):
+            offset = self.HEADER.size + idx * self.slot_size
+            (state,) = self.SLOT_STATE.unpack_from(self._mm, offset)
+            if state != 2:
+                continue
+            offset += self.SLOT_STATE.size
+            slot_bdf = self._mm[offset:offset + self.BDF_SIZE].split(b'\0', 1)[0].decode()
+            if slot_bdf != bdf:
+                continue
+            values = counters_fmt.unpack_from(self._mm, offset + self.BDF_SIZE)
+            return dict(zip(self.COUNTERS, values))
+        return None
+
+
+class ReportUsage:
+    SHM_PATTERN = "/dev/shm/xrt_usage_metrics.*"
+
+    def __init__(self):
+        self._segments = {}
+        self._previous = {}
+        self._previous_time = None
+
+    def report_name(self):
+        return "Application Usage"
+
+    # Open segments of new processes and drop segments of processes
+    # that have exited
+    def _scan(self):
+        paths = set(glob.glob(self.SHM_PATTERN))
+        for path in list(self._segments):
+            if path not in paths:
+                self._segments.pop(path).close()
+        for path in paths - set(self._segments):
+            try:
+                self._segments[path] = UsageSegment(path)
+            except (OSError, ValueError):
+                pass
+
+    def update(self, dev, report_length):
+        self.report_length = report_length
+        bdf = dev.get_info(pyxrt.xrt_info_device.bdf)
+        self._scan()
+
+        now = time.monotonic()
+        elapsed = (now - self._previous_time) if self._previous_time else 0
+        self._previous_time = now
+
+        current = {}
+        self._df = []
+        for segment in self._segments.values():
+            counters = segment.read(bdf)
+            if counters is None:
+                continue
+            current[segment.pid] = counters
+            previous = self._previous.get(segment.pid)
+            starts = counters['kernel_starts'] - previous['kernel_starts'] if previous else 0
+            done = counters['kernel_completions'] + counters['kernel_errors']
+            self._df.append({
+                'pid': segment.pid,
+                'rate': (starts / elapsed) if elapsed and previous else 0,
+                'avg_us': (counters['kernel_wait_us'] / done) if done else 0,
+                'counters': counters
+            })
+        self._previous = current
+        self._df.sort(key=lambda entry: entry['pid'])
+
+        # Round up the division to leave an extra page for the last batch of data
+        page_count = math.ceil(len(self._df) / report_length)
+        # We must ensure that we always have at least one page
+        self.page_count = max(page_count, 1)
+        return self.page_count
+
+    def print_report(self, term, lock, start_x, start_y, page):
+        XBUtil.print_section_heading(term, lock, self.report_name(), start_y)
+        offset = 1
+
+        if not self._df:
+            XBUtil.print_warning(term, lock, start_y + offset, "Data unavailable. No application publishes usage metrics (Runtime.usage_metrics_shm)")
+            return offset + 1
+
+        header = [  "PID", "Runs", "Runs/s", "Errors", "Avg Run (us)", "To Device", "From Device", "Live BOs", "Live BO Size", "Peak BO Size"]
+        format = ["right", "right", "right", "right",        "right",     "right",       "right",    "right",        "right",        "right"]
+        data = []
+
+        page_offset = page * self.report_length
+        for entry in self._df[page_offset:page_offset + self.report_length]:
+            counters = entry['counters']
+            data.append([
+                str(entry['pid']),
+                str(counters['kernel_starts']),
+                "%.1f" % entry['rate'],
+                str(counters['kernel_errors']),
+                "%.1f" % entry['avg_us'],
+                XBUtil.convert_size(counters['bytes_to_device']),
+                XBUtil.convert_size(counters['bytes_from_device']),
+                str(counters['bo_live_count']),
+                XBUtil.convert_size(counters['bo_live_bytes']),
+                XBUtil.convert_size(counters['bo_peak_bytes'])
+            ])
+
+        if (not data):
+            XBUtil.print_warning(term, lock, start_y + offset, "Data unavailable")
+            return offset + 1
+
+        table = XBUtil.Table(header, data, format)
+        ascii_table = table.create_table()
+
+        XBUtil.indented_print(term, lock, ascii_table, 3, start_y + offset)
+        offset += len(ascii_table)
+        return offset
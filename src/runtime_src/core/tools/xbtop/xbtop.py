@@ -34,11 +34,13 @@ g_page_number = 0
 from ReportPower import ReportPower
 from ReportMemory import ReportMemory
 from ReportDynamicRegions import ReportDynamicRegions
+from ReportUsage import ReportUsage
 
 g_reports = []
 g_reports.append(ReportMemory())
 g_reports.append(ReportDynamicRegions())
 g_reports.append(ReportPower())
+g_reports.append(ReportUsage())
 
 
 # Running clock thread (upper left corner)
@@ -66,6 +66,7 @@ class launcher
   // Public members
   bool m_debug = false;
   bool m_inst_debug = false;
+  std::string m_trace_format;
   std::string m_name;
   std::string m_lib_path;
   std::string m_extra_lib;
@@ -282,10 +283,10 @@ int parse_cmdline(launcher& app, int argc, char* argv[])
   std::lock_guard lock(mutex);
 
 #ifdef _WIN32
-  while ((option = getopt(argc, argv, "vVL:")) != -1)
+  while ((option = getopt(argc, argv, "vVf:L:")) != -1)
 #else
   // NOLINTNEXTLINE(concurrency-mt-unsafe) - getopt is protected by a mutex
-  while ((option = getopt(argc, argv, "vV")) != -1)
+  while ((option = getopt(argc, argv, "vVf:")) != -1)
 #endif /* #ifdef _WIN32 */
   {
     switch (option)
@@ -298,6 +299,14 @@ int parse_cmdline(launcher& app, int argc, char* argv[])
         app.m_debug = true;
         app.m_inst_debug = true;
         break;
+
+      // Trace output format: bin (default), text or both
+      case 'f':
+        app.m_trace_format = optarg;
+        if (app.m_trace_format != "bin" && app.m_trace_format != "text"
+            && app.m_trace_format != "both")
+          log_f("Invalid trace format: ", optarg, " (expected bin, text or both)");
+        break;
 #ifdef _WIN32
       case 'L':
         if (std::filesystem::exists(optarg))
@@ -370,6 +379,15 @@ int set_envs(launcher& app)
       log_f("Failed to set environment variable: INST_DEBUG");
   }
 
+  if (!app.m_trace_format.empty())
+  {
+    if (set_env("TRACE_FORMAT", app.m_trace_format.c_str()))
+      log_d("Environment variable set successfully: TRACE_FORMAT = ",
+          app.m_trace_format);
+    else
+      log_f("Failed to set environment variable: TRACE_FORMAT");
+  }
+
   if (set_env("TRACE_APP_NAME", app.m_cmdline.c_str()))
     log_d("Environment variable set successfully: TRACE_APP_NAME = ",
         app.m_cmdline);
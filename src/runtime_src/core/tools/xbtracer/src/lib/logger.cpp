@@ -5,6 +5,7 @@
 #include "version.h"
 #include "detail/logger.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <filesystem>
 #include <fstream>
@@ -21,6 +22,7 @@ constexpr unsigned int str_sz_s = 32;
 constexpr unsigned int str_sz_m = 128;
 constexpr unsigned int str_sz_l = 256;
 constexpr unsigned int fw_9 = 9;
+constexpr size_t trace_buf_flush_sz = 64 * 1024;
 
 //NOLINTNEXTLINE - env_mutex cann't be const
 std::mutex env_mutex;
@@ -87,6 +89,16 @@ logger::logger()
   //NOLINTNEXTLINE(concurrency-mt-unsafe) - protected by env_mutex
   m_program_name = get_env("TRACE_APP_NAME");
 
+  //NOLINTNEXTLINE(concurrency-mt-unsafe) - protected by env_mutex
+  std::string format = get_env("TRACE_FORMAT");
+  if (format == "text")
+  {
+    m_text_trace = true;
+    m_binary_trace = false;
+  }
+  else if (format == "both")
+    m_text_trace = true;
+
   // Retrieve the time from the environment variable
   //NOLINTNEXTLINE(concurrency-mt-unsafe) - protected by env_mutex
   std::string time_str = get_env("START_TIME");
@@ -117,7 +129,8 @@ logger::logger()
   oss_full_path << "." <<path_separator << time_fmt_str << path_separator
                 << xrt_trace_filename;
 
-  m_fp.open(oss_full_path.str(), std::ios::out);
+  if (m_text_trace)
+    m_fp.open(oss_full_path.str(), std::ios::out);
 
   oss_full_path.str("");
   oss_full_path.clear();
@@ -127,13 +140,39 @@ logger::logger()
 
   m_fp_bin.open(oss_full_path.str(), std::ios::out | std::ios::binary);
 
-  m_fp << "|HEADER|pname:\"" << m_program_name <<  "\"|m_pid:" << m_pid << "|xrt_ver:"
-     << XRT_DRIVER_VERSION << "|os:" << os_name_ver() << "|time:"
-     << time_fmt_str << "." << std::setfill('0') << std::setw(fw_9)
-     << ns.count() % giga << "|\n";
+  std::ostringstream oss_time;
+  oss_time << time_fmt_str << "." << std::setfill('0') << std::setw(fw_9)
+           << ns.count() % giga;
 
-  m_fp << "|START|"<< time_fmt_str << "." << std::setfill('0') << std::setw(fw_9)\
-     << ns.count() % giga << "|\n";
+  if (m_text_trace)
+  {
+    m_fp << "|HEADER|pname:\"" << m_program_name <<  "\"|m_pid:" << m_pid << "|xrt_ver:"
+       << XRT_DRIVER_VERSION << "|os:" << os_name_ver() << "|time:"
+       << oss_time.str() << "|\n";
+
+    m_fp << "|START|"<< oss_time.str() << "|\n";
+  }
+
+  if (m_binary_trace)
+  {
+    oss_full_path.str("");
+    oss_full_path.clear();
+
+    oss_full_path << "." << path_separator << time_fmt_str << path_separator
+                  << binfmt::trace_filename;
+
+    m_fp_trace_bin.open(oss_full_path.str(), std::ios::out | std::ios::binary);
+
+    m_trace_buf.reserve(trace_buf_flush_sz * 2);
+    binfmt::put_preamble(m_trace_buf);
+    m_trace_buf.push_back(static_cast<char>(binfmt::record::header));
+    binfmt::put_varint(m_trace_buf, static_cast<uint64_t>(m_pid));
+    binfmt::put_varint(m_trace_buf, static_cast<uint64_t>(ns.count()));
+    binfmt::put_string(m_trace_buf, m_program_name);
+    binfmt::put_string(m_trace_buf, XRT_DRIVER_VERSION);
+    binfmt::put_string(m_trace_buf, os_name_ver());
+    binfmt::put_string(m_trace_buf, oss_time.str());
+  }
 }
 
 /*
@@ -155,8 +194,21 @@ logger::~logger()
                     now.time_since_epoch());
   std::string time_fmt_str = tp_to_date_time_fmt(now);
 
-  m_fp << "|END|" << time_fmt_str << "." << std::setfill('0') << std::setw(fw_9)
-     << ns.count() % giga << "|\n";
+  std::ostringstream oss_time;
+  oss_time << time_fmt_str << "." << std::setfill('0') << std::setw(fw_9)
+           << ns.count() % giga;
+
+  std::lock_guard<std::mutex> lock(m_log_mutex);
+  if (m_text_trace)
+    m_fp << "|END|" << oss_time.str() << "|\n";
+
+  if (m_binary_trace)
+  {
+    m_trace_buf.push_back(static_cast<char>(binfmt::record::end));
+    binfmt::put_string(m_trace_buf, oss_time.str());
+    flush_trace_buf();
+    m_fp_trace_bin.close();
+  }
 
   m_fp_bin.close();
   m_fp.close();
@@ -186,32 +238,94 @@ void logger::synth_dtor_trace_fn()
   }
 }
 
+/*
+ * Method to get the interned id of an API name, the name is added to the
+ * binary trace on first use.
+ * */
+uint64_t logger::get_api_id(const std::string& api)
+{
+  auto it = m_api_ids.find(api);
+  if (it != m_api_ids.end())
+    return it->second;
+
+  uint64_t id = m_api_ids.size();
+  m_api_ids.emplace(api, id);
+  m_trace_buf.push_back(static_cast<char>(binfmt::record::api_name));
+  binfmt::put_varint(m_trace_buf, id);
+  binfmt::put_string(m_trace_buf, api);
+  return id;
+}
+
+/*
+ * Method to write out staged binary trace records.
+ * */
+void logger::flush_trace_buf()
+{
+  m_fp_trace_bin.write(m_trace_buf.data(),
+                       static_cast<std::streamsize>(m_trace_buf.size()));
+  m_trace_buf.clear();
+}
+
 /*
  * API to capture Entry and Exit Trace.
  * */
-void logger::log(trace_type type, std::string str)
+void logger::log(trace_type type, const void* handle, const std::string& api,
+                 const std::string& detail)
 {
   std::thread::id tid = std::this_thread::get_id();
 
-  log(type, str, tid);
+  log(type, handle, api, detail, tid);
 }
 
 /*
  * API to capture Entry and Exit Trace with given thread-id.
  * */
-void logger::log(trace_type type, std::string str, std::thread::id tid)
+void logger::log(trace_type type, const void* handle, const std::string& api,
+                 const std::string& detail, std::thread::id tid)
 {
   auto time_now = std::chrono::system_clock::now();
 
-  std::stringstream ss;
-  ss << ((type == trace_type::entry) ? "|ENTRY|" : "|EXIT|")
-     << timediff(time_now, m_start_time) << "|" << m_pid << "|" << tid << "|"
-     << str;
+  // Thread ids are recorded as the value printed in the text trace
+  static thread_local std::pair<std::thread::id, uint64_t> tid_cache;
+  if (tid_cache.first != tid)
+  {
+    std::ostringstream oss;
+    oss << tid;
+    tid_cache = {tid, std::stoull(oss.str())};
+  }
+
+  std::lock_guard<std::mutex> lock(m_log_mutex);
+
+  if (m_text_trace)
+  {
+    std::stringstream ss;
+    ss << ((type == trace_type::entry) ? "|ENTRY|" : "|EXIT|")
+       << timediff(time_now, m_start_time) << "|" << m_pid << "|" << tid << "|"
+       << handle << "|" << api << detail << "|\n";
+
+    m_fp << ss.str();
 
-  m_fp << ss.str();
+    if (m_inst_debug)
+      m_fp << std::flush;
+  }
 
-  if (m_inst_debug)
-    m_fp << std::flush;
+  if (m_binary_trace)
+  {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                time_now - m_start_time).count();
+    auto api_id = get_api_id(api);
+
+    m_trace_buf.push_back(static_cast<char>((type == trace_type::entry)
+      ? binfmt::record::entry : binfmt::record::exit));
+    binfmt::put_varint(m_trace_buf, static_cast<uint64_t>(std::max<int64_t>(ns, 0)));
+    binfmt::put_varint(m_trace_buf, tid_cache.second);
+    binfmt::put_varint(m_trace_buf, reinterpret_cast<uintptr_t>(handle));
+    binfmt::put_varint(m_trace_buf, api_id);
+    binfmt::put_string(m_trace_buf, detail);
+
+    if (m_inst_debug || m_trace_buf.size() >= trace_buf_flush_sz)
+      flush_trace_buf();
+  }
 };
 
 // Function to read OS name and version
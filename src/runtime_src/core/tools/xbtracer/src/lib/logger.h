@@ -8,6 +8,7 @@
 #include <ctime>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <thread>
 #include <tuple>
@@ -15,6 +16,8 @@
 #include <vector>
 #include <filesystem>
 
+#include "trace_format.h"
+
 #include "xrt/xrt_hw_context.h"
 #include "xrt/experimental/xrt_xclbin.h"
 #include "xrt/experimental/xrt_module.h"
@@ -91,9 +94,21 @@ class logger
   private:
   std::ofstream m_fp;
   std::ofstream m_fp_bin;
+  std::ofstream m_fp_trace_bin;
   std::string m_program_name;
   bool m_inst_debug;
   bool m_is_destructing = false;
+
+  // Trace output formats, selected with TRACE_FORMAT (bin, text or both)
+  bool m_text_trace = false;
+  bool m_binary_trace = true;
+
+  // Serializes trace output from all application threads
+  std::mutex m_log_mutex;
+
+  // Binary trace records are staged here and written out in blocks
+  std::vector<char> m_trace_buf;
+  std::unordered_map<std::string, uint64_t> m_api_ids;
 #ifdef _WIN32
   DWORD m_pid;
 #else
@@ -137,10 +152,10 @@ class logger
       }
       else
       {
-        logger::get_instance().log(trace_type::entry, stringify_args(pimpl)
-                                   + "|" + dtor_name + "()|\n", tid);
-        logger::get_instance().log(trace_type::exit, stringify_args(pimpl)
-                                   + "|" + dtor_name + "||\n", tid);
+        logger::get_instance().log(trace_type::entry, pimpl.get(), dtor_name,
+                                   "()", tid);
+        logger::get_instance().log(trace_type::exit, pimpl.get(), dtor_name,
+                                   "|", tid);
         tuples.erase(it);
       }
     }
@@ -150,6 +165,12 @@ class logger
 
   void synth_dtor_trace_fn();
 
+  /*
+   * Binary trace helpers, must be called with m_log_mutex held.
+   * */
+  uint64_t get_api_id(const std::string& api);
+  void flush_trace_buf();
+
   /*
    * constructor
    * */
@@ -238,9 +259,12 @@ class logger
 
   /*
    * API to capture Entry and Exit Trace.
+   * The text trace line is "handle|api" followed by detail and "|".
    * */
-  void log(trace_type type, std::string str);
-  void log(trace_type type, std::string str, std::thread::id tid);
+  void log(trace_type type, const void* handle, const std::string& api,
+           const std::string& detail);
+  void log(trace_type type, const void* handle, const std::string& api,
+           const std::string& detail, std::thread::id tid);
 };
 
 template <typename... Args>
@@ -377,9 +401,8 @@ namespace xtx = xrt::tools::xbtracer;
       break;                                                                   \
     }                                                                          \
     auto __handle = this->get_handle();                                        \
-    xtx::logger::get_instance().log(xtx::trace_type::entry,                    \
-        xtx::stringify_args(__handle.get(), "|", f) +                          \
-        "(" + xtx::concat_args(__VA_ARGS__) + ")|\n");                         \
+    xtx::logger::get_instance().log(xtx::trace_type::entry, __handle.get(),    \
+        xtx::stringify_args(f), "(" + xtx::concat_args(__VA_ARGS__) + ")");    \
   }                                                                            \
   while (0)                                                                    \
 
@@ -396,9 +419,8 @@ namespace xtx = xrt::tools::xbtracer;
       break;                                                                   \
     }                                                                          \
     auto __handle = this->get_handle();                                        \
-    xtx::logger::get_instance().log(xtx::trace_type::exit,                     \
-        xtx::stringify_args(__handle.get(), "|", f) +                          \
-        "|" + xtx::concat_args_nv(__VA_ARGS__) + "|\n");                       \
+    xtx::logger::get_instance().log(xtx::trace_type::exit, __handle.get(),     \
+        xtx::stringify_args(f), "|" + xtx::concat_args_nv(__VA_ARGS__));       \
   }                                                                            \
   while (0)
 
@@ -415,9 +437,8 @@ namespace xtx = xrt::tools::xbtracer;
       break;                                                                   \
     }                                                                          \
     auto __handle = this->get_handle();                                        \
-    xtx::logger::get_instance().log(xtx::trace_type::exit,                     \
-        xtx::stringify_args(__handle.get(), "|", f) +                          \
-        "=" + xtx::stringify_args(r) + "|" + xtx::concat_args_nv(__VA_ARGS__)  \
-        + "|\n");                                                              \
+    xtx::logger::get_instance().log(xtx::trace_type::exit, __handle.get(),     \
+        xtx::stringify_args(f),                                                \
+        "=" + xtx::stringify_args(r) + "|" + xtx::concat_args_nv(__VA_ARGS__));\
   }                                                                            \
   while (0)
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Binary trace format shared between xbtracer (writer) and xbreplay
+ * (reader).
+ *
+ * The file starts with a fixed preamble (magic + version) followed by a
+ * stream of records.  Each record is a one byte tag followed by fields
+ * that are either unsigned LEB128 varints or length prefixed strings.
+ *
+ *   header   : pid, start_ns, pname, xrt_ver, os, start time string
+ *   api_name : id, name                  (first use of an API name)
+ *   entry    : ts_ns, tid, handle, api id, detail
+ *   exit     : ts_ns, tid, handle, api id, detail
+ *   end      : end time string
+ *
+ * API names are interned, each name is written once in an api_name
+ * record and entry/exit records refer to it by id.  ts_ns is the time
+ * since start of trace.  The detail is the remainder of the equivalent
+ * text trace line following the API name, so a text trace can always be
+ * reconstructed from a binary trace.
+ */
+namespace xrt::tools::xbtracer::binfmt {
+
+constexpr std::array<char, 4> magic = {'X', 'B', 'T', 'R'};
+constexpr uint32_t version = 1;
+constexpr const char* trace_filename = "trace.bin";
+
+enum class record : uint8_t {
+  header = 1,
+  api_name,
+  entry,
+  exit,
+  end
+};
+
+inline void
+put_varint(std::vector<char>& buf, uint64_t value)
+{
+  constexpr uint64_t mask = 0x7f;
+  constexpr uint8_t more = 0x80;
+  while (value > mask) {
+    buf.push_back(static_cast<char>((value & mask) | more));
+    value >>= 7;
+  }
+  buf.push_back(static_cast<char>(value));
+}
+
+inline void
+put_string(std::vector<char>& buf, std::string_view str)
+{
+  put_varint(buf, str.size());
+  buf.insert(buf.end(), str.begin(), str.end());
+}
+
+inline void
+put_preamble(std::vector<char>& buf)
+{
+  buf.insert(buf.end(), magic.begin(), magic.end());
+  put_varint(buf, version);
+}
+
+/*
+ * Cursor over a binary trace held in memory (typically mmap'ed).  All
+ * accessors return false when the data is exhausted or malformed, the
+ * strings returned point into the underlying buffer.
+ */
+class reader
+{
+  const char* m_cur;
+  const char* m_end;
+
+  public:
+  reader(const char* data, size_t size)
+  : m_cur(data)
+  , m_end(data + size)
+  {}
+
+  static bool
+  is_binary(const char* data, size_t size)
+  {
+    return size >= magic.size() && std::memcmp(data, magic.data(), magic.size()) == 0;
+  }
+
+  bool
+  at_end() const
+  {
+    return m_cur >= m_end;
+  }
+
+  bool
+  get_preamble(uint64_t& ver)
+  {
+    if (!is_binary(m_cur, m_end - m_cur))
+      return false;
+    m_cur += magic.size();
+    return get_varint(ver);
+  }
+
+  bool
+  get_tag(record& tag)
+  {
+    if (m_cur >= m_end)
+      return false;
+    tag = static_cast<record>(*m_cur++);
+    return true;
+  }
+
+  bool
+  get_varint(uint64_t& value)
+  {
+    constexpr uint64_t mask = 0x7f;
+    constexpr uint8_t more = 0x80;
+    constexpr unsigned int max_shift = 63;
+    value = 0;
+    for (unsigned int shift = 0; m_cur < m_end && shift <= max_shift; shift += 7) {
+      auto byte = static_cast<uint8_t>(*m_cur++);
+      value |= (byte & mask) << shift;
+      if (!(byte & more))
+        return true;
+    }
+    return false;
+  }
+
+  bool
+  get_string(std::string_view& str)
+  {
+    uint64_t len = 0;
+    if (!get_varint(len) || len > static_cast<uint64_t>(m_end - m_cur))
+      return false;
+    str = std::string_view(m_cur, len);
+    m_cur += len;
+    return true;
+  }
+};
+
+} // namespace xrt::tools::xbtracer::binfmt
@@ -22,6 +22,7 @@ namespace po = boost::program_options;
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 // ----- C L A S S   M E T H O D S -------------------------------------------
@@ -114,20 +115,39 @@ OO_MemRead::execute(const SubCmdOptions& _options) const
   //read mem
   XBU::xclbin_lock xclbin_lock(device.get());
 
-  // Open the output file and write the data as we receive it
-  std::ofstream out_file(m_outputFile, std::ofstream::out | std::ofstream::binary | std::ofstream::app);
+  // Open the output file, blocks are appended to existing content.
+  // Banks are read concurrently and each chunk is written at its
+  // offset as it is received, so host memory use is independent of
+  // the size read.
+  std::fstream out_file(m_outputFile, std::ios::out | std::ios::app | std::ios::binary);
+  out_file.close();
+  out_file.open(m_outputFile, std::ios::in | std::ios::out | std::ios::binary);
+  out_file.seekp(0, std::ios::end);
+  uint64_t file_offset = static_cast<uint64_t>(out_file.tellp());
+  std::mutex out_mutex;
+
+  xrt_core::mem_access_stats total;
   for(decltype(m_count) running_count = 0; running_count < m_count; running_count++) {
     XBU::verbose(boost::str(boost::format("[%d / %d] Reading from Address: %s, Size: %s bytes") % running_count % m_count % addr % size));
-    // Get the output from the device
-    std::vector<char> data = xrt_core::device_mem_read(device.get(), addr, size);
-    // Write output to the given file
-    out_file.write(data.data(), data.size());
-    if ((out_file.rdstate() & std::ifstream::failbit) != 0)
-      throw std::runtime_error("Error writing to output file");
+    // Stream the output from the device into the given file
+    auto stats = xrt_core::device_mem_read(device.get(), addr, size,
+      [&out_file, &out_mutex, file_offset](uint64_t offset, const char* data, size_t bytes) {
+        std::lock_guard lk(out_mutex);
+        out_file.seekp(file_offset + offset);
+        out_file.write(data, bytes);
+        if ((out_file.rdstate() & std::ifstream::failbit) != 0)
+          throw std::runtime_error("Error writing to output file");
+      });
     // increment the starting address by the number of bytes read
-    addr += data.size();
+    addr += stats.bytes;
+    file_offset += stats.bytes;
+    total.bytes += stats.bytes;
+    total.duration += stats.duration;
+    total.banks = std::max(total.banks, stats.banks);
   }
   out_file.close();
 
+  std::cout << boost::format("Read %llu bytes from %u bank(s) in %.3f s (%.1f MB/s)\n")
+    % total.bytes % total.banks % std::chrono::duration<double>(total.duration).count() % total.throughput();
   std::cout << "Memory read succeeded" << std::endl;
 }
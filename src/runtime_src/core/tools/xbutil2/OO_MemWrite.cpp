@@ -22,8 +22,28 @@ namespace po = boost::program_options;
 #include <fstream>
 #include <iostream>
 #include <math.h>
+#include <mutex>
 #include <vector>
 
+namespace {
+
+static void
+add_stats(xrt_core::mem_access_stats& total, const xrt_core::mem_access_stats& stats)
+{
+  total.bytes += stats.bytes;
+  total.duration += stats.duration;
+  total.banks = std::max(total.banks, stats.banks);
+}
+
+static void
+print_stats(const xrt_core::mem_access_stats& total)
+{
+  std::cout << boost::format("Wrote %llu bytes to %u bank(s) in %.3f s (%.1f MB/s)\n")
+    % total.bytes % total.banks % std::chrono::duration<double>(total.duration).count() % total.throughput();
+}
+
+} // namespace
+
 // ----- C L A S S   M E T H O D S -------------------------------------------
 
 OO_MemWrite::OO_MemWrite( const std::string &_longName, bool _isHidden)
@@ -154,17 +174,32 @@ OO_MemWrite::execute(const SubCmdOptions& _options) const
     // Write to device memory
     XBU::xclbin_lock xclbin_lock(device.get());
 
+    // Banks are written concurrently, each chunk is read from the
+    // input file at its offset when requested.  Bytes past the end of
+    // the input file are written as zero.
+    std::mutex input_mutex;
+    xrt_core::mem_access_stats total;
+    uint64_t input_offset = 0;
     for (decltype(count) running_count = 0; running_count < count; running_count++) {
       XBU::verbose(boost::format("[%d / %llu] Writing to Address: %s, Size: %llu bytes") % running_count % count % addr % size);
-      std::vector<char> buffer(size);
-      // Populate the buffer with the data to write and get the number of bytes read
-      // gcount will only return a value >= 0
-      auto input_size = static_cast<uint64_t>(input_stream.read(buffer.data(), size).gcount());
-      xrt_core::device_mem_write(device.get(), addr, buffer);
+      uint64_t input_size = 0;
+      auto stats = xrt_core::device_mem_write(device.get(), addr, size,
+        [&input_stream, &input_mutex, &input_size, input_offset](uint64_t offset, char* data, size_t bytes) {
+          std::lock_guard lk(input_mutex);
+          input_stream.clear();
+          input_stream.seekg(input_offset + offset);
+          // gcount will only return a value >= 0
+          auto read = static_cast<size_t>(input_stream.read(data, bytes).gcount());
+          std::fill(data + read, data + bytes, 0);
+          input_size += read;
+        });
+      add_stats(total, stats);
       if (input_size != size)
         break; // partial read and break the loop
       addr += size;
+      input_offset += size;
     }
+    print_stats(total);
     std::cout << "Memory write succeeded" << std::endl;
 
     return;
@@ -195,15 +230,18 @@ OO_MemWrite::execute(const SubCmdOptions& _options) const
     // Write to device memory
     XBU::xclbin_lock xclbin_lock(device.get());
 
-    // Generate the fill vector
-    std::vector<char> buffer(size);
-    std::fill(buffer.begin(), buffer.end(), fill_byte);
-    // Write the vector to the device
+    // Write the fill pattern to the device
+    xrt_core::mem_access_stats total;
     for (decltype(m_count) running_count = 0; running_count < m_count; running_count++) {
       XBU::verbose(boost::format("[%d / %llu] Writing to Address: %s, Size: %s bytes") % running_count % m_count % addr % size);
-      xrt_core::device_mem_write(device.get(), addr, buffer);
+      auto stats = xrt_core::device_mem_write(device.get(), addr, size,
+        [fill_byte](uint64_t, char* data, size_t bytes) {
+          std::fill(data, data + bytes, fill_byte);
+        });
+      add_stats(total, stats);
       addr += size;
     }
+    print_stats(total);
     std::cout << "Memory write succeeded" << std::endl;
     return;
   }
@@ -379,7 +379,8 @@ struct ExtendedKeysStruct {
 };
 
 static std::vector<ExtendedKeysStruct>  extendedKeysCollection = {
-  {"dma", "block-size", "Memory transfer size (bytes)"}
+  {"dma", "block-size", "Memory transfer size (bytes)"},
+  {"dma", "queue-depth", "Comma separated DMA queue depths to sweep with block sizes up to block-size"}
 };
 
 }
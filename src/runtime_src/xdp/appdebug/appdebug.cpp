@@ -79,8 +79,7 @@ event_commandstatus_to_string(cl_int status)
 }
 
 //Iterate all events and find all events that aEvent depends on, returns a vector
-//Note that, this function calls try_get_chain() which locks the event object
-//So any functions called while iterating on the chain should not lock the event
+//Note that, the event chain is checked without locking the event object
 //Also, note that app_debug_track->for_each locks the tracker data structure,
 //so the lambda cannot call any functions that would inturn try to lock tracker
 std::vector<xocl::event*> event_chain_to_dependencies (xocl::event* aEvent) {
@@ -89,14 +88,9 @@ std::vector<xocl::event*> event_chain_to_dependencies (xocl::event* aEvent) {
   auto findDependencies = [aEvent, &dependencies] (cl_event aEv) {
     xocl::event * e =  xocl::xocl(aEv);
     //consider all events, including user events that are not in any command queue
-      xocl::range_lock<xocl::event::event_iterator_type>&& aRange = e->try_get_chain();
-      for (auto it = aRange.begin(); it!=aRange.end(); ++it) {
-        if (*it == aEvent) {
-          //Add ev to the aEvent dependent list
-          dependencies.push_back(e);
-          break;
-        }
-      }
+    if (e->chains(aEvent))
+      //Add ev to the aEvent dependent list
+      dependencies.push_back(e);
   };
 
   appdebug::app_debug_track<cl_event>::getInstance()->for_each(findDependencies);
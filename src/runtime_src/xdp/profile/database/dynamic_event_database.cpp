@@ -93,6 +93,18 @@ namespace xdp {
       addHostEvent(event);
   }
 
+  uint64_t VPDynamicDatabase::reserveEventIds(uint64_t count)
+  {
+    return eventId.fetch_add(count);
+  }
+
+  void VPDynamicDatabase::addPLTraceEvents(uint64_t deviceId,
+                                           const std::vector<VTFEvent*>& events)
+  {
+    auto device_db = getDeviceDB(deviceId);
+    device_db->addPLTraceEvents(events);
+  }
+
   void VPDynamicDatabase::markDeviceEventStart(uint64_t deviceId,
                                                uint64_t monitorId,
                                                DeviceEventInfo& info)
@@ -94,6 +94,13 @@ namespace xdp {
     // Add an event to the database to be sorted later when we write
     XDP_CORE_EXPORT void addUnsortedEvent(VTFEvent* event);
 
+    // Reserve a contiguous block of event ids.  Device trace decoding
+    // issues ids from the block itself and later adds a batch of PL
+    // trace events that already have ids and are sorted by timestamp.
+    XDP_CORE_EXPORT uint64_t reserveEventIds(uint64_t count);
+    XDP_CORE_EXPORT void addPLTraceEvents(uint64_t deviceId,
+                                          const std::vector<VTFEvent*>& events);
+
     // For API events, find the event id of the start event for an end event
     XDP_CORE_EXPORT void markStart(uint64_t functionID, uint64_t eventID) ;
     XDP_CORE_EXPORT uint64_t matchingStart(uint64_t functionID) ;
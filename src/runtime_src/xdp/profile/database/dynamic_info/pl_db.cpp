@@ -38,6 +38,28 @@ namespace xdp {
       VPDatabase::Instance()->broadcast(VPDatabase::DUMP_TRACE);
   }
 
+  // The events have already been sorted by timestamp, so each insertion
+  //  is hinted to go after the previously inserted event
+  void PLDB::addEvents(const std::vector<VTFEvent*>& sortedEvents)
+  {
+    if (sortedEvents.empty())
+      return;
+
+    bool overLimit = false;
+    {
+      std::lock_guard<std::mutex> lock(eventLock);
+      auto hint = events.end();
+      for (auto event : sortedEvents) {
+        hint = events.emplace_hint(hint, event->getTimestamp(), event);
+        ++hint;
+      }
+      if (events.size() > eventThreshold)
+        overLimit = true;
+    }
+    if (overLimit)
+      VPDatabase::Instance()->broadcast(VPDatabase::DUMP_TRACE);
+  }
+
   bool PLDB::eventsExist()
   {
     std::lock_guard<std::mutex> lock(eventLock);
@@ -21,6 +21,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "core/common/uuid.h"
 #include "core/include/xdp/counters.h"
@@ -76,6 +77,7 @@ namespace xdp {
     ~PLDB() = default;
 
     void addEvent(VTFEvent* event);
+    void addEvents(const std::vector<VTFEvent*>& sortedEvents);
     bool eventsExist();
 
     std::vector<std::unique_ptr<VTFEvent>> moveEvents();
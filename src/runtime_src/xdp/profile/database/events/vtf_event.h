@@ -100,8 +100,10 @@ namespace xdp {
     inline double       getTimestamp()    const { return timestamp ; }
     inline void         setTimestamp(double ts) { timestamp = ts ; }
     inline uint64_t     getEventId()            { return id ; }
+    inline uint64_t     getStartId()            { return start_id ; }
     inline void         setEventId(uint64_t i)  { id = i ; }
     inline VTFEventType getEventType()          { return type; }
+    XDP_CORE_EXPORT const char* getTypeName() ;
 
     // Functions that can be used as filters
     virtual bool isUserEvent()       { return false ; }
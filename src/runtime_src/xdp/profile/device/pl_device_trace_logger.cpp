@@ -22,14 +22,57 @@
 #include "xdp/profile/plugin/vp_base/utility.h"
 #include "xdp/profile/database/static_info/xclbin_info.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/message.h"
 #include "xrt/experimental/xrt_profile.h"
 
+#include "xdp/profile/device/tracedefs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <queue>
+#include <thread>
+
 #ifdef _WIN32
 #pragma warning (disable : 4244)
 /* Disable warnings for conversion from uint32_t to uint16_t */
 #endif
 
+namespace {
+
+  // Packet classes computed up front for a batch of trace packets
+  constexpr uint8_t AM_PACKET             = 0x1;
+  constexpr uint8_t AIM_PACKET            = 0x2;
+  constexpr uint8_t ASM_PACKET            = 0x4;
+  constexpr uint8_t CLOCK_TRAINING_PACKET = 0x8;
+
+  // Branch free so the loop over a batch can be vectorized.  A clock
+  // training packet has no trace ID, so it is never also a monitor packet.
+  inline uint8_t classifyPacket(uint64_t trace)
+  {
+    uint64_t traceId = (trace >> 49) & 0xFFF;
+    uint8_t clockTraining = static_cast<uint8_t>(trace >> 63);
+    uint8_t am  = (traceId >= xdp::util::min_trace_id_am) &
+                  (traceId <= xdp::util::max_trace_id_am);
+    uint8_t aim = (traceId <= xdp::util::max_trace_id_aim);
+    uint8_t asm_ = (traceId >= xdp::util::min_trace_id_asm) &
+                   (traceId <  xdp::util::max_trace_id_asm);
+    uint8_t monitor = am | (aim << 1) | (asm_ << 2);
+    return static_cast<uint8_t>((clockTraining << 3) | (monitor & (clockTraining - 1)));
+  }
+
+  // Events decoded from one partition are nearly sorted already.  Keep
+  //  the decode order of events with the same timestamp.
+  void sortByTimestamp(std::vector<xdp::VTFEvent*>& events)
+  {
+    std::stable_sort(events.begin(), events.end(),
+                     [](xdp::VTFEvent* a, xdp::VTFEvent* b)
+                     { return a->getTimestamp() < b->getTimestamp(); });
+  }
+
+} // end anonymous namespace
+
 namespace xdp {
 
   PLDeviceTraceLogger::PLDeviceTraceLogger(uint64_t devId)
@@ -44,8 +87,11 @@ namespace xdp {
     traceClockRateMHz = db->getStaticInfo().getPLMaxClockRateMHz(deviceId);
     clockTrainSlope = 1000.0/traceClockRateMHz;
 
+    decodeThreads = xrt_core::config::get_trace_decode_threads();
+
     ConfigInfo* config = (db->getStaticInfo()).getCurrentlyLoadedConfig(devId);
     xclbin = config->getPlXclbin();
+    createPartitions();
     if (!xclbin)
       return;
 
@@ -61,9 +107,113 @@ namespace xdp {
     asmLastTrans.resize((db->getStaticInfo()).getNumUserASM(deviceId, xclbin));
   }
 
+  void PLDeviceTraceLogger::createPartitions()
+  {
+    // Trace IDs are 12 bits
+    constexpr size_t numTraceIds = 0x1000;
+    startEvents.resize(numTraceIds);
+    partitionOf.assign(numTraceIds, 0);
+
+    // Partition 0 owns all trace IDs without a known monitor.  Packets
+    //  from such monitors are ignored, but the approximations at the end
+    //  of trace may still log events for them.
+    partitions.resize(1);
+    if (!xclbin)
+      return;
+
+    std::map<int32_t, uint32_t> cuPartitions;
+    auto getPartition = [this, &cuPartitions](int32_t cuId) {
+      if (cuId != -1) {
+        auto itr = cuPartitions.find(cuId);
+        if (itr != cuPartitions.end())
+          return itr->second;
+      }
+      auto index = static_cast<uint32_t>(partitions.size());
+      partitions.emplace_back();
+      if (cuId != -1)
+        cuPartitions[cuId] = index;
+      return index;
+    };
+
+    auto& staticInfo = db->getStaticInfo();
+    for (uint64_t slot = 0; slot < staticInfo.getNumAM(deviceId, xclbin); ++slot) {
+      Monitor* mon = staticInfo.getAMonitor(deviceId, xclbin, slot);
+      if (!mon)
+        continue;
+      auto index = getPartition(mon->cuIndex);
+      for (uint64_t id = 0; id < 16; ++id)
+        partitionOf[util::min_trace_id_am + slot * 16 + id] = index;
+    }
+    for (uint64_t slot = 0; slot < staticInfo.getNumAIM(deviceId, xclbin); ++slot) {
+      Monitor* mon = staticInfo.getAIMonitor(deviceId, xclbin, slot);
+      if (!mon)
+        continue;
+      auto index = getPartition(mon->cuIndex);
+      partitionOf[util::min_trace_id_aim + slot * 2] = index;
+      partitionOf[util::min_trace_id_aim + slot * 2 + 1] = index;
+    }
+    for (uint64_t slot = 0; slot < staticInfo.getNumASM(deviceId, xclbin); ++slot) {
+      Monitor* mon = staticInfo.getASMonitor(deviceId, xclbin, slot);
+      if (!mon)
+        continue;
+      partitionOf[util::min_trace_id_asm + slot] = getPartition(mon->cuIndex);
+    }
+  }
+
+  void PLDeviceTraceLogger::markStart(uint64_t traceId,
+                                      const DeviceEventInfo& info)
+  {
+    startEvents[traceId].push_back(info);
+  }
+
+  DeviceEventInfo PLDeviceTraceLogger::findMatchingStart(uint64_t traceId,
+                                                     VTFEventType type)
+  {
+    DeviceEventInfo eventInfo;
+    eventInfo.type = UNKNOWN_EVENT;
+    eventInfo.eventID = 0;
+    eventInfo.hostTimestamp = 0.0;
+    eventInfo.deviceTimestamp = 0;
+
+    auto& starts = startEvents[traceId];
+    auto itr = std::find_if(starts.begin(), starts.end(),
+                            [type](const DeviceEventInfo& e)
+                            { return e.type == type; });
+    if (itr != starts.end()) {
+      eventInfo = *itr;
+      starts.erase(itr);
+    }
+    return eventInfo;
+  }
+
+  bool PLDeviceTraceLogger::hasMatchingStart(uint64_t traceId,
+                                             VTFEventType type)
+  {
+    auto& starts = startEvents[traceId];
+    return std::any_of(starts.begin(), starts.end(),
+                       [type](const DeviceEventInfo& e)
+                       { return e.type == type; });
+  }
+
+  // Events are kept with the partition of the monitor until merged into
+  //  the database.  Event ids are issued from a block reserved by the
+  //  partition so concurrent decoding does not contend on the database.
+  void PLDeviceTraceLogger::logEvent(uint64_t traceId, VTFEvent* event)
+  {
+    auto& partition = partitions[partitionOf[traceId]];
+    if (partition.nextEventId == partition.lastEventId) {
+      partition.nextEventId =
+        db->getDynamicInfo().reserveEventIds(TRACE_EVENT_ID_BLOCK_SIZE);
+      partition.lastEventId = partition.nextEventId + TRACE_EVENT_ID_BLOCK_SIZE;
+    }
+    event->setEventId(partition.nextEventId++);
+    partition.events.push_back(event);
+  }
+
   void PLDeviceTraceLogger::addCUEndEvent(double hostTimestamp,
                                           uint64_t deviceTimestamp,
                                           uint32_t s,
+                                          uint64_t monTraceId,
                                           int32_t cuId)
   {
     // In addition to creating the event, we must log statistics
@@ -78,18 +228,14 @@ namespace xdp {
     auto event = new KernelEvent(startEventID,
                                  hostTimestamp, KERNEL, deviceId, s, cuId);
     event->setDeviceTimestamp(deviceTimestamp);
-    db->getDynamicInfo().addEvent(event);
-    (db->getStats()).setLastKernelEndTime(hostTimestamp);
-
-    // Log a CU execution in our statistics database
-    // NOTE: At this stage, we don't know the global work size, so let's
-    //       leave it to the database to fill that in.
-    auto cu = db->getStaticInfo().getCU(deviceId, cuId);
-    (db->getStats()).logComputeUnitExecution(cu->getName(),
-                                             cu->getKernelName(),
-                                             cu->getDim(),
-                                             "",
-                                             executionTime);
+    logEvent(monTraceId, event);
+
+    // The CU execution is logged in our statistics database when the
+    //  partition is merged
+    auto& partition = partitions[partitionOf[monTraceId]];
+    partition.lastKernelEndTime =
+      std::max(partition.lastKernelEndTime, hostTimestamp);
+    partition.cuExecutions.emplace_back(cuId, executionTime);
   }
 
   void PLDeviceTraceLogger::addCUEvent(uint64_t trace,
@@ -105,33 +251,34 @@ namespace xdp {
     if (!(eventFlags & CU_MASK)) {
       // End event
       DeviceEventInfo e =
-        db->getDynamicInfo().matchingDeviceEventStart(deviceId, monTraceId, KERNEL);
+        findMatchingStart(monTraceId, KERNEL);
       if(e.type == UNKNOWN_EVENT)
         return;
       if (cuStarts[slot].empty())
         return;
 
-      addCUEndEvent(hostTimestamp, deviceTimestamp, slot, cuId);
+      addCUEndEvent(hostTimestamp, deviceTimestamp, slot, monTraceId, cuId);
     }
     else {
       // start event
       event = new KernelEvent(0, hostTimestamp, KERNEL, deviceId, slot, cuId);
       event->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(event);
+      logEvent(monTraceId, event);
       DeviceEventInfo info;
       info.type = event->getEventType();
       info.eventID = event->getEventId();
       info.hostTimestamp = event->getTimestamp();
       info.deviceTimestamp = deviceTimestamp;
-      db->getDynamicInfo().markDeviceEventStart(deviceId, monTraceId, info);
+      markStart(monTraceId, info);
 
       cuStarts[slot].push_back(std::make_pair(event->getEventId(),
                                               deviceTimestamp));
       if(1 == cuStarts[slot].size()) {
         traceIDs[slot] = 0; // When current CU starts, reset stall status
       }
-      if (db->getStats().getFirstKernelStartTime() == 0.0)
-        (db->getStats()).setFirstKernelStartTime(hostTimestamp);
+      auto& partition = partitions[partitionOf[monTraceId]];
+      if (partition.firstKernelStartTime == 0.0)
+        partition.firstKernelStartTime = hostTimestamp;
     }
   }
 
@@ -149,7 +296,7 @@ namespace xdp {
     if (traceIDs[slot] & mask) {
       // End event
       DeviceEventInfo startEventInfo =
-        db->getDynamicInfo().matchingDeviceEventStart(deviceId, monTraceId, type);
+        findMatchingStart(monTraceId, type);
       event = new KernelStall(startEventInfo.eventID,
                               hostTimestamp,
                               type,
@@ -157,19 +304,19 @@ namespace xdp {
                               slot,
                               cuId);
       event->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(event);
+      logEvent(monTraceId, event);
     }
     else {
       // Start event
       event = new KernelStall(0, hostTimestamp, type, deviceId, slot, cuId);
       event->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(event);
+      logEvent(monTraceId, event);
       DeviceEventInfo info;
       info.type = event->getEventType();
       info.eventID = event->getEventId();
       info.hostTimestamp = event->getTimestamp();
       info.deviceTimestamp = deviceTimestamp;
-      db->getDynamicInfo().markDeviceEventStart(deviceId, monTraceId, info);
+      markStart(monTraceId, info);
     }
   }
 
@@ -290,21 +437,21 @@ namespace xdp {
       // start event
       strmEvent = new DeviceStreamAccess(0, hostTimestamp, streamEventType, deviceId, slot, cuId);
       strmEvent->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(strmEvent);
+      logEvent(traceId, strmEvent);
       DeviceEventInfo info;
       info.type = strmEvent->getEventType();
       info.eventID = strmEvent->getEventId();
       info.hostTimestamp = strmEvent->getTimestamp();
       info.deviceTimestamp = deviceTimestamp;
-      db->getDynamicInfo().markDeviceEventStart(deviceId, traceId, info);
+      markStart(traceId, info);
     } else {
       DeviceEventInfo matchingStart =
-        db->getDynamicInfo().matchingDeviceEventStart(deviceId, traceId, streamEventType);
+        findMatchingStart(traceId, streamEventType);
       if(isSingle || matchingStart.type == UNKNOWN_EVENT) {
         // add dummy start event
         strmEvent = new DeviceStreamAccess(0, hostTimestamp, streamEventType, deviceId, slot, cuId);
         strmEvent->setDeviceTimestamp(deviceTimestamp);
-        db->getDynamicInfo().addEvent(strmEvent);
+        logEvent(traceId, strmEvent);
         matchingStart.type = strmEvent->getEventType();
         matchingStart.eventID = strmEvent->getEventId();
         matchingStart.hostTimestamp = hostTimestamp;
@@ -314,7 +461,7 @@ namespace xdp {
       // add end event
       strmEvent = new DeviceStreamAccess(matchingStart.eventID, hostTimestamp, streamEventType, deviceId, slot, cuId);
       strmEvent->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(strmEvent);
+      logEvent(traceId, strmEvent);
       asmLastTrans[slot] = deviceTimestamp;
     }
   }
@@ -337,37 +484,37 @@ namespace xdp {
       // If we see two starts in a row of the same type on the same slot,
       //  then we must have dropped an end packet.  Add a dummy end packet
       //  here.
-      if (db->getDynamicInfo().hasMatchingDeviceEventStart(deviceId, traceId, ty)){
+      if (hasMatchingStart(traceId, ty)){
         DeviceEventInfo matchingStart =
-          db->getDynamicInfo().matchingDeviceEventStart(deviceId, traceId, ty);
+          findMatchingStart(traceId, ty);
         memEvent =
           new DeviceMemoryAccess(matchingStart.eventID,
                                  hostTimestamp - halfCycleTimeInMs,
                                  ty, deviceId, slot, cuId,
                                  memStrId);
         memEvent->setDeviceTimestamp(deviceTimestamp);
-        db->getDynamicInfo().addEvent(memEvent);
+        logEvent(traceId, memEvent);
         aimLastTrans[slot] = deviceTimestamp;
       }
 
       memEvent = new DeviceMemoryAccess(0, hostTimestamp, ty, deviceId, slot, cuId, memStrId);
       memEvent->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(memEvent);
+      logEvent(traceId, memEvent);
       DeviceEventInfo info;
       info.type = memEvent->getEventType();
       info.eventID = memEvent->getEventId();
       info.hostTimestamp = memEvent->getTimestamp();
       info.deviceTimestamp = deviceTimestamp;
-      db->getDynamicInfo().markDeviceEventStart(deviceId, traceId, info);
+      markStart(traceId, info);
     }
     else {
       DeviceEventInfo matchingStart =
-        db->getDynamicInfo().matchingDeviceEventStart(deviceId, traceId, ty);
+        findMatchingStart(traceId, ty);
       if (matchingStart.type == UNKNOWN_EVENT) {
         // We need to add a dummy start event for this observed end event
         memEvent = new DeviceMemoryAccess(0, hostTimestamp, ty, deviceId, slot, cuId, memStrId);
         memEvent->setDeviceTimestamp(deviceTimestamp);
-        db->getDynamicInfo().addEvent(memEvent);
+        logEvent(traceId, memEvent);
         matchingStart.type = memEvent->getEventType();
         matchingStart.eventID = memEvent->getEventId();
         matchingStart.hostTimestamp = hostTimestamp;
@@ -388,13 +535,13 @@ namespace xdp {
                                             hostTimestamp, ty,
                                             deviceId, slot, cuId, memStrId);
           memEvent->setDeviceTimestamp(deviceTimestamp);
-          db->getDynamicInfo().addEvent(memEvent);
+          logEvent(traceId, memEvent);
 
           // Now create the dummy start
           memEvent = new DeviceMemoryAccess(0, hostTimestamp, ty,
                                             deviceId, slot, cuId, memStrId);
           memEvent->setDeviceTimestamp(deviceTimestamp);
-          db->getDynamicInfo().addEvent(memEvent);
+          logEvent(traceId, memEvent);
           matchingStart.type = memEvent->getEventType();
           matchingStart.eventID = memEvent->getEventId();
           matchingStart.hostTimestamp = hostTimestamp;
@@ -409,7 +556,7 @@ namespace xdp {
                                         hostTimestamp, ty,
                                         deviceId, slot, cuId, memStrId);
       memEvent->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(memEvent);
+      logEvent(traceId, memEvent);
       aimLastTrans[slot] = deviceTimestamp;
     }
   }
@@ -475,7 +622,8 @@ namespace xdp {
 
       // end event
       double hostTimestamp = convertDeviceToHostTimestamp(cuLastTimestamp);
-      addCUEndEvent(hostTimestamp, cuLastTimestamp, amIndex, cuId);
+      uint64_t monTraceId = amIndex * 16 + util::min_trace_id_am;
+      addCUEndEvent(hostTimestamp, cuLastTimestamp, amIndex, monTraceId, cuId);
     }
   }
 
@@ -487,7 +635,7 @@ namespace xdp {
                                                        uint64_t memStrId)
   {
     DeviceEventInfo startEvent =
-      db->getDynamicInfo().matchingDeviceEventStart(deviceId, aimTraceID, type);
+      findMatchingStart(aimTraceID, type);
     if (startEvent.type == UNKNOWN_EVENT)
       return;
 
@@ -522,7 +670,7 @@ namespace xdp {
                              type,
                              deviceId, amId, cuId, memStrId);
     endEvent->setDeviceTimestamp(transApproxEndTimestamp);
-    db->getDynamicInfo().addEvent(endEvent);
+    logEvent(aimTraceID, endEvent);
   }
 
   void PLDeviceTraceLogger::addApproximateDataTransferEndEvents()
@@ -671,7 +819,7 @@ namespace xdp {
     double   halfCycleTimeInMs = (0.5/traceClockRateMHz)/1000.0;
 
     DeviceEventInfo matchingStart =
-      db->getDynamicInfo().matchingDeviceEventStart(deviceId, asmTraceID,streamEventType);
+      findMatchingStart(asmTraceID,streamEventType);
     while(matchingStart.type != UNKNOWN_EVENT) {
       unfinishedASMevents = true;
       asmStartTimestamp = matchingStart.deviceTimestamp;
@@ -689,9 +837,9 @@ namespace xdp {
       DeviceStreamAccess* strmEvent = new DeviceStreamAccess(matchingStart.eventID, asmAppxEndHostTimestamp,
                                                            streamEventType, deviceId, asmIndex, cuId);
       strmEvent->setDeviceTimestamp(asmAppxEndTimestamp);
-      db->getDynamicInfo().addEvent(strmEvent);
+      logEvent(asmTraceID, strmEvent);
 
-      matchingStart = db->getDynamicInfo().matchingDeviceEventStart(deviceId, asmTraceID, streamEventType);
+      matchingStart = findMatchingStart(asmTraceID, streamEventType);
     }
   }
 
@@ -733,6 +881,107 @@ namespace xdp {
     return ((clockTrainSlope * (double)deviceTimestamp) + clockTrainOffset)/1e6;
   }
 
+  void PLDeviceTraceLogger::logMonitorPacket(uint64_t trace,
+                                             double hostTimestamp,
+                                             uint8_t kind)
+  {
+    if (kind & AM_PACKET) {
+      addAMEvent(trace, hostTimestamp);
+    }
+    if (kind & AIM_PACKET) {
+      addAIMEvent(trace, hostTimestamp);
+    }
+    if (kind & ASM_PACKET) {
+      addASMEvent(trace, hostTimestamp);
+    }
+  }
+
+  // Worker threads and the calling thread take the next partition
+  //  until all are decoded.  Each partition is decoded in packet order,
+  //  exactly as if decoded sequentially.
+  void PLDeviceTraceLogger::decodePartitions()
+  {
+    std::atomic<size_t> next {0};
+    auto decode = [this, &next] {
+      for (auto index = next++; index < partitions.size(); index = next++) {
+        auto& partition = partitions[index];
+        for (auto& packet : partition.packets)
+          logMonitorPacket(packet.first, packet.second, classifyPacket(packet.first));
+        partition.packets.clear();
+        sortByTimestamp(partition.events);
+      }
+    };
+
+    auto numWorkers = std::min<size_t>(decodeThreads, partitions.size()) - 1;
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < numWorkers; ++i)
+      workers.emplace_back(decode);
+    decode();
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  // Merge the sorted events of all partitions by timestamp and add them
+  //  to the database in one batch, then log the CU statistics
+  void PLDeviceTraceLogger::mergePartitions()
+  {
+    using range = std::pair<std::vector<VTFEvent*>::iterator,
+                            std::vector<VTFEvent*>::iterator>;
+    auto later = [](const range& a, const range& b)
+      { return (*a.first)->getTimestamp() > (*b.first)->getTimestamp(); };
+    std::priority_queue<range, std::vector<range>, decltype(later)> heads(later);
+
+    size_t numEvents = 0;
+    for (auto& partition : partitions) {
+      if (partition.events.empty())
+        continue;
+      heads.emplace(partition.events.begin(), partition.events.end());
+      numEvents += partition.events.size();
+    }
+
+    if (numEvents) {
+      std::vector<VTFEvent*> merged;
+      merged.reserve(numEvents);
+      while (!heads.empty()) {
+        auto head = heads.top();
+        heads.pop();
+        merged.push_back(*head.first);
+        if (++head.first != head.second)
+          heads.push(head);
+      }
+      db->getDynamicInfo().addPLTraceEvents(deviceId, merged);
+    }
+
+    double firstKernelStartTime = 0.0;
+    double lastKernelEndTime = 0.0;
+    for (auto& partition : partitions) {
+      partition.events.clear();
+
+      // NOTE: At this stage, we don't know the global work size, so let's
+      //       leave it to the database to fill that in.
+      for (auto& execution : partition.cuExecutions) {
+        auto cu = db->getStaticInfo().getCU(deviceId, execution.first);
+        (db->getStats()).logComputeUnitExecution(cu->getName(),
+                                                 cu->getKernelName(),
+                                                 cu->getDim(),
+                                                 "",
+                                                 execution.second);
+      }
+      partition.cuExecutions.clear();
+
+      if (partition.firstKernelStartTime != 0.0 &&
+          (firstKernelStartTime == 0.0 ||
+           partition.firstKernelStartTime < firstKernelStartTime))
+        firstKernelStartTime = partition.firstKernelStartTime;
+      lastKernelEndTime = std::max(lastKernelEndTime, partition.lastKernelEndTime);
+    }
+
+    if (firstKernelStartTime != 0.0)
+      (db->getStats()).setFirstKernelStartTime(firstKernelStartTime);
+    if (lastKernelEndTime != 0.0)
+      (db->getStats()).setLastKernelEndTime(lastKernelEndTime);
+  }
+
   void PLDeviceTraceLogger::processTraceData(void* data, uint64_t numBytes)
   {
     if (numBytes == 0)
@@ -767,67 +1016,79 @@ namespace xdp {
     static uint32_t modulus = 0;
     static uint64_t clockTrainingHostTimestamp = 0;
 
-    for (uint64_t i = start ; i < numPackets ; ++i) {
-      uint64_t packet = (static_cast<uint64_t*>(data))[i];
-      auto deviceTimestamp = getDeviceTimestamp(packet);
-      auto traceId = getTraceId(packet);
-      auto clockTrainingDeviceTimestamp = deviceTimestamp;
-
-      /*
-      if (i == start && firstTimestamp == 0) {
-        firstTimestamp = deviceTimestamp ;
+    // With multiple decode threads, monitor packets are demultiplexed
+    //  into partitions and decoded after clock training has assigned
+    //  host timestamps to all of them
+    bool parallel = decodeThreads > 1 && partitions.size() > 1 &&
+                    numPackets >= TRACE_PARALLEL_DECODE_MIN_PACKETS;
+
+    // Packets are decoded a batch at a time.  The classification pass
+    //  is a tight loop over the raw data, and batches holding nothing
+    //  of interest are skipped without touching any decoder state.
+    auto packets = static_cast<uint64_t*>(data);
+    uint8_t kind[TRACE_DECODE_BATCH_SIZE];
+
+    for (uint64_t batch = start ; batch < numPackets ; batch += TRACE_DECODE_BATCH_SIZE) {
+      uint64_t count = std::min<uint64_t>(TRACE_DECODE_BATCH_SIZE, numPackets - batch);
+      uint8_t any = 0;
+      for (uint64_t k = 0 ; k < count ; ++k) {
+        kind[k] = classifyPacket(packets[batch + k]);
+        any |= kind[k];
       }
-      */
+      if (!any)
+        continue;
 
-      if (isClockTraining(packet)) {
-        if (modulus == 0) {
-          if (clockTrainingDeviceTimestamp >= firstTimestamp) {
-            clockTrainingDeviceTimestamp =
-              clockTrainingDeviceTimestamp - firstTimestamp;
+      for (uint64_t k = 0 ; k < count ; ++k) {
+        if (!kind[k])
+          continue;
+
+        uint64_t packet = packets[batch + k];
+        auto deviceTimestamp = getDeviceTimestamp(packet);
+
+        if (kind[k] & CLOCK_TRAINING_PACKET) {
+          auto clockTrainingDeviceTimestamp = deviceTimestamp;
+          if (modulus == 0) {
+            if (clockTrainingDeviceTimestamp >= firstTimestamp) {
+              clockTrainingDeviceTimestamp =
+                clockTrainingDeviceTimestamp - firstTimestamp;
+            }
+            else {
+              clockTrainingDeviceTimestamp =
+                clockTrainingDeviceTimestamp + (0x1FFFFFFFFFFF - firstTimestamp);
+            }
           }
-          else {
-            clockTrainingDeviceTimestamp =
-              clockTrainingDeviceTimestamp + (0x1FFFFFFFFFFF - firstTimestamp);
+          clockTrainingHostTimestamp |= ((packet >> 45) & 0xFFFF) << (16 * modulus);
+          ++modulus;
+          if (modulus == 4) {
+            // It requires four complete clock training packets before
+            //  we can perform the clock training algorithm
+            trainDeviceHostTimestamps(clockTrainingDeviceTimestamp,
+                                      clockTrainingHostTimestamp);
+            clockTrainingHostTimestamp = 0;
+            modulus = 0;
           }
+          continue;
         }
-        clockTrainingHostTimestamp |= ((packet >> 45) & 0xFFFF) << (16 * modulus);
-        ++modulus;
-        if (modulus == 4) {
-          // It requires four complete clock training packets before
-          //  we can perform the clock training algorithm
-          trainDeviceHostTimestamps(clockTrainingDeviceTimestamp,
-                                    clockTrainingHostTimestamp);
-          clockTrainingHostTimestamp = 0;
-          clockTrainingDeviceTimestamp = 0;
-          modulus = 0;
-        }
-        continue;
-      }
 
-      bool AMPacket  = (traceId >= util::min_trace_id_am &&
-                        traceId <= util::max_trace_id_am);
-      bool AIMPacket = (traceId <= util::max_trace_id_aim); // min trace id aim == 0
-      bool ASMPacket = (traceId >= util::min_trace_id_asm &&
-                        traceId <  util::max_trace_id_asm);
-      if (!AMPacket && !AIMPacket && !ASMPacket) {
-        continue;
-      }
+        double hostTimestamp = convertDeviceToHostTimestamp(deviceTimestamp);
+        if (parallel)
+          partitions[partitionOf[getTraceId(packet)]].packets.emplace_back(packet, hostTimestamp);
+        else
+          logMonitorPacket(packet, hostTimestamp, kind[k]);
 
-      double hostTimestamp = convertDeviceToHostTimestamp(deviceTimestamp);
-      if (AMPacket) {
-        addAMEvent(packet, hostTimestamp);
-      }
-      if (AIMPacket) {
-        addAIMEvent(packet, hostTimestamp);
-      }
-      if (ASMPacket) {
-        addASMEvent(packet, hostTimestamp);
+        // keep track of latest timestamp that comes through trace
+        mLatestHostTimestampMs = hostTimestamp;
       }
-
-      // keep track of latest timestamp that comes through trace
-      mLatestHostTimestampMs = hostTimestamp;
     }
 
+    if (parallel) {
+      decodePartitions();
+    }
+    else {
+      for (auto& partition : partitions)
+        sortByTimestamp(partition.events);
+    }
+    mergePartitions();
   }
 
   void PLDeviceTraceLogger::endProcessTraceData()
@@ -835,6 +1096,10 @@ namespace xdp {
     addApproximateCUEndEvents();
     addApproximateDataTransferEndEvents();
     addApproximateStreamEndEvents();
+
+    for (auto& partition : partitions)
+      sortByTimestamp(partition.events);
+    mergePartitions();
   }
 
   void PLDeviceTraceLogger::addEventMarkers(bool isFIFOFull, bool isTS2MMFull)
@@ -18,6 +18,7 @@
 #ifndef _XDP_PROFILE_DEVICE_BASE_TRACE_LOGGER_H
 #define _XDP_PROFILE_DEVICE_BASE_TRACE_LOGGER_H
 
+#include <utility>
 #include <vector>
 
 #include "xdp/config.h"
@@ -44,6 +45,41 @@ namespace xdp {
     std::vector<uint64_t> aimLastTrans;
     std::vector<uint64_t> asmLastTrans;
 
+    // Outstanding device event starts indexed by trace ID.  A trace ID
+    //  is only ever decoded by one partition, so no locking is needed.
+    std::vector<std::vector<DeviceEventInfo>> startEvents;
+
+    // A partition holds all monitors attached to one CU, or a single
+    //  monitor not attached to any CU.  Decoding of one partition never
+    //  touches the state of another, so partitions can be decoded in
+    //  parallel.  Decoded events and statistics are kept with the
+    //  partition until they are merged into the database.
+    struct Partition
+    {
+      std::vector<std::pair<uint64_t, double>> packets; // with host timestamp
+      std::vector<VTFEvent*> events;
+      std::vector<std::pair<int32_t, double>> cuExecutions; // CU, time
+      double firstKernelStartTime = 0.0;
+      double lastKernelEndTime = 0.0;
+      uint64_t nextEventId = 0;
+      uint64_t lastEventId = 0;
+    };
+    std::vector<Partition> partitions;
+    std::vector<uint32_t> partitionOf; // indexed by trace ID
+    unsigned int decodeThreads = 0;
+
+    void createPartitions();
+    void decodePartitions();
+    void mergePartitions();
+
+    // Device event start matching and event logging on behalf of the
+    //  partition owning the trace ID
+    void markStart(uint64_t traceId, const DeviceEventInfo& info);
+    DeviceEventInfo findMatchingStart(uint64_t traceId, VTFEventType type);
+    bool hasMatchingStart(uint64_t traceId, VTFEventType type);
+    void logEvent(uint64_t traceId, VTFEvent* event);
+    void logMonitorPacket(uint64_t trace, double hostTimestamp, uint8_t kind);
+
     // Parsing functions for getting different parts of a device event packet
     inline uint64_t getDeviceTimestamp(uint64_t trace)
       { return (trace & 0x1FFFFFFFFFFF) - firstTimestamp; }
@@ -84,7 +120,7 @@ namespace xdp {
                                     double hostTimestamp, uint64_t memStrId) ;
 
     void addCUEndEvent(double hostTimestamp, uint64_t deviceTimestamp,
-                       uint32_t s, int32_t cuId);
+                       uint32_t s, uint64_t monTraceId, int32_t cuId);
 
     // Functions for handling dropped device packets
     void addApproximateCUEndEvents();
@@ -21,6 +21,8 @@
 #include "xdp/profile/device/pl_device_trace_logger.h"
 #include "xrt/experimental/xrt_profile.h"
 
+#include <algorithm>
+
 namespace xdp {
 
 PLDeviceTraceOffload::
@@ -36,6 +38,7 @@ PLDeviceTraceOffload
   , m_prev_clk_train_time(std::chrono::system_clock::now())
   , m_process_trace(false)
   , m_process_trace_done(false)
+  , m_process_thread_active(false)
 {
   // Select appropriate reader
   if (has_fifo()) {
@@ -64,6 +67,7 @@ void PLDeviceTraceOffload::
 offload_device_continuous()
 {
   if (!m_initialized) {
+    m_process_trace = false;
     offload_finished();
     return;
   }
@@ -107,15 +111,17 @@ process_trace_continuous()
   if (!has_ts2mm())
     return;
 
-  m_process_trace = true;
-  m_process_trace_done = false;
   while (m_process_trace)
   {
     process_trace();
-    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_interval_ms));
+    // Offload hands over chunks much faster than they are processed,
+    // so only back off when there is nothing to do
+    if (chunk_ring.empty())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
   }
   // One last time
   process_trace();
+  m_process_thread_active = false;
   m_process_trace_done = true;
 }
 
@@ -125,35 +131,16 @@ process_trace()
   if (!has_ts2mm())
     return;
 
-  bool q_read = false;
-  bool q_empty = true;
-  std::unique_ptr<unsigned char[]> buf;
-  uint64_t size = 0;
-  do {
-    q_read=false;
-    ts2mm_info.process_queue_lock.lock();
-    if (!ts2mm_info.data_queue.empty()) {
-      buf = std::move(ts2mm_info.data_queue.front());
-      size = ts2mm_info.size_queue.front();
-      ts2mm_info.data_queue.pop();
-      ts2mm_info.size_queue.pop();
-      q_read = true;
-      q_empty = ts2mm_info.data_queue.empty();
-    }
-    if (ts2mm_info.size_queue.size() > TS2MM_QUEUE_SZ_WARN_THRESHOLD) {
-      std::call_once(ts2mm_queue_warning_flag, [](){
-        xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", TS2MM_WARN_MSG_QUEUE_SZ);
-      });
-    }
-    ts2mm_info.process_queue_lock.unlock();
-
-    // Processing takes a lot more time compared to everything else
-    if (q_read) {
-      debug_stream << "Process " << size << " bytes of trace" << std::endl;
-      deviceTraceLogger->processTraceData(buf.get(), size) ;
-      buf.reset();
-    }
-  } while (!q_empty);
+  // Chunks are decoded in place and released back to the offload
+  // thread only after processing, so no data is copied or freed here
+  while (!chunk_ring.empty()) {
+    auto& chunk = chunk_ring.front();
+    debug_stream << "Process " << chunk.size << " bytes of trace" << std::endl;
+    deviceTraceLogger->processTraceData(const_cast<void*>(chunk.data), chunk.size);
+    chunk.data = nullptr;
+    chunk.size = 0;
+    chunk_ring.pop();
+  }
 }
 
 bool PLDeviceTraceOffload::
@@ -173,8 +160,15 @@ start_offload(OffloadThreadType type)
   status = OffloadThreadStatus::RUNNING;
 
   if (type == OffloadThreadType::TRACE) {
-    offload_thread = std::thread(&PLDeviceTraceOffload::offload_device_continuous, this);
+    // Mark processing as active before the offload thread starts pushing
+    // chunks, otherwise it could try to drain the ring itself
+    if (has_ts2mm()) {
+      m_process_trace = true;
+      m_process_trace_done = false;
+      m_process_thread_active = true;
+    }
     process_thread = std::thread(&PLDeviceTraceOffload::process_trace_continuous, this);
+    offload_thread = std::thread(&PLDeviceTraceOffload::offload_device_continuous, this);
   } else if (type == OffloadThreadType::CLOCK_TRAIN) {
     offload_thread = std::thread(&PLDeviceTraceOffload::train_clock_continuous, this);
   }
@@ -393,13 +387,19 @@ sync_and_log(uint64_t index)
     return false;
   }
 
-  auto tmp = std::make_unique<unsigned char[]>(nBytes);
-  std::memcpy(tmp.get(), host_buf, nBytes);
-  // Push new data into queue for processing
-  ts2mm_info.process_queue_lock.lock();
-  ts2mm_info.data_queue.push(std::move(tmp));
-  ts2mm_info.size_queue.push(nBytes);
-  ts2mm_info.process_queue_lock.unlock();
+  // Hand the data over to the process thread.  Without circular buffer
+  // the device never writes this region again, so the mapped buffer
+  // itself is handed over.  With circular buffer it must be copied out
+  // before the device wraps around, one ring chunk at a time.
+  if (!ts2mm_info.use_circ_buf) {
+    push_chunk(host_buf, nBytes, false);
+  }
+  else {
+    auto capacity = chunk_ring.chunk_capacity();
+    auto src = static_cast<const unsigned char*>(host_buf);
+    for (uint64_t done = 0; done < nBytes; done += capacity)
+      push_chunk(src + done, std::min(capacity, nBytes - done), true);
+  }
 
   // Print warning if processing large amount of trace
   if (nBytes > TS2MM_WARN_BIG_BUF_SIZE && !bd.big_trace_warn_done) {
@@ -413,6 +413,34 @@ sync_and_log(uint64_t index)
   return true;
 }
 
+void PLDeviceTraceOffload::
+push_chunk(const void* data, uint64_t size, bool copy)
+{
+  // Wait for the process thread to release a chunk.  When there is no
+  // process thread (offload at end of application), drain it here.
+  while (chunk_ring.full()) {
+    if (!m_process_thread_active) {
+      process_trace();
+      continue;
+    }
+    std::call_once(ts2mm_queue_warning_flag, [](){
+      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", TS2MM_WARN_MSG_QUEUE_SZ);
+    });
+    std::this_thread::yield();
+  }
+
+  auto& chunk = chunk_ring.back();
+  if (copy) {
+    std::memcpy(chunk.storage.data(), data, size);
+    chunk.data = chunk.storage.data();
+  }
+  else {
+    chunk.data = data;
+  }
+  chunk.size = size;
+  chunk_ring.push();
+}
+
 bool PLDeviceTraceOffload::
 init_s2mm(bool circ_buf, const std::vector<uint64_t> &buf_sizes)
 {
@@ -437,6 +465,17 @@ init_s2mm(bool circ_buf, const std::vector<uint64_t> &buf_sizes)
     }
   }
 
+  // Chunks own storage only when trace must be copied out of a
+  // circular buffer.  Size them for the largest trace buffer, but no
+  // larger than the maximum chunk size.
+  uint64_t chunk_bytes = 0;
+  if (ts2mm_info.use_circ_buf) {
+    chunk_bytes = *std::max_element(buf_sizes.begin(), buf_sizes.end());
+    chunk_bytes = std::min<uint64_t>(chunk_bytes, TS2MM_RING_CHUNK_SIZE);
+    chunk_bytes -= chunk_bytes % TRACE_PACKET_SIZE;
+  }
+  chunk_ring.init(TS2MM_RING_NUM_CHUNKS, chunk_bytes);
+
   for (uint64_t i = 0; i < ts2mm_info.num_ts2mm; i++) {
     auto& bd = ts2mm_info.buffers[i];
     bd.alloc_size = buf_sizes[i];
@@ -473,6 +512,7 @@ reset_s2mm()
     ts2mm_info.buffers[i].bufId = 0;
   }
   ts2mm_info.buffers.clear();
+  chunk_ring.clear();
 }
 
 bool PLDeviceTraceOffload::
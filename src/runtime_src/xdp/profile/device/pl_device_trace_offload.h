@@ -33,8 +33,8 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace xdp {
 
@@ -89,10 +89,6 @@ struct Ts2mmInfo {
   uint64_t circ_buf_min_rate = TS2MM_DEF_BUF_SIZE * 100;
   uint64_t circ_buf_cur_rate;
 
-  std::queue<std::unique_ptr<unsigned char[]>> data_queue;
-  std::queue<uint64_t> size_queue;
-  std::mutex process_queue_lock;
-
   Ts2mmInfo()
     : num_ts2mm(0),
       full_buf_size(0),
@@ -102,6 +98,91 @@ struct Ts2mmInfo {
   
 };
 
+// A chunk of offloaded trace waiting to be processed.  In circular
+// buffer mode the device can overwrite the host mapping, so the data is
+// copied into the chunk's own storage, which is allocated once when the
+// ring is initialized.  Otherwise the chunk points straight into the
+// mapped trace buffer and nothing is copied.
+struct TraceChunk {
+  std::vector<uint64_t> storage;
+  const void* data = nullptr;
+  uint64_t size = 0;
+};
+
+// Fixed size ring of trace chunks handed from the offload thread
+// (single producer) to the process thread (single consumer).  Only the
+// indices are shared between the threads, the chunks themselves are
+// never reallocated after init.
+class TraceChunkRing {
+  std::vector<TraceChunk> chunks;
+  std::atomic<uint64_t> head {0};  // next chunk to process
+  std::atomic<uint64_t> tail {0};  // next chunk to fill
+
+public:
+  void
+  init(size_t num_chunks, uint64_t chunk_bytes)
+  {
+    chunks.resize(num_chunks);
+    for (auto& chunk : chunks)
+      chunk.storage.resize(chunk_bytes / sizeof(uint64_t));
+    head = 0;
+    tail = 0;
+  }
+
+  void
+  clear()
+  {
+    chunks.clear();
+    head = 0;
+    tail = 0;
+  }
+
+  // Bytes each chunk can hold when data must be copied
+  uint64_t
+  chunk_capacity() const
+  {
+    return chunks.empty() ? 0 : chunks.front().storage.size() * sizeof(uint64_t);
+  }
+
+  bool
+  empty() const
+  {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+  }
+
+  bool
+  full() const
+  {
+    return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) >= chunks.size();
+  }
+
+  // Producer side, valid only when !full()
+  TraceChunk&
+  back()
+  {
+    return chunks[tail.load(std::memory_order_relaxed) % chunks.size()];
+  }
+
+  void
+  push()
+  {
+    tail.fetch_add(1, std::memory_order_release);
+  }
+
+  // Consumer side, valid only when !empty()
+  TraceChunk&
+  front()
+  {
+    return chunks[head.load(std::memory_order_relaxed) % chunks.size()];
+  }
+
+  void
+  pop()
+  {
+    head.fetch_add(1, std::memory_order_release);
+  }
+};
+
 class PLDeviceTraceLogger;
 
 #define debug_stream \
@@ -169,6 +250,7 @@ private:
   void offload_finished();
   void process_trace_continuous();
   bool sync_and_log(uint64_t index);
+  void push_chunk(const void* data, uint64_t size, bool copy);
 
 protected:
   PLDeviceIntf* dev_intf;
@@ -179,6 +261,7 @@ private:
   PLDeviceTraceLogger* deviceTraceLogger;
   std::function<void(bool)> m_read_trace;
   Ts2mmInfo ts2mm_info;
+  TraceChunkRing chunk_ring;
 
   // fifo doesn't support circular buffer mode
   bool fifo_full = false;
@@ -198,6 +281,8 @@ private:
   // Internal flags to end trace processing thread
   std::atomic<bool> m_process_trace;
   std::atomic<bool> m_process_trace_done;
+  // True while a process thread is draining the chunk ring
+  std::atomic<bool> m_process_thread_active;
 
   // Internal flags to keep track of warnings
   std::once_flag ts2mm_queue_warning_flag;
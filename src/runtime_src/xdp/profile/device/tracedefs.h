@@ -51,9 +51,16 @@
 // Read data only if it's more than 512B unless forced
 #define TS2MM_MIN_READ_SIZE      0x200
 #define DEFAULT_TRACE_OFFLOAD_INTERVAL_MS 10
-// Throw warning when too much trace in processing pipeline
-// Use some arbitrary large number here
-#define TS2MM_QUEUE_SZ_WARN_THRESHOLD 5000
+// Number of pre-allocated chunks in the offload -> process ring
+#define TS2MM_RING_NUM_CHUNKS   16
+// Largest single chunk handed to the process thread (4 MB)
+#define TS2MM_RING_CHUNK_SIZE   0x400000
+// Number of packets classified together by the trace decoder
+#define TRACE_DECODE_BATCH_SIZE 64
+// Fewest packets in a chunk worth decoding on multiple threads
+#define TRACE_PARALLEL_DECODE_MIN_PACKETS 0x4000
+// Number of event ids reserved at a time by a trace decode partition
+#define TRACE_EVENT_ID_BLOCK_SIZE 256
 
 // In some cases, we cannot use coarse mode
 #define COARSE_MODE_UNSUPPORTED "Coarse mode cannot be enabled. Defaulting to fine mode. Please check compilation for details."
@@ -74,7 +81,7 @@ Please increase trace_buffer_size or use 'coarse' option for device_trace or tur
 buffer size and/or reduce trace_buffer_offload_interval."
 #define TS2MM_WARN_MSG_CIRC_BUF_OVERWRITE   "Circular buffer overwrite was detected in device trace. Timeline trace could be incomplete."
 #define TS2MM_WARN_MSG_BIG_BUF         "Processing large amount of device trace. It could take a while before application ends."
-#define TS2MM_WARN_MSG_QUEUE_SZ        "Too much trace in processing queue. This could have negative impact on host memory utilization. \
+#define TS2MM_WARN_MSG_QUEUE_SZ        "Trace processing cannot keep up with trace offload and is delaying it. Trace could be incomplete. \
 Please increase trace_buffer_size and trace_buffer_offload_interval together or use 'coarse' option for device_trace."
 
 // Throw warning if following thresholds aren't met for reuse_buffer
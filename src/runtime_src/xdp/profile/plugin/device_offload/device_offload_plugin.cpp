@@ -133,17 +133,23 @@ namespace xdp {
     std::string xrtVersion   = xdp::getXRTVersion() ;
     std::string toolVersion  = xdp::getToolVersion() ;
 
+    // The columnar format is much faster to write for large traces and
+    //  is converted to the CSV on demand
+    bool columnar = (xrt_core::config::get_device_trace_format() == "columnar") ;
+
     std::string filename = 
-      "device_trace_" + std::to_string(deviceId) + ".csv" ;
+      "device_trace_" + std::to_string(deviceId) + (columnar ? ".xdpcol" : ".csv") ;
 
     VPWriter* writer = new DeviceTraceWriter(filename.c_str(),
                                              deviceId,
                                              version,
                                              creationTime,
                                              xrtVersion,
-                                             toolVersion);
+                                             toolVersion,
+                                             columnar);
     writers.push_back(writer);
-    (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(), "VP_TRACE") ;
+    (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(),
+                                        columnar ? "VP_TRACE_COLUMNAR" : "VP_TRACE") ;
 
     if (continuous_trace)
       XDPPlugin::startWriteThread(XDPPlugin::get_trace_file_dump_int_s(), "VP_TRACE");
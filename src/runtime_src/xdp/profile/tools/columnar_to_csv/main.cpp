@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "xdp/profile/writer/vp_base/columnar_writer.h"
+
+// Convert a columnar device trace (Debug.device_trace_format=columnar)
+//  into the CSV that is generated by default
+int main(int argc, char* argv[])
+{
+  if (argc != 2 && argc != 3) {
+    std::cout << "Usage: " << argv[0] << " <Columnar Trace File> [Output CSV File]\n";
+    return 0;
+  }
+
+  std::string inputFile = argv[1];
+  std::string outputFile;
+  if (argc == 3) {
+    outputFile = argv[2];
+  }
+  else {
+    // device_trace_0.xdpcol -> device_trace_0.csv
+    auto pos = inputFile.rfind('.');
+    outputFile = inputFile.substr(0, pos) + ".csv";
+  }
+
+  std::ifstream fin(inputFile, std::ios::binary | std::ios::in);
+  if (!fin) {
+    std::cerr << "Cannot open columnar trace file " << inputFile << std::endl;
+    return 1;
+  }
+
+  std::ofstream fout(outputFile);
+  if (!fout) {
+    std::cerr << "Cannot open output file " << outputFile << std::endl;
+    return 1;
+  }
+
+  if (!xdp::columnar::convertToCSV(fin, fout)) {
+    std::cerr << inputFile << " is not a valid columnar trace file" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
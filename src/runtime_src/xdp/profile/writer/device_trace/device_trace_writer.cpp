@@ -30,12 +30,17 @@ namespace xdp {
                                        const std::string& version,
                                        const std::string& creationTime,
                                        const std::string& xrtV,
-                                       const std::string& toolV)
+                                       const std::string& toolV,
+                                       bool columnarFormat)
     : VPTraceWriter(filename, version, creationTime, 9 /* ns */),
       xrtVersion(xrtV),
       toolVersion(toolV),
       deviceId(devId)
   {
+    if (columnarFormat) {
+      setBinaryMode();
+      columnar = std::make_unique<columnar::ColumnarWriter>(fout);
+    }
   }
 
   DeviceTraceWriter::~DeviceTraceWriter()
@@ -322,6 +327,9 @@ namespace xdp {
   void DeviceTraceWriter::writeTraceEvents()
   {
     fout << "EVENTS\n";
+    if (columnar)
+      columnar->endText();
+
     auto DeviceEvents = db->getDynamicInfo().moveDeviceEvents(deviceId);
 
     auto& loadedConfigs =
@@ -358,7 +366,20 @@ namespace xdp {
           continue; // Coverity - In case dynamic cast fails
         std::pair<XclbinInfo*, int32_t> index =
           std::make_pair(xclbin, cuId);
-        kernelEvent->dump(fout, cuBucketIdMap[index] + eventType - KERNEL);
+        uint32_t bucket = cuBucketIdMap[index] + eventType - KERNEL;
+        if (columnar) {
+          std::string toolTips;
+          for (const auto& iter : xclbin->pl.cus) {
+            ComputeUnitInstance* cu = iter.second;
+            if (cu->getAccelMon() == cuId) {
+              toolTips += "," + std::to_string(db->getDynamicInfo().addString(cu->getKernelName()));
+              toolTips += "," + std::to_string(db->getDynamicInfo().addString(cu->getName()));
+            }
+          }
+          writeEvent(kernelEvent, bucket, toolTips);
+          continue;
+        }
+        kernelEvent->dump(fout, bucket);
         // Also output the tool tips
         for (const auto& iter : xclbin->pl.cus) {
           ComputeUnitInstance* cu = iter.second;
@@ -373,14 +394,18 @@ namespace xdp {
                 || KERNEL_STALL_PIPE == eventType) {
         std::pair<XclbinInfo*, int32_t> index =
           std::make_pair(xclbin, cuId);
-        deviceEvent->dump(fout, cuBucketIdMap[index] + eventType - KERNEL);
+        writeEvent(deviceEvent, cuBucketIdMap[index] + eventType - KERNEL);
       } else {
         // Memory or Stream Acceses
         uint32_t monId = deviceEvent->getMonitorId();
         DeviceMemoryAccess* memoryEvent = dynamic_cast<DeviceMemoryAccess*>(e.get());
         if (memoryEvent) {
           std::pair<XclbinInfo*, uint32_t> index =std::make_pair(xclbin, monId);
-          deviceEvent->dump(fout, aimBucketIdMap[index] + eventType - KERNEL_READ);
+          uint32_t bucket = aimBucketIdMap[index] + eventType - KERNEL_READ;
+          if (columnar)
+            writeEvent(deviceEvent, bucket, "," + std::to_string(memoryEvent->getMemoryName()));
+          else
+            deviceEvent->dump(fout, bucket);
           continue;
         }
         DeviceStreamAccess* streamEvent = dynamic_cast<DeviceStreamAccess*>(e.get());
@@ -388,9 +413,9 @@ namespace xdp {
           std::pair<XclbinInfo*, uint32_t> index = std::make_pair(xclbin, monId);
           if (KERNEL_STREAM_READ == eventType || KERNEL_STREAM_READ_STALL == eventType
                                               || KERNEL_STREAM_READ_STARVE == eventType) {
-            deviceEvent->dump(fout, asmBucketIdMap[index] + eventType - KERNEL_STREAM_READ);
+            writeEvent(deviceEvent, asmBucketIdMap[index] + eventType - KERNEL_STREAM_READ);
           } else {
-            deviceEvent->dump(fout, asmBucketIdMap[index] + eventType - KERNEL_STREAM_WRITE);
+            writeEvent(deviceEvent, asmBucketIdMap[index] + eventType - KERNEL_STREAM_WRITE);
           }
           continue;
         }
@@ -400,6 +425,18 @@ namespace xdp {
 
   }
 
+  void DeviceTraceWriter::writeEvent(VTFDeviceEvent* event, uint32_t bucket,
+                                     const std::string& suffix)
+  {
+    if (!columnar) {
+      event->dump(fout, bucket);
+      return;
+    }
+    columnar->addEvent(event->getEventId(), event->getStartId(),
+                       event->getTimestamp(), bucket, event->getTypeName(),
+                       suffix);
+  }
+
   void DeviceTraceWriter::writeDependencies()
   {
     fout << "DEPENDENCIES\n";
@@ -418,6 +455,12 @@ namespace xdp {
 
     initialize();
 
+    // In the columnar format everything but the events is kept as text
+    if (columnar) {
+      columnar->start();
+      columnar->beginText();
+    }
+
     writeHeader();
     fout << "\n";
     writeStructure();
@@ -425,15 +468,23 @@ namespace xdp {
     writeStringTable();
     fout << "\n";
     writeTraceEvents();
+    if (columnar) {
+      columnar->flushEvents();
+      columnar->beginText();
+    }
     fout << "\n";
     writeDependencies();
     fout << "\n";
 
+    if (columnar)
+      columnar->endText();
+
     fout.flush();
 
     if (openNewFile) {
       switchFiles();
-      db->getStaticInfo().addOpenedFile(getcurrentFileName(), "VP_TRACE");
+      db->getStaticInfo().addOpenedFile(getcurrentFileName(),
+                                        columnar ? "VP_TRACE_COLUMNAR" : "VP_TRACE");
     }
     return true;
   }
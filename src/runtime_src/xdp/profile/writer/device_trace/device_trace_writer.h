@@ -18,10 +18,12 @@
 #ifndef HAL_DEVICE_TRACE_WRITER_DOT_H
 #define HAL_DEVICE_TRACE_WRITER_DOT_H
 
+#include <memory>
 #include <string>
 
 #include "xdp/profile/database/database.h"
 #include "xdp/profile/device/pl_device_intf.h"
+#include "xdp/profile/writer/vp_base/columnar_writer.h"
 #include "xdp/profile/writer/vp_base/vp_trace_writer.h"
 
 namespace xdp {
@@ -41,6 +43,9 @@ namespace xdp {
 
     uint64_t deviceId;
 
+    // Set when events are written in the columnar binary format
+    std::unique_ptr<columnar::ColumnarWriter> columnar;
+
     // Helper function for making sure the database has enough information
     //  to print out all of the information it will need.
     void initialize() ;
@@ -56,6 +61,10 @@ namespace xdp {
     void writeFloatingMemoryTransfersStructure(XclbinInfo* xclbin, uint32_t& rowCount) ;
     void writeFloatingStreamTransfersStructure(XclbinInfo* xclbin, uint32_t& rowCount) ;
 
+    // Write a single event, the suffix holds the fields specific to the
+    //  event type and is only used by the columnar format
+    void writeEvent(VTFDeviceEvent* event, uint32_t bucket, const std::string& suffix = "") ;
+
   protected:
     virtual void writeHeader() ;
     virtual void writeStructure() ;
@@ -67,7 +76,8 @@ namespace xdp {
     DeviceTraceWriter(const char* filename, uint64_t deviceId, const std::string& version,
 		      const std::string& creationTime,
 		      const std::string& xrtV,
-		      const std::string& toolV);
+		      const std::string& toolV,
+		      bool columnarFormat = false);
     
     ~DeviceTraceWriter() ;
 
@@ -0,0 +1,242 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "xdp/profile/writer/vp_base/columnar_writer.h"
+
+namespace {
+
+  template <typename T>
+  void writeValue(std::ostream& out, T value)
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T)) ;
+  }
+
+  template <typename T>
+  void writeColumn(std::ostream& out, const std::vector<T>& column)
+  {
+    out.write(reinterpret_cast<const char*>(column.data()),
+              static_cast<std::streamsize>(column.size() * sizeof(T))) ;
+  }
+
+  template <typename T>
+  bool readValue(std::istream& in, T& value)
+  {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T))) ;
+  }
+
+  template <typename T>
+  bool readColumn(std::istream& in, std::vector<T>& column, uint32_t rows)
+  {
+    column.resize(rows) ;
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(column.data()),
+                                     static_cast<std::streamsize>(rows * sizeof(T)))) ;
+  }
+
+} // end anonymous namespace
+
+namespace xdp::columnar {
+
+  ColumnarWriter::ColumnarWriter(std::ostream& o) : out(o)
+  {
+    ids.reserve(rowsPerChunk) ;
+    startIds.reserve(rowsPerChunk) ;
+    timestamps.reserve(rowsPerChunk) ;
+    buckets.reserve(rowsPerChunk) ;
+    types.reserve(rowsPerChunk) ;
+    suffixes.reserve(rowsPerChunk) ;
+  }
+
+  void ColumnarWriter::start()
+  {
+    dictionary.clear() ;
+    newEntries.clear() ;
+    out.write(magic, magicSize) ;
+  }
+
+  void ColumnarWriter::beginText()
+  {
+    writeValue(out, TEXT_CHUNK) ;
+    textSizePos = out.tellp() ;
+    writeValue(out, uint64_t(0)) ;
+  }
+
+  void ColumnarWriter::endText()
+  {
+    if (textSizePos == std::streampos(-1))
+      return ;
+
+    auto end = out.tellp() ;
+    auto size = static_cast<uint64_t>(end - textSizePos) - sizeof(uint64_t) ;
+    out.seekp(textSizePos) ;
+    writeValue(out, size) ;
+    out.seekp(end) ;
+    textSizePos = -1 ;
+  }
+
+  uint32_t ColumnarWriter::lookup(const std::string& str)
+  {
+    auto result = dictionary.emplace(str, static_cast<uint32_t>(dictionary.size())) ;
+    if (result.second)
+      newEntries.push_back(&(result.first->first)) ;
+    return result.first->second ;
+  }
+
+  void ColumnarWriter::addEvent(uint64_t id, uint64_t startId, double timestamp,
+                                uint32_t bucket, const std::string& type,
+                                const std::string& suffix)
+  {
+    ids.push_back(id) ;
+    startIds.push_back(startId) ;
+    timestamps.push_back(timestamp) ;
+    buckets.push_back(bucket) ;
+    types.push_back(lookup(type)) ;
+    suffixes.push_back(lookup(suffix)) ;
+
+    if (ids.size() >= rowsPerChunk)
+      flushEvents() ;
+  }
+
+  void ColumnarWriter::writeDictionary()
+  {
+    if (newEntries.empty())
+      return ;
+
+    uint64_t size = sizeof(uint32_t) ;
+    for (auto entry : newEntries)
+      size += sizeof(uint32_t) + entry->size() ;
+
+    writeValue(out, DICTIONARY_CHUNK) ;
+    writeValue(out, size) ;
+    writeValue(out, static_cast<uint32_t>(newEntries.size())) ;
+    for (auto entry : newEntries) {
+      writeValue(out, static_cast<uint32_t>(entry->size())) ;
+      out.write(entry->data(), static_cast<std::streamsize>(entry->size())) ;
+    }
+    newEntries.clear() ;
+  }
+
+  void ColumnarWriter::flushEvents()
+  {
+    if (ids.empty())
+      return ;
+
+    // Dictionary entries must precede the events referring to them
+    writeDictionary() ;
+
+    auto rows = static_cast<uint32_t>(ids.size()) ;
+    uint64_t size = sizeof(uint32_t) +
+      static_cast<uint64_t>(rows) * (2 * sizeof(uint64_t) + sizeof(double) + 3 * sizeof(uint32_t)) ;
+
+    writeValue(out, EVENTS_CHUNK) ;
+    writeValue(out, size) ;
+    writeValue(out, rows) ;
+    writeColumn(out, ids) ;
+    writeColumn(out, startIds) ;
+    writeColumn(out, timestamps) ;
+    writeColumn(out, buckets) ;
+    writeColumn(out, types) ;
+    writeColumn(out, suffixes) ;
+
+    ids.clear() ;
+    startIds.clear() ;
+    timestamps.clear() ;
+    buckets.clear() ;
+    types.clear() ;
+    suffixes.clear() ;
+  }
+
+  bool convertToCSV(std::istream& in, std::ostream& out)
+  {
+    char fileMagic[magicSize] = {} ;
+    if (!in.read(fileMagic, magicSize) || std::memcmp(fileMagic, magic, magicSize) != 0)
+      return false ;
+
+    std::vector<std::string> dictionary ;
+    std::vector<uint64_t> ids ;
+    std::vector<uint64_t> startIds ;
+    std::vector<double>   timestamps ;
+    std::vector<uint32_t> buckets ;
+    std::vector<uint32_t> types ;
+    std::vector<uint32_t> suffixes ;
+    std::vector<char> text ;
+    std::string rowText ;
+
+    uint32_t kind = 0 ;
+    while (readValue(in, kind)) {
+      uint64_t size = 0 ;
+      if (!readValue(in, size))
+        return false ;
+
+      if (kind == TEXT_CHUNK) {
+        text.resize(size) ;
+        if (!in.read(text.data(), static_cast<std::streamsize>(size)))
+          return false ;
+        out.write(text.data(), static_cast<std::streamsize>(size)) ;
+      }
+      else if (kind == DICTIONARY_CHUNK) {
+        uint32_t count = 0 ;
+        if (!readValue(in, count))
+          return false ;
+        for (uint32_t i = 0 ; i < count ; ++i) {
+          uint32_t length = 0 ;
+          if (!readValue(in, length))
+            return false ;
+          std::string entry(length, '\0') ;
+          if (!in.read(entry.data(), length))
+            return false ;
+          dictionary.push_back(std::move(entry)) ;
+        }
+      }
+      else if (kind == EVENTS_CHUNK) {
+        uint32_t rows = 0 ;
+        if (!readValue(in, rows)
+            || !readColumn(in, ids, rows) || !readColumn(in, startIds, rows)
+            || !readColumn(in, timestamps, rows) || !readColumn(in, buckets, rows)
+            || !readColumn(in, types, rows) || !readColumn(in, suffixes, rows))
+          return false ;
+
+        // Format rows with snprintf rather than iostream manipulators,
+        //  matching the fixed 6 digit timestamps of the CSV writer
+        constexpr size_t fieldsSize = 512 ;
+        char fields[fieldsSize] ;
+        for (uint32_t i = 0 ; i < rows ; ++i) {
+          if (types[i] >= dictionary.size() || suffixes[i] >= dictionary.size())
+            return false ;
+
+          int len = std::snprintf(fields, fieldsSize, "%" PRIu64 ",%" PRIu64 ",%.6f,%" PRIu32 ",",
+                                  ids[i], startIds[i], timestamps[i], buckets[i]) ;
+          rowText.assign(fields, static_cast<size_t>(len)) ;
+          rowText += dictionary[types[i]] ;
+          rowText += dictionary[suffixes[i]] ;
+          rowText += '\n' ;
+          out.write(rowText.data(), static_cast<std::streamsize>(rowText.size())) ;
+        }
+      }
+      else {
+        // Unknown chunk, skip it
+        in.seekg(static_cast<std::streamoff>(size), std::ios_base::cur) ;
+      }
+    }
+    return in.eof() ;
+  }
+
+} // end namespace xdp::columnar
@@ -0,0 +1,111 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef COLUMNAR_WRITER_DOT_H
+#define COLUMNAR_WRITER_DOT_H
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "xdp/config.h"
+
+// A columnar binary alternative to the CSV trace files.
+//
+// The file starts with an 8 byte magic followed by a sequence of chunks.
+// Every chunk starts with a 4 byte kind and an 8 byte payload size so a
+// reader can skip chunks it does not understand.
+//
+//  TEXT       : CSV text (header, structure, string table, ...) that is
+//               copied verbatim when converting to CSV
+//  DICTIONARY : strings appended to the file wide dictionary,
+//               a 4 byte count followed by (4 byte length, bytes) pairs
+//  EVENTS     : a 4 byte row count followed by one column per field,
+//               each column holds the values of all rows back to back
+//                 id        uint64
+//                 start_id  uint64
+//                 timestamp double
+//                 bucket    uint32
+//                 type      uint32 (dictionary index)
+//                 suffix    uint32 (dictionary index)
+//
+// An event converts to the CSV row "id,start_id,timestamp,bucket,type"
+// followed by its suffix, which holds the event type specific fields
+// (including their leading comma).  Event types and suffixes only take a
+// handful of distinct values so they are dictionary encoded.  All values
+// are written in host byte order.
+namespace xdp::columnar {
+
+  constexpr char magic[] = "XDPCOL01" ;
+  constexpr size_t magicSize = sizeof(magic) - 1 ;
+
+  enum ChunkKind : uint32_t {
+    TEXT_CHUNK       = 1,
+    DICTIONARY_CHUNK = 2,
+    EVENTS_CHUNK     = 3
+  } ;
+
+  class ColumnarWriter
+  {
+  private:
+    std::ostream& out ;
+
+    // Position of the size field of the open text chunk
+    std::streampos textSizePos = -1 ;
+
+    std::map<std::string, uint32_t> dictionary ;
+    std::vector<const std::string*> newEntries ;
+
+    std::vector<uint64_t> ids ;
+    std::vector<uint64_t> startIds ;
+    std::vector<double>   timestamps ;
+    std::vector<uint32_t> buckets ;
+    std::vector<uint32_t> types ;
+    std::vector<uint32_t> suffixes ;
+
+    uint32_t lookup(const std::string& str) ;
+    void writeDictionary() ;
+
+  public:
+    // Number of events buffered before a chunk is written
+    static constexpr size_t rowsPerChunk = 65536 ;
+
+    XDP_CORE_EXPORT explicit ColumnarWriter(std::ostream& o) ;
+
+    // Write the magic and reset the dictionary, called at the start of
+    //  every new file
+    XDP_CORE_EXPORT void start() ;
+
+    // All output to the stream in between is wrapped in a text chunk
+    XDP_CORE_EXPORT void beginText() ;
+    XDP_CORE_EXPORT void endText() ;
+
+    XDP_CORE_EXPORT void addEvent(uint64_t id, uint64_t startId, double timestamp,
+                                  uint32_t bucket, const std::string& type,
+                                  const std::string& suffix) ;
+    XDP_CORE_EXPORT void flushEvents() ;
+  } ;
+
+  // Convert a columnar file to the equivalent CSV.  Returns false if the
+  //  input is not a columnar file or is truncated.
+  XDP_CORE_EXPORT bool convertToCSV(std::istream& in, std::ostream& out) ;
+
+} // end namespace xdp::columnar
+
+#endif
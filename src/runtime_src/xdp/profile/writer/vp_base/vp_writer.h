@@ -62,12 +62,15 @@ namespace xdp {
 
     // The output stream (which could go to many different files)
     std::ofstream fout ;
+    std::ios_base::openmode openMode = std::ios_base::out ;
 
     VPWriter() = delete ;
 
     inline const char* getRawBasename() { return basename.c_str() ; } 
     XDP_CORE_EXPORT virtual void switchFiles() ;
     XDP_CORE_EXPORT virtual void refreshFile() ;
+    // Reopen the current and all subsequent files in binary mode
+    XDP_CORE_EXPORT void setBinaryMode() ;
   public:
     XDP_CORE_EXPORT VPWriter(const char* filename) ;
     XDP_CORE_EXPORT VPWriter(const char* filename, VPDatabase* inst,
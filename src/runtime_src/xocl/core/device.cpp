@@ -19,6 +19,7 @@
 #include "program.h"
 #include "compute_unit.h"
 #include "kernel.h"
+#include "staging.h"
 
 #include "xocl/api/plugin/xdp/debug.h"
 #include "xocl/xclbin/xclbin.h"
@@ -109,28 +110,60 @@ sync_to_ubuf(xocl::memory* buffer, size_t offset, size_t size,
       ubuf = static_cast<char*>(ubuf) + offset;
       hbuf = static_cast<char*>(hbuf) + offset;
       std::memcpy(ubuf,hbuf,size);
+      xocl::staging::count_from_device(size);
     }
   }
 }
 
-// Copy ubuf to hbuf if necessary
-static void
-sync_to_hbuf(xocl::memory* buffer, size_t offset, size_t size,
-             xrt_xocl::device* xdevice, const xocl::device::buffer_object_handle& boh)
+// Return user ptr if it differs from host buffer of buffer object
+static void*
+get_bounce_ptr(xocl::memory* buffer, xrt_xocl::device* xdevice,
+               const xocl::device::buffer_object_handle& boh, void** hbuf)
 {
   if (!buffer->need_extra_sync())
-    return;
+    return nullptr;
 
   auto ubuf = buffer->get_host_ptr();
-  if (ubuf) {
-    auto hbuf = xdevice->map(boh);
-    xdevice->unmap(boh);
-    if (ubuf!=hbuf) {
-      ubuf = static_cast<char*>(ubuf) + offset;
-      hbuf = static_cast<char*>(hbuf) + offset;
-      std::memcpy(hbuf,ubuf,size);
-    }
-  }
+  if (!ubuf)
+    return nullptr;
+
+  *hbuf = xdevice->map(boh);
+  xdevice->unmap(boh);
+  return (ubuf != *hbuf) ? ubuf : nullptr;
+}
+
+// Copy ubuf to hbuf if necessary and sync to device.  The copy is
+// overlapped with DMA of already copied data.
+static void
+sync_to_device(xocl::memory* buffer, size_t offset, size_t size,
+               xrt_xocl::device* xdevice, const xocl::device::buffer_object_handle& boh)
+{
+  auto dma = [xdevice, &boh](size_t sz, size_t off) {
+    xdevice->sync(boh,sz,off,xrt_xocl::hal::device::direction::HOST2DEVICE,false);
+  };
+
+  void* hbuf = nullptr;
+  if (auto ubuf = get_bounce_ptr(buffer,xdevice,boh,&hbuf))
+    xocl::staging::to_device(hbuf,ubuf,size,offset,dma);
+  else
+    dma(size,offset);
+}
+
+// Sync from device and copy hbuf to ubuf if necessary.  The copy is
+// overlapped with DMA of remaining data.
+static void
+sync_from_device(xocl::memory* buffer, size_t offset, size_t size,
+                 xrt_xocl::device* xdevice, const xocl::device::buffer_object_handle& boh)
+{
+  auto dma = [xdevice, &boh](size_t sz, size_t off) {
+    xdevice->sync(boh,sz,off,xrt_xocl::hal::device::direction::DEVICE2HOST,false);
+  };
+
+  void* hbuf = nullptr;
+  if (auto ubuf = get_bounce_ptr(buffer,xdevice,boh,&hbuf))
+    xocl::staging::from_device(ubuf,hbuf,size,offset,dma);
+  else
+    dma(size,offset);
 }
 
 static bool
@@ -256,17 +289,36 @@ alloc(memory* mem, memidx_type memidx)
 
   auto domain = get_mem_domain(mem);
 
-  auto boh = m_xdevice->alloc(sz,domain,memidx,nullptr);
+  // Unaligned user ptr or bad alloc host_ptr is backed by a pooled
+  // aligned staging buffer, data is bounced between the two
+  buffer_object_handle boh;
+  std::shared_ptr<void> staging;
+  if (host_ptr && domain == xrt_xocl::device::memoryDomain::XRT_DEVICE_RAM) {
+    try {
+      staging = xocl::staging::acquire(sz);
+      boh = m_xdevice->alloc(sz,domain,memidx,staging.get());
+    }
+    catch (const std::bad_alloc&) {
+      staging.reset();
+    }
+  }
+
+  if (!staging)
+    boh = m_xdevice->alloc(sz,domain,memidx,nullptr);
 
   // Handle unaligned user ptr or bad alloc host_ptr
   if (host_ptr) {
     if (!aligned_flag)
       unaligned_message(host_ptr);
     mem->set_extra_sync();
+    if (staging)
+      mem->add_staging_nolock(std::move(staging));
     auto bo_host_ptr = m_xdevice->map(boh);
     // No need to copy data to a CL_MEM_WRITE_ONLY buffer
-    if (!(mem->get_flags() & CL_MEM_WRITE_ONLY))
+    if (!(mem->get_flags() & CL_MEM_WRITE_ONLY)) {
         memcpy(bo_host_ptr, host_ptr, sz);
+        xocl::staging::count_to_device(sz);
+    }
 
     m_xdevice->unmap(boh);
   }
@@ -584,8 +636,7 @@ migrate_buffer(memory* buffer,cl_mem_migration_flags flags)
   if (flags & CL_MIGRATE_MEM_OBJECT_HOST) {
     buffer_resident_or_error(buffer,this);
     auto boh = buffer->get_buffer_object_or_error(this);
-    m_xdevice->sync(boh,buffer->get_size(),0,xrt_xocl::hal::device::direction::DEVICE2HOST,false);
-    sync_to_ubuf(buffer,0,buffer->get_size(),m_xdevice,boh);
+    sync_from_device(buffer,0,buffer->get_size(),m_xdevice,boh);
     return;
   }
 
@@ -594,8 +645,7 @@ migrate_buffer(memory* buffer,cl_mem_migration_flags flags)
   buffer_object_handle boh = buffer->get_buffer_object(this);
 
   // Sync from host to device to make make buffer resident of this device
-  sync_to_hbuf(buffer,0,buffer->get_size(),m_xdevice,boh);
-  m_xdevice->sync(boh,buffer->get_size(), 0, xrt_xocl::hal::device::direction::HOST2DEVICE,false);
+  sync_to_device(buffer,0,buffer->get_size(),m_xdevice,boh);
   // Now buffer is resident on this device and migrate is complete
   buffer->set_resident(this);
 }
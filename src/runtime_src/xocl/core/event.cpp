@@ -23,6 +23,7 @@
 
 #include "xocl/api/plugin/xdp/profile_v2.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 
@@ -89,6 +90,13 @@ event::
   XOCL_DEBUG(std::cout,"xocl::event::~event(",m_uid,")\n");
   for (auto& cb : sg_destructor_callbacks)
     cb(this);
+
+  auto node = reinterpret_cast<chain_node*>(m_chain.load() & ~chain_sealed);
+  while (node) {
+    auto next = node->next;
+    delete node;
+    node = next;
+  }
 }
 
 cl_int
@@ -118,7 +126,7 @@ set_status(cl_int s)
 
     XOCL_DEBUG(std::cout,"event(",m_uid,") [",to_string(m_status),"->",to_string(s),"]\n");
 
-    std::swap(m_status,s);
+    s = m_status.exchange(s);
     time_set(m_status);
   } // lk
 
@@ -141,8 +149,7 @@ set_status(cl_int s)
     // remove the completed event from queue (submitted queue)
     // before event_scheduler attempts to submit next event.
     queue_remove();   // 1 (order matters)
-    for (auto& c : m_chain) // not a race, since m_chain is blocked by CL_COMPLETE
-      c->submit();
+    release_chain();  // 2
   }
 
   return s;
@@ -184,14 +191,23 @@ queue(bool blocking_submit)
 bool
 event::
 submit()
+{
+  // Lock free until the last dependency is released
+  if (!release_dependency()) {
+    XOCL_DEBUG(std::cout,"event(",m_uid,") cannot submit wait_count(",m_wait_count,")\n");
+    return false;
+  }
+
+  submit_ready();
+  return true;
+}
+
+void
+event::
+submit_ready()
 {
   {
     std::lock_guard<std::mutex> lk(m_mutex);
-    if (--m_wait_count) {
-      XOCL_DEBUG(std::cout,"event(",m_uid,") cannot submit wait_count(",m_wait_count,")\n");
-      return false;
-    }
-
     XOCL_UNUSED auto submitted = queue_submit();
     assert(submitted);
 
@@ -207,8 +223,38 @@ submit()
 
   if (is_hard())
     trigger_enqueue_action();
+}
 
-  return true;
+void
+event::
+release_chain()
+{
+  // Seal the chain, chain() will no longer add to it
+  auto head = m_chain.fetch_or(chain_sealed,std::memory_order_acq_rel);
+  assert(!(head & chain_sealed));
+
+  // Release all chained events first, then submit the ones that
+  // became ready.  The chain is in reverse order of chain() calls,
+  // submit in chain() order.  Most events chain at most a few
+  // events, so avoid allocation unless necessary.
+  constexpr size_t inline_size = 8;
+  event* inline_ready[inline_size];
+  std::vector<event*> ready;
+  size_t count = 0;
+  for (auto node = reinterpret_cast<chain_node*>(head); node; node = node->next) {
+    if (!node->ev->release_dependency())
+      continue;
+    if (count < inline_size)
+      inline_ready[count] = node->ev.get();
+    else
+      ready.push_back(node->ev.get());
+    ++count;
+  }
+
+  for (auto itr = ready.rbegin(); itr != ready.rend(); ++itr)
+    (*itr)->submit_ready();
+  for (auto idx = std::min(count,inline_size); idx; --idx)
+    inline_ready[idx-1]->submit_ready();
 }
 
 bool
@@ -258,6 +304,9 @@ event::
 wait() const
 {
   XOCL_DEBUG(std::cout,"xocl::event::wait(",m_uid,")\n");
+  if (m_status<=0)  // lock free check if already complete or aborted
+    return;
+
   std::unique_lock<std::mutex> lk(m_mutex);
   while (m_status>0)  // (<0 => aborted) (==0 => CL_COMPLETE)
     m_event_complete.wait(lk);
@@ -332,25 +381,42 @@ chain(event* ev)
   // assert(ev is locked because it is being enqueued || called from "ev" event ctor);
   assert(ev->m_status == -1); // ev is being enq'ed or ctored
 
-  std::lock_guard<std::mutex> lk(m_mutex);
-  if (m_status == CL_COMPLETE)
-    return;
-  m_chain.push_back(ev);
+  // Count the dependency before ev is visible in the chain, since
+  // completion of this event releases ev as soon as it is chained.
+  // ev is not yet queued so its wait count cannot reach zero here.
   ++ev->m_wait_count;
+
+  auto node = new chain_node{ev,nullptr};
+  auto head = m_chain.load(std::memory_order_acquire);
+  do {
+    if (head & chain_sealed) {
+      // this event is complete, ev does not depend on it
+      delete node;
+      --ev->m_wait_count;
+      return;
+    }
+    node->next = reinterpret_cast<chain_node*>(head);
+  } while (!m_chain.compare_exchange_weak
+           (head,reinterpret_cast<uintptr_t>(node)
+            ,std::memory_order_acq_rel,std::memory_order_acquire));
 }
 
 bool
 event::
-chains_nolock(const event* ev) const
+chains(const event* ev) const
 {
-  return std::find(m_chain.begin(),m_chain.end(),ev)!=m_chain.end();
+  auto head = m_chain.load(std::memory_order_acquire) & ~chain_sealed;
+  for (auto node = reinterpret_cast<const chain_node*>(head); node; node = node->next)
+    if (node->ev.get()==ev)
+      return true;
+  return false;
 }
 
 bool
 event::
 waits_on(const event* ev) const
 {
-  return ev->chains_nolock(this);
+  return ev->chains(this);
 }
 
 bool
@@ -27,6 +27,8 @@
 
 #include "xrt/config.h"
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <functional>
 #include <iostream>
@@ -50,9 +52,6 @@ class event : public refcount, public _cl_event
   friend class command_queue;
 
 public:
-  using event_vector_type = std::vector<ptr<event>>;
-  using event_iterator_type = ptr_iterator<event_vector_type::iterator>;
-
   using event_callback_type = std::function<void(event*)>;
   using event_callback_list = std::vector<event_callback_type>;
 
@@ -202,17 +201,19 @@ public:
   }
 
   /**
-   * Returns a range_lock object of chained events, if the lock is acquired
-   * This is meant to be used only for application debug.
+   * Check if this event chains argument event
+   *
+   * The chain is traversed without locking the event.  Chained
+   * events are only ever prepended and remain in the chain until
+   * this event is destroyed.
+   *
+   * @param ev
+   *   Event to check for
+   * @return
+   *   true if argument event is submitted upon completion of this
    */
-  range_lock<event_iterator_type>
-  try_get_chain()
-  {
-    std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
-    if (!lk.try_lock())
-      throw xocl::error(DBG_EXCEPT_LOCK_FAILED, "Failed to secure lock on event");
-    return range_lock<event_iterator_type>(m_chain.begin(),m_chain.end(),std::move(lk));
-  }
+  bool
+  chains(const event* ev) const;
 
   // for the time being the status is changed all over the place
   // in the old rt code.   future should bring status entirely within
@@ -224,21 +225,17 @@ public:
   cl_int
   get_status() const
   {
-    std::lock_guard<std::mutex> lk(m_mutex);
-    return m_status;
+    return m_status.load(std::memory_order_acquire);
   }
 
   /*
-   * Try-locks to read m_status, returns -1 if cannot obtain lock
-   * This is currently called from the functions that are invoked  from the debugger.
+   * Read m_status from functions that are invoked from the debugger.
+   * Status is atomic so reading it never blocks on the event lock.
    */
   cl_int
   try_get_status() const
   {
-     std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
-     if (!lk.try_lock())
-       throw xocl::error(DBG_EXCEPT_LOCK_FAILED, "Failed to secure lock on event object");
-     return m_status;
+    return get_status();
   }
 
   /**
@@ -448,10 +445,35 @@ private:
   submit();
 
   /**
-   * Check if this event chains argument event
+   * Release one dependency of this event
+   *
+   * Lock free decrement of the wait count.
+   *
+   * @return
+   *   true if this was the last dependency, in which case the
+   *   caller must call submit_ready()
    */
   bool
-  chains_nolock(const event* ev) const;
+  release_dependency()
+  {
+    return m_wait_count.fetch_sub(1,std::memory_order_acq_rel)==1;
+  }
+
+  /**
+   * Submit this event after its last dependency was released
+   */
+  void
+  submit_ready();
+
+  /**
+   * Seal the chain and submit chained events that are ready
+   *
+   * Called once when this event completes.  The wait count of
+   * all chained events is released before any of the ready events
+   * are submitted.
+   */
+  void
+  release_chain();
 
   /**
    * Check if this event depends on argument event
@@ -544,7 +566,9 @@ private:
   // execution context, probably should create some derived class
   std::unique_ptr<execution_context> m_execution_context;
 
-  cl_int m_status = -1;
+  // Status is written with m_mutex held such that waiters on the
+  // condition variables are notified, but can be read without lock
+  std::atomic<cl_int> m_status {-1};
   cl_command_type m_command_type = 0;
   mutable std::mutex m_mutex;
   mutable std::condition_variable m_event_complete;
@@ -554,12 +578,21 @@ private:
   // allocation unless needed.
   std::unique_ptr<callback_list> m_callbacks;
 
-  // List of chained events (events to submit upon completion)
-  event_vector_type m_chain;
+  // List of chained events (events to submit upon completion).
+  // Lock free singly linked list, events are prepended by chain()
+  // and the list is sealed by tagging the head when this event
+  // completes.  Nodes are deleted with this event.
+  struct chain_node
+  {
+    ptr<event> ev;
+    chain_node* next;
+  };
+  static constexpr uintptr_t chain_sealed = 1;
+  std::atomic<uintptr_t> m_chain {0};
 
   // Number of events this event is waiting on.  This includes
   // explicit event depedencies and events that chain this
-  unsigned int m_wait_count = 0;
+  std::atomic<unsigned int> m_wait_count {0};
 };
 
 /**
@@ -19,6 +19,7 @@
 #include "event.h"
 #include "xrt/detail/ert.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/xclbin_parser.h"
 #include "core/common/api/kernel_int.h"
 #include "core/include/xrt/experimental/xrt_xclbin.h"
@@ -122,23 +123,29 @@ set_rtinfo_arg3(xrt::run& run, size_t arginfo_idx, const size3& value3)
 
 void
 execution_context::
-set_rtinfo_args(xrt::run& run)
+set_rtinfo_args(xrt::run& run, bool workgroup_only)
 {
   for (auto& arg : m_kernel->get_rtinfo_xargument_range()) {
     switch (arg->get_rtinfo_type()) {
     case xocl::kernel::rtinfo_type::dim:
-      set_rtinfo_arg1(run, arg->get_arginfo_idx(), m_dim);
+      if (!workgroup_only)
+        set_rtinfo_arg1(run, arg->get_arginfo_idx(), m_dim);
       break;
     case xocl::kernel::rtinfo_type::goff:
-      set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_goffset);
+      if (!workgroup_only)
+        set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_goffset);
       break;
     case xocl::kernel::rtinfo_type::gsize:
-      set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_gsize);
+      if (!workgroup_only)
+        set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_gsize);
       break;
     case xocl::kernel::rtinfo_type::lsize:
-      set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_lsize);
+      if (!workgroup_only)
+        set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_lsize);
       break;
     case xocl::kernel::rtinfo_type::ngrps: {
+      if (workgroup_only)
+        break;
       size3 num_workgroups {0,0,0};
       for (auto d : {0,1,2})
         if (m_lsize[d])
@@ -150,6 +157,8 @@ set_rtinfo_args(xrt::run& run)
       set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_cu_global_id);
       break;
     case xocl::kernel::rtinfo_type::lid: {
+      if (workgroup_only)
+        break;
       size3 local_id {0,0,0};
       set_rtinfo_arg3(run, arg->get_arginfo_idx(), local_id);
       break;
@@ -214,7 +223,49 @@ execution_context(device* device
   m_num_cus = xrt_core::kernel_int::get_num_cus(m_run);
   m_control = xrt_core::kernel_int::get_control_protocol(m_run);
 
-  m_freeruns.push_back(m_run);
+  m_batch = m_num_cus ? xrt_core::config::get_ocl_workgroup_batch() : 0;
+  if (m_batch)
+    init_batch();
+  else
+    m_freeruns.push_back(m_run);
+}
+
+void
+execution_context::
+init_batch()
+{
+  // Encode all arguments that are invariant across workgroups once,
+  // clones inherit the encoded command data, such that starting a
+  // workgroup only has to update the workgroup ids.
+  set_rtinfo_args(m_run);
+
+  auto cumask = xrt_core::kernel_int::get_cumask(m_run);
+  std::vector<size_t> cus;
+  for (size_t cu = 0; cu < cumask.size(); ++cu)
+    if (cumask.test(cu))
+      cus.push_back(cu);
+
+  auto pool_size = std::min(m_num_cus * m_batch, get_num_work_groups());
+  std::vector<xrt::run> runs;
+  runs.reserve(pool_size);
+  runs.push_back(m_run);
+  for (size_t i = 1; i < pool_size; ++i) {
+    auto run = xrt_core::kernel_int::clone(m_run);
+    run.add_callback(ERT_CMD_STATE_COMPLETED, run_done, this);
+    runs.push_back(std::move(run));
+  }
+
+  // Pin runs round robin to compute units.  A completed run is
+  // reused for the next workgroup, so each compute unit has at most
+  // m_batch workgroups in flight.
+  for (size_t i = 0; i < runs.size(); ++i) {
+    std::bitset<128> mask;
+    mask.set(cus[i % cus.size()]);
+    xrt_core::kernel_int::set_cus(runs[i], mask);
+  }
+
+  // Reverse such that first workgroups go to different compute units
+  m_freeruns.assign(runs.rbegin(), runs.rend());
 }
 
 execution_context::
@@ -285,7 +336,7 @@ start()
   
   // Set OCL specific runtime control parameters which are based
   // current workgroups, etc
-  set_rtinfo_args(run);
+  set_rtinfo_args(run, m_batch > 0);
 
   // After setting rtinfo the work group data can be updated
   // This must be done before chance of calling run_done()
@@ -371,7 +422,12 @@ execute()
   // In order to keep scheduler busy, we need more than just one
   // workgroup at a time, so here we try to ensure that the scheduled
   // commands at any given time is twice the number of available CUs.
-  auto limit = (m_control == xrt::xclbin::ip::control_type::chain) ? 20 * m_num_cus : 2 * m_num_cus;
+  //
+  // In batched mode the limit is the size of the pre-encoded pool
+  // of run objects.
+  auto limit = m_batch
+    ? m_batch * m_num_cus
+    : (m_control == xrt::xclbin::ip::control_type::chain) ? 20 * m_num_cus : 2 * m_num_cus;
   for (size_t i = m_active; !m_done && i < limit; ++i) {
     start();
     XRT_DEBUGF("active=%d\n",m_active);
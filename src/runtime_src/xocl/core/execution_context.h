@@ -86,6 +86,11 @@ private:
   // Number of compute units in the run object
   size_t m_num_cus = 0;
 
+  // Number of workgroups in flight per compute unit when run objects
+  // are pre-encoded and pinned to compute units (Runtime.ocl_workgroup_batch).
+  // 0 when workgroups are dispatched with on demand run objects.
+  size_t m_batch = 0;
+
   // Control protocol
   xrt::xclbin::ip::control_type m_control = xrt::xclbin::ip::control_type::hs;
 
@@ -124,9 +129,15 @@ private:
   void
   set_rtinfo_arg3(xrt::run&, size_t index, const size3&);
 
-  // Set OpenCL specific runtime argument
+  // Set OpenCL specific runtime arguments.  If workgroup_only then
+  // only arguments that change between workgroups are set.
+  void
+  set_rtinfo_args(xrt::run&, bool workgroup_only = false);
+
+  // Create pool of run objects pinned to compute units and with
+  // all invariant arguments encoded up front
   void
-  set_rtinfo_args(xrt::run&);
+  init_batch();
 
   // Run object to use for starting work group
   xrt::run
@@ -442,6 +442,18 @@ public:
     m_resident.clear();
   }
 
+  /**
+   * Keep a staging buffer alive for the lifetime of this object
+   *
+   * Called by device while allocating a buffer object for this
+   * memory, where the buffer object lock is already held.
+   */
+  void
+  add_staging_nolock(std::shared_ptr<void> staging)
+  {
+    m_staging.push_back(std::move(staging));
+  }
+
   /**
    * Add a dtor callback
    */
@@ -497,6 +509,10 @@ private:
   // allocation unless needed.
   std::unique_ptr<std::vector<std::function<void()>>> m_dtor_notify;
 
+  // Staging buffers backing device buffer objects of unaligned host
+  // ptr, must outlive the buffer objects
+  std::vector<std::shared_ptr<void>> m_staging;
+
   mutable std::mutex m_boh_mutex;
   bomap_type m_bomap;
   std::vector<const device*> m_resident;
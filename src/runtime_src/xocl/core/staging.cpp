@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include "staging.h"
+
+#include "xrt/util/config_reader.h"
+#include "core/common/memalign.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace {
+
+// Staging buffers are page aligned and sized in powers of two
+// starting at 64KB, such that a released buffer can be reused for
+// any request in the same size class.
+constexpr size_t alignment = 4096;
+constexpr size_t min_size = 64 * 1024;
+
+static size_t
+size_class(size_t size)
+{
+  size_t sz = min_size;
+  while (sz < size)
+    sz <<= 1;
+  return sz;
+}
+
+// class pool - Free staging buffers by size class
+class pool
+{
+  std::mutex m_mutex;
+  std::map<size_t, std::vector<void*>> m_free;
+  size_t m_cached = 0;
+  size_t m_max_cached;
+
+public:
+  xocl::staging::stats m_stats;
+
+  pool()
+    : m_max_cached(static_cast<size_t>(xrt_xocl::config::get_ocl_staging_pool_mb()) * 1024 * 1024)
+  {}
+
+  void
+  report() const
+  {
+    std::cerr << "XRT OpenCL staging: buffers=" << m_stats.buffers
+              << " pool_hits=" << m_stats.pool_hits
+              << " bytes_to_device=" << m_stats.bytes_to_device
+              << " bytes_from_device=" << m_stats.bytes_from_device << "\n";
+  }
+
+  void*
+  get(size_t sz)
+  {
+    ++m_stats.buffers;
+    {
+      std::lock_guard lk(m_mutex);
+      auto itr = m_free.find(sz);
+      if (itr != m_free.end() && !itr->second.empty()) {
+        auto buf = itr->second.back();
+        itr->second.pop_back();
+        m_cached -= sz;
+        ++m_stats.pool_hits;
+        return buf;
+      }
+    }
+
+    void* buf = nullptr;
+    if (xrt_core::posix_memalign(&buf, alignment, sz))
+      throw std::bad_alloc();
+    return buf;
+  }
+
+  void
+  put(void* buf, size_t sz)
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      if (m_cached + sz <= m_max_cached) {
+        m_free[sz].push_back(buf);
+        m_cached += sz;
+        return;
+      }
+    }
+    free(buf);
+  }
+};
+
+// The pool is never destroyed, staging buffers may be released by
+// OpenCL objects destroyed during static destruction
+static pool&
+get_pool()
+{
+  static auto p = new pool;
+  static struct reporter
+  {
+    ~reporter()
+    {
+      if (xrt_xocl::config::get_ocl_staging_stats())
+        p->report();
+    }
+  } r;
+  return *p;
+}
+
+static size_t
+chunk_size()
+{
+  static size_t value = std::max<size_t>(xrt_xocl::config::get_ocl_staging_chunk_kb(), 4) * 1024;
+  return value;
+}
+
+} // namespace
+
+namespace xocl { namespace staging {
+
+stats&
+get_stats()
+{
+  return get_pool().m_stats;
+}
+
+std::shared_ptr<void>
+acquire(size_t size)
+{
+  auto sz = size_class(size);
+  auto& p = get_pool();
+  auto buf = p.get(sz);
+  return {buf, [sz, &p](void* b) { p.put(b, sz); }};
+}
+
+void
+to_device(void* hbuf, const void* ubuf, size_t size, size_t offset, const dma_function& dma)
+{
+  auto dst = static_cast<char*>(hbuf) + offset;
+  auto src = static_cast<const char*>(ubuf) + offset;
+  auto chunk = chunk_size();
+  count_to_device(size);
+
+  if (size <= chunk) {
+    std::memcpy(dst, src, size);
+    dma(size, offset);
+    return;
+  }
+
+  // Copy chunk while DMA of previous chunk is in flight
+  std::future<void> inflight;
+  for (size_t off = 0; off < size; off += chunk) {
+    auto sz = std::min(chunk, size - off);
+    std::memcpy(dst + off, src + off, sz);
+    if (inflight.valid())
+      inflight.get();
+    inflight = std::async(std::launch::async, dma, sz, offset + off);
+  }
+  inflight.get();
+}
+
+void
+from_device(void* ubuf, const void* hbuf, size_t size, size_t offset, const dma_function& dma)
+{
+  auto dst = static_cast<char*>(ubuf) + offset;
+  auto src = static_cast<const char*>(hbuf) + offset;
+  auto chunk = chunk_size();
+  count_from_device(size);
+
+  if (size <= chunk) {
+    dma(size, offset);
+    std::memcpy(dst, src, size);
+    return;
+  }
+
+  // DMA next chunk while copying current chunk
+  auto inflight = std::async(std::launch::async, dma, std::min(chunk, size), offset);
+  for (size_t off = 0; off < size; off += chunk) {
+    auto sz = std::min(chunk, size - off);
+    inflight.get();
+    if (auto next = off + chunk; next < size)
+      inflight = std::async(std::launch::async, dma, std::min(chunk, size - next), offset + next);
+    std::memcpy(dst + off, src + off, sz);
+  }
+}
+
+}} // staging, xocl
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef xocl_core_staging_h_
+#define xocl_core_staging_h_
+
+#include "xocl/config.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace xocl { namespace staging {
+
+/**
+ * struct stats - Bytes bounced through staging buffers
+ *
+ * @bytes_to_device: bytes copied from unaligned user pointers to
+ *   staging buffers before DMA to device
+ * @bytes_from_device: bytes copied from staging buffers to unaligned
+ *   user pointers after DMA from device
+ * @buffers: staging buffers handed out for unaligned user pointers
+ * @pool_hits: staging buffers reused from the pool
+ */
+struct stats
+{
+  std::atomic<uint64_t> bytes_to_device {0};
+  std::atomic<uint64_t> bytes_from_device {0};
+  std::atomic<uint64_t> buffers {0};
+  std::atomic<uint64_t> pool_hits {0};
+};
+
+/**
+ * get_stats() - Process wide staging statistics
+ */
+stats&
+get_stats();
+
+/**
+ * acquire() - Get an aligned staging buffer of at least size bytes
+ *
+ * @size: Minimum size of buffer
+ * Return: Aligned host buffer, returned to the pool on release
+ *
+ * Buffers are pooled by size class.  Released buffers are kept for
+ * reuse as long as the pool does not exceed the size configured by
+ * Runtime.ocl_staging_pool_mb.
+ */
+std::shared_ptr<void>
+acquire(size_t size);
+
+/**
+ * dma_function - Transfer of a range between buffer host memory and device
+ */
+using dma_function = std::function<void(size_t size, size_t offset)>;
+
+/**
+ * to_device() - Copy user data to host buffer and DMA to device
+ *
+ * @hbuf: Host buffer of buffer object
+ * @ubuf: Unaligned user data
+ * @size: Number of bytes to transfer
+ * @offset: Offset in @hbuf, @ubuf, and device buffer
+ * @dma: DMA of a range of host buffer to device
+ *
+ * The range is transferred in chunks such that copy of a chunk
+ * overlaps with DMA of the previous chunk.
+ */
+void
+to_device(void* hbuf, const void* ubuf, size_t size, size_t offset, const dma_function& dma);
+
+/**
+ * from_device() - DMA from device to host buffer and copy to user data
+ *
+ * @ubuf: Unaligned user data
+ * @hbuf: Host buffer of buffer object
+ * @size: Number of bytes to transfer
+ * @offset: Offset in @hbuf, @ubuf, and device buffer
+ * @dma: DMA of a range of device buffer to host buffer
+ *
+ * The range is transferred in chunks such that copy of a chunk
+ * overlaps with DMA of the next chunk.
+ */
+void
+from_device(void* ubuf, const void* hbuf, size_t size, size_t offset, const dma_function& dma);
+
+/**
+ * count_to_device() - Account for bytes copied without DMA
+ */
+inline void
+count_to_device(size_t bytes)
+{
+  get_stats().bytes_to_device += bytes;
+}
+
+/**
+ * count_from_device() - Account for bytes copied without DMA
+ */
+inline void
+count_from_device(size_t bytes)
+{
+  get_stats().bytes_from_device += bytes;
+}
+
+}} // staging, xocl
+
+#endif
@@ -24,6 +24,7 @@
 
 #include <thread>
 #include <iostream>
+#include <vector>
 
 namespace {
 
@@ -183,6 +184,78 @@ BOOST_AUTO_TEST_CASE( test_event_submit_wait )
   }
 }
 
+// Scaled up submit scenario used to measure event bookkeeping.
+// Each thread owns a queue and repeatedly queues a batch of events
+// that all depend on a soft event.  Completing the soft event
+// releases the entire batch.  With an in order queue each event is
+// also chained to the previously queued event.  Boost.Test checks
+// are not thread safe, so event status mismatches are counted in
+// failures and checked by the caller after the thread is joined.
+static void
+submit_batches(xocl::context* c, cl_command_queue_properties props,
+               unsigned int batches, unsigned int batch_size, unsigned int* failures)
+{
+  xocl::command_queue q(c,nullptr,props);
+  for (unsigned int b=0; b<batches; ++b) {
+    auto gate = xocl::create_soft_event(c,CL_COMMAND_USER);
+    cl_event dep = gate.get();
+
+    std::vector<xocl::ptr<xocl::event>> events;
+    events.reserve(batch_size);
+    for (unsigned int i=0; i<batch_size; ++i) {
+      events.push_back(xocl::create_hard_event(&q,CL_COMMAND_MARKER,1,&dep));
+      events.back()->queue();
+      if (events.back()->get_status() != CL_QUEUED)
+        ++(*failures);
+    }
+
+    gate->queue();
+    gate->set_status(CL_COMPLETE);
+    q.wait();
+
+    for (auto& ev : events)
+      if (ev->get_status() != CL_COMPLETE)
+        ++(*failures);
+  }
+}
+
+static void
+submit_batches_threaded(cl_command_queue_properties props, unsigned int threads)
+{
+  const unsigned int batches = 200;
+  const unsigned int batch_size = 64;
+
+  xocl::context c(nullptr,0,nullptr);
+  auto start = xrt_xocl::time_ns();
+  std::vector<unsigned int> failures(threads,0);
+  std::vector<std::thread> workers;
+  for (unsigned int t=0; t<threads; ++t)
+    workers.push_back(std::thread(submit_batches,&c,props,batches,batch_size,&failures[t]));
+  for (auto& t : workers)
+    t.join();
+  auto ns = xrt_xocl::time_ns() - start;
+
+  for (unsigned int t=0; t<threads; ++t)
+    BOOST_CHECK_EQUAL(failures[t],0);
+
+  auto events = threads * batches * batch_size;
+  BOOST_TEST_MESSAGE((props ? "out of order" : "in order")
+                     << " threads=" << threads << " events=" << events
+                     << " ns/event=" << ns / events);
+}
+
+BOOST_AUTO_TEST_CASE( test_event_scaled_in_order_submit )
+{
+  for (auto threads : {1,4,16})
+    submit_batches_threaded(0,threads);
+}
+
+BOOST_AUTO_TEST_CASE( test_event_scaled_out_order_submit )
+{
+  for (auto threads : {1,4,16})
+    submit_batches_threaded(CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE,threads);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
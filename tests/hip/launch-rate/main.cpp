@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Launch rate of the HIP stream submission path.
+//
+// Each submitting thread owns a non-blocking stream.  Each in flight
+// launch is a hipModuleLaunchKernel of the nop kernel followed by a
+// hipEventRecord on the stream, waited on with hipEventSynchronize.
+// Output is the same JSON records as produced by the XRT and OpenCL
+// launch rate benchmarks in tests/xrt/perf_IOPS, see launch_rate.h.
+//
+//   % ./launch-rate nop.co > hip.json
+
+#include <array>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hip/hip_runtime_api.h"
+
+#include "common.h"
+#include "launch_rate.h"
+
+namespace {
+
+static constexpr char const *nop_kernel_filename = "nop.co";
+static constexpr char const *nop_kernel_name = "mynop";
+
+using xrt_hip_test_common::test_hip_check;
+
+void
+usage()
+{
+  std::cout << "usage: launch-rate [options]\n\n";
+  std::cout << "  [-k <kernel file>]: code object with nop kernel (default: nop.co)\n";
+  launch_rate::options::usage();
+}
+
+struct hip_stream
+{
+  hipStream_t stream = nullptr;
+
+  hip_stream()
+  {
+    test_hip_check(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+  }
+
+  ~hip_stream()
+  {
+    (void)hipStreamDestroy(stream);
+  }
+
+  hip_stream(const hip_stream&) = delete;
+  hip_stream& operator=(const hip_stream&) = delete;
+};
+
+struct hip_event
+{
+  hipEvent_t event = nullptr;
+
+  hip_event()
+  {
+    test_hip_check(hipEventCreate(&event));
+  }
+
+  ~hip_event()
+  {
+    (void)hipEventDestroy(event);
+  }
+
+  hip_event(const hip_event&) = delete;
+  hip_event& operator=(const hip_event&) = delete;
+};
+
+struct hip_slot
+{
+  hipFunction_t function;
+  std::shared_ptr<hip_stream> stream;
+  std::shared_ptr<hip_event> event;
+  std::array<void*, 3>* args;
+
+  void
+  start()
+  {
+    test_hip_check(hipModuleLaunchKernel(function, 1, 1, 1, 1, 1, 1, 0, stream->stream, args->data(), nullptr),
+                   nop_kernel_name);
+    test_hip_check(hipEventRecord(event->event, stream->stream));
+  }
+
+  void
+  wait()
+  {
+    test_hip_check(hipEventSynchronize(event->event));
+  }
+
+  size_t count() const { return 1; }
+};
+
+int
+mainworker(int argc, char** argv)
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+
+  std::string kernel_fnm = nop_kernel_filename;
+  launch_rate::options opts;
+
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      kernel_fnm = arg;
+    else if (!opts.parse(cur, arg))
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  xrt_hip_test_common::hip_test_device hdevice;
+  hipFunction_t function = hdevice.get_function(kernel_fnm.c_str(), nop_kernel_name);
+
+  // The nop kernel ignores its arguments, all launches share buffers
+  xrt_hip_test_common::hip_test_device_bo<float> device_a(1);
+  xrt_hip_test_common::hip_test_device_bo<float> device_b(1);
+  xrt_hip_test_common::hip_test_device_bo<float> device_c(1);
+  std::array<void*, 3> kargs = {&device_a.get(), &device_b.get(), &device_c.get()};
+
+  launch_rate::sweep<hip_slot>("hip::stream", opts, [&](size_t, size_t depth) {
+    auto stream = std::make_shared<hip_stream>();
+    std::vector<hip_slot> slots;
+    for (size_t i = 0; i < depth; ++i)
+      slots.push_back({function, stream, std::make_shared<hip_event>(), &kargs});
+    return slots;
+  });
+
+  return 0;
+}
+
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    return mainworker(argc, argv);
+  } catch (std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,148 @@
+#!/usr/bin/python3
+
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Measure throughput of pipelines that overlap Python side work with
+# device work.  Each job preprocesses its input in Python, writes and
+# syncs it to the device, runs the 'simple' kernel of 02_simple and
+# syncs the result back.  Jobs are run by a growing number of Python
+# threads and by asyncio tasks.  Since pyxrt releases the GIL in
+# blocking calls, throughput should scale beyond a single thread.
+#
+# python3 24_async_throughput.py -k kernel.xclbin
+#
+
+import asyncio
+import ctypes
+import sys
+import threading
+import time
+
+import numpy
+
+# Following found in PYTHONPATH setup by XRT
+import pyxrt
+
+sys.path.append('../')
+from utils_binding import *
+
+COUNT = 1024
+DATA_SIZE = ctypes.sizeof(ctypes.c_int32) * COUNT
+JOBS = 256
+TO_DEVICE = pyxrt.xclBOSyncDirection.XCL_BO_SYNC_BO_TO_DEVICE
+FROM_DEVICE = pyxrt.xclBOSyncDirection.XCL_BO_SYNC_BO_FROM_DEVICE
+
+class Slot:
+    def __init__(self, d, kernel):
+        self.out = pyxrt.bo(d, DATA_SIZE, pyxrt.bo.normal, kernel.group_id(0))
+        self.inp = pyxrt.bo(d, DATA_SIZE, pyxrt.bo.normal, kernel.group_id(1))
+        self.run = pyxrt.run(kernel)
+        self.run.set_arg(0, self.out)
+        self.run.set_arg(1, self.inp)
+        foo = 0x10
+        self.run.set_arg(2, foo)
+
+def preprocess(seed):
+    # Python side work standing in for real input preparation
+    data = numpy.arange(COUNT, dtype=numpy.int32)
+    for i in range(16):
+        data = (data * 3 + seed) // 3 - seed // 3
+    return numpy.ascontiguousarray(data)
+
+def run_job(slot, seed):
+    data = preprocess(seed)
+    slot.inp.write(data, 0)
+    slot.inp.sync(TO_DEVICE, DATA_SIZE, 0)
+    slot.run.start()
+    slot.run.wait()
+    slot.out.sync(FROM_DEVICE, DATA_SIZE, 0)
+    return slot.out.read(DATA_SIZE, 0)
+
+def threaded(slots, nthreads):
+    def worker(tid):
+        for job in range(tid, JOBS, nthreads):
+            run_job(slots[tid], job)
+
+    threads = [threading.Thread(target=worker, args=(tid,)) for tid in range(nthreads)]
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return JOBS / (time.perf_counter() - start)
+
+async def async_job(slot, seed):
+    data = preprocess(seed)
+    slot.inp.write(data, 0)
+    await slot.inp.async_(TO_DEVICE, DATA_SIZE, 0)
+    slot.run.start()
+    await slot.run
+    await slot.out.async_(FROM_DEVICE, DATA_SIZE, 0)
+    return slot.out.read(DATA_SIZE, 0)
+
+async def async_worker(slot, tid, ntasks):
+    for job in range(tid, JOBS, ntasks):
+        await async_job(slot, job)
+
+async def async_tasks(slots, ntasks):
+    start = time.perf_counter()
+    await asyncio.gather(*[async_worker(slots[tid], tid, ntasks) for tid in range(ntasks)])
+    return JOBS / (time.perf_counter() - start)
+
+def runKernel(opt):
+    d = pyxrt.device(opt.index)
+    xbin = pyxrt.xclbin(opt.bitstreamFile)
+    uuid = d.load_xclbin(xbin)
+    simple = pyxrt.kernel(d, uuid, "simple", pyxrt.kernel.shared)
+
+    maxthreads = 8
+    slots = [Slot(d, simple) for i in range(maxthreads)]
+
+    # Check one job before measuring
+    ref = preprocess(0) + numpy.arange(COUNT, dtype=numpy.int32) * 0x10
+    out = numpy.frombuffer(run_job(slots[0], 0), dtype=numpy.int32)
+    assert numpy.array_equal(out, ref), "Computed value does not match reference"
+
+    base = threaded(slots, 1)
+    print("threads=1 jobs/s=%.1f" % base)
+    nthreads = 2
+    while nthreads <= maxthreads:
+        rate = threaded(slots, nthreads)
+        print("threads=%d jobs/s=%.1f speedup=%.2f" % (nthreads, rate, rate / base))
+        nthreads *= 2
+
+    ntasks = 1
+    while ntasks <= maxthreads:
+        rate = asyncio.run(async_tasks(slots, ntasks))
+        print("asyncio tasks=%d jobs/s=%.1f speedup=%.2f" % (ntasks, rate, rate / base))
+        ntasks *= 2
+
+def main(args):
+    opt = Options()
+    Options.getOptions(opt, args)
+
+    try:
+        runKernel(opt)
+        print("PASSED TEST")
+        return 0
+
+    except OSError as o:
+        print(o)
+        print("FAILED TEST")
+        return -o.errno
+
+    except AssertionError as a:
+        print(a)
+        print("FAILED TEST")
+        return -1
+    except Exception as e:
+        print(e)
+        print("FAILED TEST")
+        return -1
+
+if __name__ == "__main__":
+    result = main(sys.argv)
+    sys.exit(result)
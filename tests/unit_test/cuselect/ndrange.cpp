@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Measure OpenCL NDRange workgroup dispatch rate.
+//
+// Enqueues the vadd kernel with many single work-item workgroups
+// such that execution is dominated by host side workgroup dispatch.
+// Each vadd CU has a different buffer connectivity (see main.cpp), so
+// one kernel object per CU is created with its arguments in the banks
+// of that CU.  Each iteration enqueues an NDRange of every kernel on
+// an out of order queue such that all CUs execute concurrently.
+//
+// Run with and without batched workgroup dispatch to compare:
+//   % cat xrt.ini
+//   [Runtime]
+//   ocl_workgroup_batch=4
+#include <CL/cl_ext_xilinx.h>
+#include <CL/cl.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using data_type = int;
+const size_t data_size = 16;
+const size_t buffer_size = data_size*sizeof(data_type);
+
+static void
+throw_if_error(cl_int errcode, const char* msg=nullptr)
+{
+  if (!errcode)
+    return;
+  std::string err = "errcode '";
+  err.append(std::to_string(errcode)).append("'");
+  if (msg)
+    err.append(" ").append(msg);
+  throw std::runtime_error(err);
+}
+
+static void
+usage()
+{
+  std::cout << "usage: ndrange.exe <xclbin> [workgroups per cu (default: 1024)] [iterations (default: 10)]\n";
+}
+
+// Bank of each vadd argument per CU, vadd_1 through vadd_4
+static const std::array<std::array<unsigned int,4>,4> cu_banks = {{
+  {0,1,2,3},
+  {1,2,3,0},
+  {2,3,0,1},
+  {3,0,1,2}
+}};
+
+static int
+run_test(cl_context context, cl_command_queue queue, cl_program program, size_t workgroups, size_t iterations)
+{
+  cl_int err = CL_SUCCESS;
+  std::array<data_type,data_size> dataA;
+  std::array<data_type,data_size> dataB;
+  std::array<data_type,data_size> dataC;
+  std::array<data_type,data_size> dataO;
+  std::iota(dataA.begin(),dataA.end(),0);
+  std::iota(dataB.begin(),dataB.end(),1);
+  std::iota(dataC.begin(),dataC.end(),2);
+  std::fill(dataO.begin(),dataO.end(),0);
+  std::array<void*,4> host_data = {dataA.data(),dataB.data(),dataC.data(),dataO.data()};
+
+  // One kernel per CU with buffers in the banks of that CU, the
+  // kernel object is compatible with exactly that CU
+  std::array<cl_kernel,cu_banks.size()> kernels;
+  std::array<std::array<cl_mem,4>,cu_banks.size()> args;
+  for (size_t cu=0; cu<cu_banks.size(); ++cu) {
+    kernels[cu] = clCreateKernel(program,"vadd",&err);
+    throw_if_error(err,"failed to allocate kernel object");
+    for (size_t arg=0; arg<args[cu].size(); ++arg) {
+      unsigned int bank = (XCL_MEM_DDR_BANK0 << cu_banks[cu][arg]);
+      cl_mem_ext_ptr_t ext = {bank,host_data[arg],nullptr};
+      args[cu][arg] = clCreateBuffer(context,CL_MEM_READ_WRITE|CL_MEM_EXT_PTR_XILINX|CL_MEM_COPY_HOST_PTR,buffer_size,&ext,&err);
+      throw_if_error(err,"failed to allocate buffer");
+      throw_if_error(clSetKernelArg(kernels[cu],arg,sizeof(cl_mem),&args[cu][arg]),"failed to set kernel arg");
+    }
+    throw_if_error(clEnqueueMigrateMemObjects(queue,args[cu].size(),args[cu].data(),0,0,nullptr,nullptr));
+  }
+  throw_if_error(clFinish(queue));
+
+  size_t global[1] = {workgroups};
+  size_t local[1] = {1};
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i=0; i<iterations; ++i)
+    for (auto kernel : kernels)
+      throw_if_error(clEnqueueNDRangeKernel(queue,kernel,1,nullptr,global,local,0,nullptr,nullptr),"failed to enqueue kernel");
+  throw_if_error(clFinish(queue));
+  auto end = std::chrono::steady_clock::now();
+
+  for (auto& cu_args : args) {
+    std::array<data_type,data_size> result;
+    throw_if_error(clEnqueueReadBuffer(queue,cu_args[3],CL_TRUE,0,buffer_size,result.data(),0,nullptr,nullptr),"failed to read results");
+    for (size_t idx=0; idx<data_size; ++idx) {
+      auto add = dataA[idx] + dataB[idx] + dataC[idx];
+      if (result[idx] != add) {
+        std::cout << "got result[" << idx << "] = " << result[idx] << " expected " << add << "\n";
+        throw std::runtime_error("VERIFY FAILED");
+      }
+    }
+  }
+
+  auto us = std::chrono::duration<double, std::micro>(end - start).count();
+  auto total = workgroups * iterations * kernels.size();
+  std::cout << "ndrange: cus workgroups iterations us_per_workgroup workgroups_per_sec = "
+            << kernels.size() << " " << workgroups << " " << iterations << " "
+            << us / total << " " << (total * 1000000.0) / us << "\n";
+
+  for (auto& cu_args : args)
+    std::for_each(cu_args.begin(),cu_args.end(),[](cl_mem m) { clReleaseMemObject(m); });
+  std::for_each(kernels.begin(),kernels.end(),[](cl_kernel k) { clReleaseKernel(k); });
+  return 0;
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 2) {
+    usage();
+    throw std::runtime_error("missing xclbin");
+  }
+
+  size_t workgroups = (argc > 2) ? std::stoul(argv[2]) : 1024;
+  size_t iterations = (argc > 3) ? std::stoul(argv[3]) : 10;
+
+  cl_int err = CL_SUCCESS;
+  cl_platform_id platform = nullptr;
+  throw_if_error(clGetPlatformIDs(1,&platform,nullptr));
+
+  cl_uint num_devices = 0;
+  throw_if_error(clGetDeviceIDs(platform,CL_DEVICE_TYPE_ACCELERATOR,0,nullptr,&num_devices));
+  throw_if_error(num_devices==0,"no devices");
+  std::vector<cl_device_id> devices(num_devices);
+  throw_if_error(clGetDeviceIDs(platform,CL_DEVICE_TYPE_ACCELERATOR,num_devices,devices.data(),nullptr));
+  cl_device_id device = devices.front();
+
+  cl_context context = clCreateContext(0,1,&device,nullptr,nullptr,&err);
+  throw_if_error(err);
+
+  cl_command_queue queue = clCreateCommandQueue(context,device,CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE,&err);
+  throw_if_error(err,"failed to create command queue");
+
+  std::ifstream stream(argv[1]);
+  stream.seekg(0,stream.end);
+  size_t size = stream.tellg();
+  stream.seekg(0,stream.beg);
+  std::vector<char> xclbin(size);
+  stream.read(xclbin.data(),size);
+  const unsigned char* data = reinterpret_cast<unsigned char*>(xclbin.data());
+  cl_int status = CL_SUCCESS;
+  cl_program program = clCreateProgramWithBinary(context,1,&device,&size,&data,&status,&err);
+  throw_if_error(err,"failed to create program");
+
+  run_test(context,queue,program,workgroups,iterations);
+
+  clReleaseProgram(program);
+  clReleaseCommandQueue(queue);
+  clReleaseContext(context);
+  std::for_each(devices.begin(),devices.end(),[](cl_device_id d){clReleaseDevice(d);});
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    run(argc,argv);
+    std::cout << "TEST SUCCESS\n";
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return 1;
+}
@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Execute the same sequence of runs with the same buffers repeatedly
+// and compare starting each run object explicitly against replaying
+// a captured run sequence (xrt::run_sequence).
+//
+// The sequence syncs the input buffer to device, runs the addone
+// kernel on all compute units each on its own region of the job
+// buffers, and syncs the output buffer from device.  The number of
+// elements processed per run is declared as a sequence variable and
+// patched before each replay.
+//
+// Host overhead can be measured with the noop shim
+// (XCL_EMULATION_MODE=noop), which completes commands without a
+// device.  Results are verified unless --noverify is specified, which
+// is required with the noop shim.
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_kernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+# pragma warning ( disable : 4267 )
+#endif
+
+static constexpr size_t ELEMENTS = 16;
+static constexpr size_t ARRAY_SIZE = 8;
+static constexpr size_t MAXCUS = 8;
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] \n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <bdf | device_index>\n";
+  std::cout << "";
+  std::cout << "  [--cus <number>]: number of cus to use (default: 8) (max: 8)\n";
+  std::cout << "  [--iterations <number>]: number of sequence executions (default: 1000)\n";
+  std::cout << "  [--noverify]: skip verification of results\n";
+  std::cout << "";
+  std::cout << "* Summary prints time per sequence execution in us for\n";
+  std::cout << "* explicit start/wait and for run_sequence replay.\n";
+}
+
+static std::string
+get_kernel_name(size_t cus)
+{
+  std::string k("addone:{");
+  for (size_t i=1; i<cus; ++i)
+    k.append("addone_").append(std::to_string(i)).append(",");
+  k.append("addone_").append(std::to_string(cus)).append("}");
+  return k;
+}
+
+using clock_type = std::chrono::steady_clock;
+
+struct job_type
+{
+  xrt::kernel kernel;
+  size_t cus;
+  size_t region_size;   // bytes per cu
+  xrt::bo a;
+  xrt::bo b;
+  std::vector<xrt::run> runs;
+
+  job_type(const xrt::device& device, const xrt::kernel& k, size_t ncus)
+    : kernel(k)
+    , cus(ncus)
+    , region_size(ELEMENTS * ARRAY_SIZE * sizeof(unsigned long))
+    , a(device, region_size * cus, kernel.group_id(0))
+    , b(device, region_size * cus, kernel.group_id(1))
+  {}
+
+  void
+  init()
+  {
+    auto adata = a.map<unsigned long*>();
+    auto bdata = b.map<unsigned long*>();
+    for (size_t i = 0; i < a.size() / sizeof(unsigned long); ++i) {
+      adata[i] = i;
+      bdata[i] = 0;
+    }
+  }
+
+  // One run object per cu, each processing its own region
+  std::vector<xrt::run>
+  create_runs()
+  {
+    std::vector<xrt::run> runs;
+    for (size_t cu = 0; cu < cus; ++cu) {
+      xrt::run run(kernel);
+      run.set_arg(0, xrt::bo(a, region_size, cu * region_size));
+      run.set_arg(1, xrt::bo(b, region_size, cu * region_size));
+      run.set_arg(2, static_cast<uint32_t>(ELEMENTS));
+      runs.push_back(std::move(run));
+    }
+    return runs;
+  }
+
+  void
+  execute(std::vector<xrt::run>& runs)
+  {
+    a.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    for (auto& run : runs)
+      run.start();
+    for (auto& run : runs)
+      run.wait();
+    b.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+  }
+
+  bool
+  verify()
+  {
+    // addone copies a to b adding one to first element of each vector
+    auto bdata = b.map<unsigned long*>();
+    for (size_t i = 0; i < b.size() / sizeof(unsigned long); ++i) {
+      auto expected = i + ((i % ARRAY_SIZE) ? 0 : 1);
+      if (bdata[i] != expected) {
+        std::cout << "mismatch at " << i << ": " << bdata[i] << " != " << expected << "\n";
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+static double
+us_per_iteration(clock_type::duration d, size_t iterations)
+{
+  return std::chrono::duration<double, std::micro>(d).count() / static_cast<double>(iterations);
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+
+  std::string xclbin_fnm;
+  std::string device_id = "0";
+  size_t cus = MAXCUS;
+  size_t iterations = 1000;
+  bool verify = true;
+
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg == "--noverify") {
+      verify = false;
+      continue;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-d")
+      device_id = arg;
+    else if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "--cus")
+      cus = std::stoi(arg);
+    else if (cur == "--iterations")
+      iterations = std::stoi(arg);
+    else
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  xrt::device device{device_id};
+  auto uuid = device.load_xclbin(xclbin_fnm);
+  xrt::hw_context hwctx{device, uuid};
+
+  cus = std::min(cus, MAXCUS);
+  xrt::kernel kernel{hwctx, get_kernel_name(cus)};
+  job_type job{device, kernel, cus};
+
+  // explicit sync, start, and wait of every run object
+  job.init();
+  auto runs = job.create_runs();
+  auto start = clock_type::now();
+  for (size_t i = 0; i < iterations; ++i)
+    job.execute(runs);
+  auto start_wait_time = clock_type::now() - start;
+
+  if (verify && !job.verify())
+    throw std::runtime_error("start/wait failed verification");
+
+  // capture once, replay every iteration
+  job.init();
+  runs = job.create_runs();
+  xrt::run_sequence seq{hwctx};
+  seq.add_sync(job.a, XCL_BO_SYNC_BO_TO_DEVICE);
+  std::vector<size_t> elements;
+  for (auto& run : runs) {
+    seq.add(run);
+    elements.push_back(seq.add_variable(run, 2));
+  }
+  seq.add_sync(job.b, XCL_BO_SYNC_BO_FROM_DEVICE);
+
+  start = clock_type::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    for (auto var : elements)
+      seq.set_arg(var, static_cast<uint32_t>(ELEMENTS));
+    seq.replay();
+    seq.wait();
+  }
+  auto replay_time = clock_type::now() - start;
+
+  if (verify && !job.verify())
+    throw std::runtime_error("run_sequence failed verification");
+
+  std::cout << "xrtxx-rs: cus iterations start_wait_us replay_us = "
+            << cus << " "
+            << iterations << " "
+            << us_per_iteration(start_wait_time, iterations) << " "
+            << us_per_iteration(replay_time, iterations) << "\n";
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    return run(argc,argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return 1;
+}
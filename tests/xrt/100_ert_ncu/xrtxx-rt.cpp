@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Fan out one job to all compute units of a kernel and compare the
+// cost of constructing one run object per compute unit by setting
+// arguments on each run object against creating the run objects from
+// a run template (xrt::run_template).
+//
+// Construction cost is host only and can be measured with the noop
+// shim (XCL_EMULATION_MODE=noop), which completes commands without a
+// device.  Results are verified unless --noverify is specified, which
+// is required with the noop shim.
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_kernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+# pragma warning ( disable : 4267 )
+#endif
+
+static constexpr size_t ELEMENTS = 16;
+static constexpr size_t ARRAY_SIZE = 8;
+static constexpr size_t MAXCUS = 8;
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] \n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <bdf | device_index>\n";
+  std::cout << "";
+  std::cout << "  [--cus <number>]: number of cus to use (default: 8) (max: 8)\n";
+  std::cout << "  [--iterations <number>]: number of fan outs (default: 1000)\n";
+  std::cout << "  [--noverify]: skip verification of results\n";
+  std::cout << "";
+  std::cout << "* Each fan out constructs and runs one run object per cu, each\n";
+  std::cout << "* run object processes its own region of the job buffers.\n";
+  std::cout << "* Summary prints construction time per run object in us for\n";
+  std::cout << "* set_arg and run_template.\n";
+}
+
+static std::string
+get_kernel_name(size_t cus)
+{
+  std::string k("addone:{");
+  for (size_t i=1; i<cus; ++i)
+    k.append("addone_").append(std::to_string(i)).append(",");
+  k.append("addone_").append(std::to_string(cus)).append("}");
+  return k;
+}
+
+using clock_type = std::chrono::steady_clock;
+
+struct job_type
+{
+  xrt::kernel kernel;
+  size_t cus;
+  size_t region_size;   // bytes per cu
+  xrt::bo a;
+  xrt::bo b;
+
+  job_type(const xrt::device& device, const xrt::kernel& k, size_t ncus)
+    : kernel(k)
+    , cus(ncus)
+    , region_size(ELEMENTS * ARRAY_SIZE * sizeof(unsigned long))
+    , a(device, region_size * cus, kernel.group_id(0))
+    , b(device, region_size * cus, kernel.group_id(1))
+  {}
+
+  void
+  init()
+  {
+    auto adata = a.map<unsigned long*>();
+    auto bdata = b.map<unsigned long*>();
+    for (size_t i = 0; i < a.size() / sizeof(unsigned long); ++i) {
+      adata[i] = i;
+      bdata[i] = 0;
+    }
+    a.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    b.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+  }
+
+  // Construct one run object per cu by setting arguments on each
+  std::vector<xrt::run>
+  fanout_set_arg()
+  {
+    std::vector<xrt::run> runs;
+    runs.reserve(cus);
+    for (size_t cu = 0; cu < cus; ++cu) {
+      xrt::bo ra(a, region_size, cu * region_size);
+      xrt::bo rb(b, region_size, cu * region_size);
+      xrt::run run(kernel);
+      run.set_arg(0, ra);
+      run.set_arg(1, rb);
+      run.set_arg(2, static_cast<uint32_t>(ELEMENTS));
+      runs.push_back(std::move(run));
+    }
+    return runs;
+  }
+
+  // Construct one run object per cu from a template
+  std::vector<xrt::run>
+  fanout_template(const xrt::run_template& tmpl)
+  {
+    std::vector<xrt::run> runs;
+    runs.reserve(cus);
+    auto ncus = tmpl.get_num_cus();
+    for (size_t cu = 0; cu < cus; ++cu)
+      runs.push_back(tmpl.create(cu % ncus, {{0, cu * region_size, region_size}, {1, cu * region_size, region_size}}));
+    return runs;
+  }
+
+  static void
+  execute(std::vector<xrt::run>& runs)
+  {
+    for (auto& run : runs)
+      run.start();
+    for (auto& run : runs)
+      run.wait();
+  }
+
+  bool
+  verify()
+  {
+    // addone copies a to b adding one to first element of each vector
+    b.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+    auto bdata = b.map<unsigned long*>();
+    for (size_t i = 0; i < b.size() / sizeof(unsigned long); ++i) {
+      auto expected = i + ((i % ARRAY_SIZE) ? 0 : 1);
+      if (bdata[i] != expected) {
+        std::cout << "mismatch at " << i << ": " << bdata[i] << " != " << expected << "\n";
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+static double
+us_per_run(clock_type::duration d, size_t runs)
+{
+  return std::chrono::duration<double, std::micro>(d).count() / static_cast<double>(runs);
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+
+  std::string xclbin_fnm;
+  std::string device_id = "0";
+  size_t cus = MAXCUS;
+  size_t iterations = 1000;
+  bool verify = true;
+
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg == "--noverify") {
+      verify = false;
+      continue;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-d")
+      device_id = arg;
+    else if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "--cus")
+      cus = std::stoi(arg);
+    else if (cur == "--iterations")
+      iterations = std::stoi(arg);
+    else
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  xrt::device device{device_id};
+  auto uuid = device.load_xclbin(xclbin_fnm);
+
+  cus = std::min(cus, MAXCUS);
+  xrt::kernel kernel{device, uuid, get_kernel_name(cus)};
+  job_type job{device, kernel, cus};
+
+  // set_arg on every run object
+  clock_type::duration set_arg_time {0};
+  job.init();
+  for (size_t i = 0; i < iterations; ++i) {
+    auto start = clock_type::now();
+    auto runs = job.fanout_set_arg();
+    set_arg_time += clock_type::now() - start;
+    if (i == 0)
+      job_type::execute(runs);
+  }
+
+  if (verify && !job.verify())
+    throw std::runtime_error("set_arg fan out failed verification");
+
+  // run template validated once
+  clock_type::duration template_time {0};
+  job.init();
+  auto start = clock_type::now();
+  xrt::run_template tmpl{kernel};
+  tmpl.set_arg(0, job.a);
+  tmpl.set_arg(1, job.b);
+  tmpl.set_arg(2, static_cast<uint32_t>(ELEMENTS));
+  auto setup_time = clock_type::now() - start;
+  for (size_t i = 0; i < iterations; ++i) {
+    start = clock_type::now();
+    auto runs = job.fanout_template(tmpl);
+    template_time += clock_type::now() - start;
+    if (i == 0)
+      job_type::execute(runs);
+  }
+
+  if (verify && !job.verify())
+    throw std::runtime_error("run_template fan out failed verification");
+
+  auto total = iterations * cus;
+  std::cout << "xrtxx-rt: cus iterations set_arg_us template_us template_setup_us = "
+            << cus << " "
+            << iterations << " "
+            << us_per_run(set_arg_time, total) << " "
+            << us_per_run(template_time, total) << " "
+            << us_per_run(setup_time, 1) << "\n";
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    return run(argc,argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return 1;
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Run the addone kernel of 13_add_one data parallel on several
+// devices using xrt::ext::striped_bo and xrt::ext::broadcast_run.
+// Each device processes its own slice of the striped input and
+// output buffers.
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_multi_device.h"
+#include "xrt/experimental/xrt_system.h"
+
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// addone processes elements of 8 64-bit words
+static constexpr size_t ELEMENT_SIZE = 8 * sizeof(uint64_t);
+
+static void
+usage()
+{
+  std::cout << "usage: multi_device [options] -k <bitstream>\n\n"
+            << "  -k <bitstream>\n"
+            << "  -d <number of devices, default is all>\n"
+            << "  -n <num of elements per device, default is 1024>\n"
+            << "  -h\n\n"
+            << "* Bitstream is required\n";
+}
+
+static void
+run(const std::vector<xrt::device>& devices, const std::string& xclbin_fnm, size_t n_elements)
+{
+  std::vector<xrt::kernel> kernels;
+  for (auto device : devices) {
+    auto uuid = device.load_xclbin(xclbin_fnm);
+    kernels.emplace_back(device, uuid, "addone");
+  }
+
+  const size_t bytes = devices.size() * n_elements * ELEMENT_SIZE;
+  std::vector<uint64_t> a_data(bytes / sizeof(uint64_t));
+  std::iota(a_data.begin(), a_data.end(), 0);
+
+  xrt::ext::striped_bo a(kernels, 0, bytes);
+  xrt::ext::striped_bo b(kernels, 1, bytes);
+  a.scatter(a_data.data());
+
+  // Striped buffers are passed as non-const lvalues, each run is
+  // assigned the slice of its device
+  xrt::ext::broadcast_run bcast(kernels);
+  bcast.set_arg(0, a);
+  bcast.set_arg(1, b);
+  for (size_t idx = 0; idx < bcast.size(); ++idx)
+    bcast.get_run(idx).set_arg(2, static_cast<unsigned int>(a.slice(idx).size() / ELEMENT_SIZE));
+
+  bcast.start();
+  auto state = bcast.wait();
+  if (state != ERT_CMD_STATE_COMPLETED)
+    throw std::runtime_error("broadcast run failed with state " + std::to_string(state));
+
+  // verify
+  std::vector<uint64_t> b_data(a_data.size());
+  b.gather(b_data.data());
+  for (size_t idx = 0; idx < b_data.size(); ++idx) {
+    auto expect = a_data[idx] + (idx % 8 ? 0 : 1);
+    if (b_data[idx] != expect)
+      throw std::runtime_error
+        ("b_data[" + std::to_string(idx) + "] = " + std::to_string(b_data[idx])
+         + " expected " + std::to_string(expect));
+  }
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  size_t num_elements = 1024;
+  unsigned int num_devices = 0;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      num_devices = std::stoi(arg);
+    else if (cur == "-n")
+      num_elements = std::stoi(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  if (!num_devices)
+    num_devices = xrt::system::enumerate_devices();
+  if (!num_devices)
+    throw std::runtime_error("No devices found");
+
+  std::vector<xrt::device> devices;
+  for (unsigned int idx = 0; idx < num_devices; ++idx)
+    devices.emplace_back(idx);
+
+  run(devices, xclbin_fnm, num_elements);
+
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+  return 1;
+}
@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Launch rate of the native XRT submission paths.
+//
+//  run:     xrt::run::start() and xrt::run::wait()
+//  runlist: xrt::runlist::execute() and xrt::runlist::wait()
+//  queue:   start and wait of xrt::run enqueued in an xrt::queue
+//
+// Each path is swept over thread counts and launches in flight per
+// thread, see launch_rate.h.  The benchmark measures host side cost
+// and is meant to be run with the noop shim which completes commands
+// without a device:
+//
+//   % XCL_EMULATION_MODE=noop ./launch_rate -k verify.xclbin > xrt.json
+//
+// Runlists require hardware queue support.  If the shim does not
+// support it, the runlist path is reported with status "unsupported"
+// and does not fail the benchmark, any other failure does.
+#include "launch_rate.h"
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_kernel.h"
+#include "xrt/experimental/xrt_queue.h"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+# pragma warning ( disable : 4267 )
+#endif
+
+static void
+usage()
+{
+  std::cout << "usage: launch_rate [options]\n\n";
+  std::cout << "  -k <xclbin with hello kernel>\n";
+  std::cout << "  -d <bdf | device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to launch (default: hello)\n";
+  std::cout << "  [--path <run|runlist|queue>]: measure one path only (default: all)\n";
+  std::cout << "  [--runlist-size <n>]: run objects per runlist (default: 8)\n";
+  launch_rate::options::usage();
+  std::cout << "\n";
+  std::cout << "* One JSON record per path, thread count, and depth is printed to stdout.\n";
+}
+
+// Create a run object with its own argument buffer
+static xrt::run
+create_run(const xrt::device& device, const xrt::kernel& kernel)
+{
+  xrt::run run{kernel};
+  run.set_arg(0, xrt::bo(device, 20, kernel.group_id(0)));
+  return run;
+}
+
+struct run_slot
+{
+  xrt::run run;
+
+  void start() { run.start(); }
+  void wait() { run.wait(); }
+  size_t count() const { return 1; }
+};
+
+struct runlist_slot
+{
+  xrt::runlist runlist;
+  size_t size;
+
+  void start() { runlist.execute(); }
+  void wait() { runlist.wait(); }
+  size_t count() const { return size; }
+};
+
+struct queue_slot
+{
+  std::shared_ptr<xrt::queue> queue;
+  xrt::run run;
+  xrt::queue::event event;
+
+  void
+  start()
+  {
+    event = queue->enqueue([r = &run] { r->start(); r->wait(); });
+  }
+
+  void wait() { event.wait(); }
+  size_t count() const { return 1; }
+};
+
+static void
+sweep_run(const xrt::device& device, const xrt::kernel& kernel, const launch_rate::options& opts)
+{
+  launch_rate::sweep<run_slot>("xrt::run", opts, [&](size_t, size_t depth) {
+    std::vector<run_slot> slots;
+    for (size_t i = 0; i < depth; ++i)
+      slots.push_back({create_run(device, kernel)});
+    return slots;
+  });
+}
+
+static void
+sweep_runlist(const xrt::device& device, const xrt::hw_context& hwctx, const std::string& name,
+              size_t size, const launch_rate::options& opts)
+{
+  xrt::kernel kernel{hwctx, name};
+  launch_rate::sweep<runlist_slot>("xrt::runlist", opts, [&](size_t, size_t depth) {
+    std::vector<runlist_slot> slots;
+    for (size_t i = 0; i < depth; ++i) {
+      xrt::runlist runlist{hwctx};
+      for (size_t r = 0; r < size; ++r)
+        runlist.add(create_run(device, kernel));
+      slots.push_back({std::move(runlist), size});
+    }
+    return slots;
+  });
+}
+
+static void
+sweep_queue(const xrt::device& device, const xrt::kernel& kernel, const launch_rate::options& opts)
+{
+  launch_rate::sweep<queue_slot>("xrt::queue", opts, [&](size_t, size_t depth) {
+    auto queue = std::make_shared<xrt::queue>();
+    std::vector<queue_slot> slots;
+    for (size_t i = 0; i < depth; ++i)
+      slots.push_back({queue, create_run(device, kernel), {}});
+    return slots;
+  });
+}
+
+// Run one path unless another path is selected
+template <typename Sweep>
+static void
+measure(const std::string& path, const std::string& selected, Sweep&& sweep)
+{
+  if (selected.empty() || selected == path)
+    sweep();
+}
+
+// Create the hardware context used by runlists and check that a
+// runlist can be created in it, which fails if the shim has no
+// hardware queue support.  Return the reason if runlists are not
+// supported, empty string otherwise.
+static std::string
+create_runlist_context(const xrt::device& device, const xrt::uuid& uuid, xrt::hw_context& hwctx)
+{
+  try {
+    hwctx = xrt::hw_context{device, uuid};
+    xrt::runlist probe{hwctx};
+    return {};
+  }
+  catch (const std::exception& ex) {
+    return ex.what();
+  }
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+
+  std::string xclbin_fnm;
+  std::string device_id = "0";
+  std::string kernel_name = "hello";
+  std::string path;
+  size_t runlist_size = 8;
+  launch_rate::options opts;
+
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-d")
+      device_id = arg;
+    else if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "--kernel")
+      kernel_name = arg;
+    else if (cur == "--path")
+      path = arg;
+    else if (cur == "--runlist-size")
+      runlist_size = std::stoul(arg);
+    else if (!opts.parse(cur, arg))
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  if (xclbin_fnm.empty()) {
+    usage();
+    throw std::runtime_error("missing xclbin");
+  }
+
+  xrt::device device{device_id};
+  auto uuid = device.load_xclbin(xclbin_fnm);
+  xrt::kernel kernel{device, uuid, kernel_name};
+
+  measure("run", path, [&] { sweep_run(device, kernel, opts); });
+  measure("runlist", path, [&] {
+    xrt::hw_context hwctx;
+    if (auto reason = create_runlist_context(device, uuid, hwctx); !reason.empty()) {
+      launch_rate::print_unsupported(std::cout, "xrt::runlist", reason);
+      return;
+    }
+    sweep_runlist(device, hwctx, kernel_name, runlist_size, opts);
+  });
+  measure("queue", path, [&] { sweep_queue(device, kernel, opts); });
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    return run(argc,argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return 1;
+}
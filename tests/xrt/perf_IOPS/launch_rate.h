@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Common launch rate measurement used by the launch rate benchmarks
+// for the native XRT, OpenCL, and HIP submission paths.
+//
+// A submission path is measured by a number of threads each keeping
+// a fixed number of launches in flight.  A thread owns one slot per
+// in flight launch and cycles through the slots, waiting for the
+// oldest launch to complete before relaunching it.
+//
+// A slot is any type with the following members:
+//   void start();     // launch
+//   void wait();      // wait for launch to complete
+//   size_t count();   // number of kernel launches per start
+//
+// Each measurement is printed as a single line JSON record such that
+// results can be collected and compared between runs.
+#ifndef PERF_IOPS_LAUNCH_RATE_H
+#define PERF_IOPS_LAUNCH_RATE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+# ifdef _WIN32
+#  include <intrin.h>
+# else
+#  include <x86intrin.h>
+# endif
+#endif
+
+namespace launch_rate {
+
+using clock_type = std::chrono::steady_clock;
+
+// Cycle counter, falls back to nanoseconds where no cycle counter is
+// accessible from user space
+inline uint64_t
+cycles()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t val = 0;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(val));
+  return val;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+#endif
+}
+
+// Command line options shared by all launch rate benchmarks
+struct options
+{
+  std::vector<size_t> threads {1, 2, 4};
+  std::vector<size_t> depths {1, 4, 16, 64};
+  size_t launches = 20000;    // per measurement, divided among threads
+  size_t warmup = 1000;       // per thread, not measured
+
+  static std::vector<size_t>
+  parse_list(const std::string& str)
+  {
+    std::vector<size_t> values;
+    std::stringstream ss(str);
+    for (std::string value; std::getline(ss, value, ',');)
+      values.push_back(std::stoul(value));
+    if (values.empty() || std::find(values.begin(), values.end(), 0) != values.end())
+      throw std::runtime_error("bad list of values '" + str + "'");
+    return values;
+  }
+
+  // Consume option 'opt' with value 'val', return false if the
+  // option is not a launch rate option.
+  bool
+  parse(const std::string& opt, const std::string& val)
+  {
+    if (opt == "--threads")
+      threads = parse_list(val);
+    else if (opt == "--depth")
+      depths = parse_list(val);
+    else if (opt == "--launches")
+      launches = std::stoul(val);
+    else if (opt == "--warmup")
+      warmup = std::stoul(val);
+    else
+      return false;
+    return true;
+  }
+
+  static void
+  usage()
+  {
+    std::cout << "  [--threads <n,...>]: submitting threads to sweep (default: 1,2,4)\n";
+    std::cout << "  [--depth <n,...>]: launches in flight per thread to sweep (default: 1,4,16,64)\n";
+    std::cout << "  [--launches <n>]: launches per measurement (default: 20000)\n";
+    std::cout << "  [--warmup <n>]: unmeasured launches per thread (default: 1000)\n";
+  }
+};
+
+// Result of one measurement
+struct result
+{
+  std::string path;
+  size_t threads = 0;
+  size_t depth = 0;
+  size_t launches = 0;
+  double seconds = 0;
+  double cpu_seconds = 0;
+  double cycles_per_second = 0;
+  std::vector<double> latencies;  // us per start/wait
+
+  double
+  percentile(double pct) const
+  {
+    if (latencies.empty())
+      return 0;
+    auto idx = static_cast<size_t>(pct / 100.0 * (latencies.size() - 1));
+    return latencies[idx];
+  }
+
+  void
+  print(std::ostream& ostr) const
+  {
+    auto launches_d = static_cast<double>(launches);
+    ostr << "{\"path\":\"" << path << "\""
+         << ",\"status\":\"ok\""
+         << ",\"threads\":" << threads
+         << ",\"depth\":" << depth
+         << ",\"launches\":" << launches
+         << ",\"seconds\":" << seconds
+         << ",\"launches_per_sec\":" << launches_d / seconds
+         << ",\"cpu_us_per_launch\":" << cpu_seconds * 1e6 / launches_d
+         << ",\"cpu_cycles_per_launch\":" << cpu_seconds * cycles_per_second / launches_d
+         << ",\"latency_us\":{"
+         << "\"p50\":" << percentile(50)
+         << ",\"p90\":" << percentile(90)
+         << ",\"p99\":" << percentile(99)
+         << ",\"max\":" << (latencies.empty() ? 0 : latencies.back())
+         << "}}\n";
+  }
+};
+
+inline void
+print_unsupported(std::ostream& ostr, const std::string& path, const std::string& what)
+{
+  std::string err;
+  for (auto c : what)
+    if (c != '"' && c != '\\' && c != '\n')
+      err.push_back(c);
+  ostr << "{\"path\":\"" << path << "\",\"status\":\"unsupported\",\"error\":\"" << err << "\"}\n";
+}
+
+// Process CPU time, includes time spent in runtime threads
+inline double
+cpu_seconds()
+{
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+// Keep slots.size() launches in flight until 'launches' have
+// completed.  Latency of each start/wait is appended to 'latencies'
+// if not null.
+template <typename Slot>
+inline void
+pipeline(std::vector<Slot>& slots, size_t launches, std::vector<double>* latencies)
+{
+  std::vector<clock_type::time_point> started(slots.size());
+  size_t issued = 0;
+  size_t completed = 0;
+  for (size_t idx = 0; idx < slots.size() && issued < launches; ++idx) {
+    started[idx] = clock_type::now();
+    slots[idx].start();
+    issued += slots[idx].count();
+  }
+
+  // Outstanding launches are always the next slots in round robin
+  // order, so waiting in order never waits for an idle slot
+  for (size_t idx = 0; completed < launches; idx = (idx + 1) % slots.size()) {
+    slots[idx].wait();
+    completed += slots[idx].count();
+    if (latencies)
+      latencies->push_back(std::chrono::duration<double, std::micro>(clock_type::now() - started[idx]).count());
+    if (issued < launches) {
+      started[idx] = clock_type::now();
+      slots[idx].start();
+      issued += slots[idx].count();
+    }
+  }
+}
+
+// Measure a submission path for all combinations of thread count and
+// depth.  The factory is called with thread index and depth and must
+// return the slots for that thread.  Slots are created before the
+// measurement starts and destroyed after it completes.
+template <typename Slot>
+inline void
+sweep(const std::string& path, const options& opts,
+      const std::function<std::vector<Slot>(size_t, size_t)>& factory,
+      std::ostream& ostr = std::cout)
+{
+  for (auto threads : opts.threads) {
+    for (auto depth : opts.depths) {
+      std::vector<std::vector<Slot>> slots;
+      for (size_t t = 0; t < threads; ++t)
+        slots.push_back(factory(t, depth));
+
+      for (auto& ts : slots)
+        pipeline(ts, opts.warmup, nullptr);
+
+      result res;
+      res.path = path;
+      res.threads = threads;
+      res.depth = depth;
+      std::vector<std::vector<double>> latencies(threads);
+      std::vector<std::exception_ptr> errors(threads);
+      std::atomic<size_t> ready {0};
+      std::atomic<bool> go {false};
+      auto per_thread = std::max<size_t>(opts.launches / threads, 1);
+
+      std::vector<std::thread> workers;
+      for (size_t t = 0; t < threads; ++t) {
+        latencies[t].reserve(per_thread);
+        workers.emplace_back([&, t] {
+          ++ready;
+          while (!go)
+            std::this_thread::yield();
+          try {
+            pipeline(slots[t], per_thread, &latencies[t]);
+          }
+          catch (...) {
+            errors[t] = std::current_exception();
+          }
+        });
+      }
+
+      while (ready < threads)
+        std::this_thread::yield();
+
+      auto cpu_start = cpu_seconds();
+      auto cycles_start = cycles();
+      auto start = clock_type::now();
+      go = true;
+      for (auto& worker : workers)
+        worker.join();
+      auto end = clock_type::now();
+      auto cycles_end = cycles();
+      auto cpu_end = cpu_seconds();
+
+      // Failure in any thread fails the measurement
+      for (auto& error : errors)
+        if (error)
+          std::rethrow_exception(error);
+
+      res.seconds = std::chrono::duration<double>(end - start).count();
+      res.cpu_seconds = cpu_end - cpu_start;
+      res.cycles_per_second = static_cast<double>(cycles_end - cycles_start) / res.seconds;
+      res.launches = per_thread * threads;
+      for (auto& tl : latencies)
+        res.latencies.insert(res.latencies.end(), tl.begin(), tl.end());
+      std::sort(res.latencies.begin(), res.latencies.end());
+      res.print(ostr);
+    }
+  }
+}
+
+} // launch_rate
+
+#endif
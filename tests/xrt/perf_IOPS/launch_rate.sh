@@ -0,0 +1,58 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: Apache-2.0
+# Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Run the launch rate benchmarks with the noop shim and collect the
+# JSON records of all submission paths in one file.
+#
+# usage: launch_rate.sh <xclbin> [output (default: launch_rate.json)] [benchmark options]
+#
+# The HIP benchmark is run if HIP_LAUNCH_RATE points to the
+# launch-rate executable from tests/hip, it is given the code object
+# in HIP_NOP_KERNEL (default: nop.co).
+
+set -e
+set -o pipefail
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <xclbin> [output] [benchmark options]"
+    exit 1
+fi
+
+xclbin=$1
+output=${2:-launch_rate.json}
+shift $(( $# > 1 ? 2 : 1 ))
+
+here=$(dirname "$(readlink -f "$0")")
+export XCL_EMULATION_MODE=${XCL_EMULATION_MODE:-noop}
+
+# Run a benchmark and append its JSON records to the output, fail if
+# the benchmark fails or produces no records
+run()
+{
+    local log records
+    if ! log=$("$@"); then
+        echo "$log" >&2
+        echo "$1 failed" >&2
+        exit 1
+    fi
+    records=$(echo "$log" | grep '^{' || true)
+    if [ -z "$records" ] || echo "$log" | grep -q 'TEST FAILED'; then
+        echo "$log" >&2
+        echo "$1 produced no results" >&2
+        exit 1
+    fi
+    echo "$records" >> "$output"
+}
+
+: > "$output"
+run "$here/launch_rate" -k "$xclbin" "$@"
+if [ -x "$here/ocl_launch_rate" ]; then
+    run "$here/ocl_launch_rate" -k "$xclbin" "$@"
+fi
+if [ -n "$HIP_LAUNCH_RATE" ]; then
+    run "$HIP_LAUNCH_RATE" -k "${HIP_NOP_KERNEL:-nop.co}" "$@"
+fi
+
+echo "Results in $output"
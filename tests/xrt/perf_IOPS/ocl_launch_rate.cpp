@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Launch rate of the OpenCL submission path.
+//
+// Each in flight launch is a clEnqueueTask of its own kernel object
+// on an out of order command queue owned by the submitting thread,
+// waited on with clWaitForEvents.  Output is the same JSON records
+// as produced by launch_rate, see launch_rate.h.
+//
+//   % XCL_EMULATION_MODE=noop ./ocl_launch_rate -k verify.xclbin > ocl.json
+#include "launch_rate.h"
+
+#include <CL/cl_ext_xilinx.h>
+#include <CL/cl.h>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: ocl_launch_rate [options]\n\n";
+  std::cout << "  -k <xclbin with hello kernel>\n";
+  std::cout << "  [--kernel <name>]: kernel to launch (default: hello)\n";
+  launch_rate::options::usage();
+}
+
+static void
+throw_if_error(cl_int errcode, const char* msg)
+{
+  if (errcode)
+    throw std::runtime_error(std::string(msg) + ": errcode '" + std::to_string(errcode) + "'");
+}
+
+using queue_ptr = std::shared_ptr<_cl_command_queue>;
+using kernel_ptr = std::shared_ptr<_cl_kernel>;
+using mem_ptr = std::shared_ptr<_cl_mem>;
+
+struct ocl_slot
+{
+  queue_ptr queue;
+  kernel_ptr kernel;
+  mem_ptr arg;
+  cl_event event = nullptr;
+
+  void
+  start()
+  {
+    throw_if_error(clEnqueueTask(queue.get(), kernel.get(), 0, nullptr, &event), "failed to enqueue task");
+  }
+
+  void
+  wait()
+  {
+    throw_if_error(clWaitForEvents(1, &event), "failed to wait for task");
+    clReleaseEvent(event);
+    event = nullptr;
+  }
+
+  size_t count() const { return 1; }
+};
+
+static int
+run(int argc, char** argv)
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+
+  std::string xclbin_fnm;
+  std::string kernel_name = "hello";
+  launch_rate::options opts;
+
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "--kernel")
+      kernel_name = arg;
+    else if (!opts.parse(cur, arg))
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  if (xclbin_fnm.empty()) {
+    usage();
+    throw std::runtime_error("missing xclbin");
+  }
+
+  cl_int err = CL_SUCCESS;
+  cl_platform_id platform = nullptr;
+  throw_if_error(clGetPlatformIDs(1, &platform, nullptr), "no platform");
+
+  cl_device_id device = nullptr;
+  throw_if_error(clGetDeviceIDs(platform, CL_DEVICE_TYPE_ACCELERATOR, 1, &device, nullptr), "no device");
+
+  std::shared_ptr<_cl_context> context{clCreateContext(nullptr, 1, &device, nullptr, nullptr, &err), clReleaseContext};
+  throw_if_error(err, "failed to create context");
+
+  std::ifstream stream(xclbin_fnm, std::ios::binary);
+  std::vector<char> xclbin{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+  auto size = xclbin.size();
+  auto data = reinterpret_cast<const unsigned char*>(xclbin.data());
+  std::shared_ptr<_cl_program> program
+    {clCreateProgramWithBinary(context.get(), 1, &device, &size, &data, nullptr, &err), clReleaseProgram};
+  throw_if_error(err, "failed to create program");
+
+  launch_rate::sweep<ocl_slot>("opencl", opts, [&](size_t, size_t depth) {
+    cl_int err = CL_SUCCESS;
+    queue_ptr queue
+      {clCreateCommandQueue(context.get(), device, CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE, &err), clReleaseCommandQueue};
+    throw_if_error(err, "failed to create command queue");
+
+    std::vector<ocl_slot> slots;
+    for (size_t i = 0; i < depth; ++i) {
+      kernel_ptr kernel{clCreateKernel(program.get(), kernel_name.c_str(), &err), clReleaseKernel};
+      throw_if_error(err, "failed to create kernel");
+      mem_ptr arg{clCreateBuffer(context.get(), CL_MEM_READ_WRITE, 20, nullptr, &err), clReleaseMemObject};
+      throw_if_error(err, "failed to create buffer");
+      auto mem = arg.get();
+      throw_if_error(clSetKernelArg(kernel.get(), 0, sizeof(cl_mem), &mem), "failed to set kernel arg");
+      slots.push_back({queue, std::move(kernel), std::move(arg)});
+    }
+    return slots;
+  });
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    return run(argc,argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return 1;
+}